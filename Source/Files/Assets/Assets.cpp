@@ -49,17 +49,20 @@ juce::File Assets::findAssetFile
 
 // Creates an Image object from an asset file.
 juce::Image Assets::loadImageAsset
-(const juce::String& assetName, bool lookOutsideAssets)
+(const juce::String& assetName, bool lookOutsideAssets, const int svgSize)
 {
     using juce::Image;
     if (assetName.endsWith(".svg"))
     {
         Image image;
+        // The drawable is never added to the desktop, so it may be created and
+        // drawn without locking the message thread.
         std::unique_ptr<juce::Drawable> svgDrawable
                 (loadSVGDrawable(assetName, lookOutsideAssets));
-        if (svgDrawable != nullptr)
+        if (svgDrawable != nullptr && svgSize > 0)
         {
-            image = Image(Image::ARGB, 128, 128, true);
+            image = Image(Image::ARGB, svgSize, svgSize, true,
+                    juce::SoftwareImageType());
             juce::Graphics g(image);
             juce::Rectangle<float> imgBounds(0, 0, image.getWidth(),
                     image.getHeight());
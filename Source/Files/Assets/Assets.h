@@ -30,6 +30,10 @@ namespace Assets
     /**
      * @brief  Creates an Image object from an asset file.
      *
+     *  This does not need to run on the message thread. SVG images are
+     * rendered using Drawable components that are never placed on the desktop,
+     * so they may be safely created and drawn on any thread.
+     *
      * @param assetName          The name of an image file in the asset folder.
      *
      * @param lookOutsideAssets  If the image isn't found in the asset folder,
@@ -38,11 +42,15 @@ namespace Assets
      *                           load the image from elsewhere in the file
      *                           system.
      *
+     * @param svgSize            The width and height, in pixels, used when
+     *                           rasterizing SVG images. This value is ignored
+     *                           when loading other image formats.
+     *
      * @return                   The requested file's Image, or Image() if no
      *                           valid image file was found.
      */
     juce::Image loadImageAsset(const juce::String& assetName,
-            bool lookOutsideAssets = true);
+            bool lookOutsideAssets = true, const int svgSize = 128);
 
     /**
      * @brief  Creates a Drawable object from a SVG asset file.
@@ -6,9 +6,6 @@
 static const constexpr char* dbgPrefix = "Assets::JSONFile::";
 #endif
 
-// Maximum number of decimal places saved when writing double values to JSON:
-static const constexpr int decimalPlacesSaved = 5;
-
 
 // Creates a JSON data file interface, creating a new JSON file or reading an
 // existing JSON file's data.
@@ -71,21 +68,37 @@ Assets::JSONFile::~JSONFile()
 void Assets::JSONFile::writeChanges()
 {
     using namespace juce;
-    if (!unwrittenChanges || jsonData.isVoid())
+    if ((!unwrittenChanges && !writeScheduled) || jsonData.isVoid())
     {
         return;
     }
-    String jsonText = JSON::toString(jsonData, false, decimalPlacesSaved);
     File jsonFile = Assets::findAssetFile(filePath);
-    if (!jsonFile.replaceWithText(jsonText))
+    if (!jsonWriter.writeNow(jsonFile, jsonData))
     {
         throw FileException(filePath, "Writing changes failed.");
     }
     else
     {
-    jsonFile.setLastModificationTime(Time::getCurrentTime());
         unwrittenChanges = false;
+        writeScheduled = false;
+    }
+}
+
+
+// Schedules all data to be written back to the config file on the shared JSON
+// write thread, as long as there are changes to write.
+void Assets::JSONFile::scheduleWrite()
+{
+    if (!unwrittenChanges || jsonData.isVoid())
+    {
+        return;
     }
+    // The write thread reads its data without locking, so it needs a copy
+    // that this object won't change:
+    jsonWriter.scheduleWrite(Assets::findAssetFile(filePath),
+            jsonData.clone());
+    unwrittenChanges = false;
+    writeScheduled = true;
 }
 
 
@@ -6,6 +6,7 @@
  *         data.
  */
 #include <exception>
+#include "Assets_JSONWriter.h"
 #include "JuceHeader.h"
 
 namespace Assets { class JSONFile; }
@@ -160,10 +161,27 @@ public:
      * @brief  Rewrites all data back to the config file, as long as there are
      *         changes to write.
      *
+     *  Changes are written immediately on the calling thread, replacing any
+     * write scheduled with scheduleWrite that hasn't finished yet. Data is
+     * always written if a write was scheduled, even if the data hasn't changed
+     * since then.
+     *
      * @throws FileException  If changes could not be written to the file.
      */
     void writeChanges();
 
+    /**
+     * @brief  Schedules all data to be written back to the config file on the
+     *         shared JSON write thread, as long as there are changes to write.
+     *
+     *  The file will be written once no JSON file writes have been scheduled
+     * for a short delay, so many quick changes only write the file once. A
+     * copy of the JSON data is scheduled, so the JSONFile may keep changing
+     * its data while the write is pending. Pending writes are always finished
+     * before the application shuts down.
+     */
+    void scheduleWrite();
+
     /**
      * @brief  Signals a failure to read from or write to the JSON config file.
      */
@@ -353,4 +371,11 @@ private:
     // Whether this object contains unsaved changes that need to be written to
     // the source file:
     bool unwrittenChanges = false;
+
+    // Whether changes were scheduled to be written on the JSON write thread,
+    // and might not be written yet:
+    bool writeScheduled = false;
+
+    // Writes JSON data to the source file:
+    JSONWriter jsonWriter;
 };
@@ -0,0 +1,167 @@
+#include "Assets_JSONWriteThread.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Assets::JSONWriteThread::";
+#endif
+
+// SharedResource object key
+const juce::Identifier Assets::JSONWriteThread::resourceKey
+        = "Assets::JSONWriteThread";
+
+// Writer thread name:
+static const constexpr char* threadName = "Assets_JSONWriteThread";
+
+// Milliseconds to wait after a write is scheduled before writing files, so
+// that quick changes are written together:
+static const constexpr juce::uint32 writeDelayMilliseconds = 500;
+
+// Milliseconds to wait for the thread to exit before forcing it to stop:
+static const constexpr int threadExitMilliseconds = 2000;
+
+// Maximum number of decimal places saved when writing double values to JSON:
+static const constexpr int decimalPlacesSaved = 5;
+
+
+// Creates the JSONWriteThread without starting the write thread.
+Assets::JSONWriteThread::JSONWriteThread() :
+SharedResource::Resource(resourceKey),
+juce::Thread(::threadName) { }
+
+
+// Stops the write thread, then writes any pending data before destruction.
+Assets::JSONWriteThread::~JSONWriteThread()
+{
+    stopThread(threadExitMilliseconds);
+    flush();
+}
+
+
+// Schedules JSON data to be written to a file, starting the write thread if
+// necessary.
+void Assets::JSONWriteThread::scheduleWrite
+(const juce::File& jsonFile, const juce::var& jsonData)
+{
+    bool writeImmediately;
+    {
+        const juce::ScopedLock pendingLock(pendingGuard);
+        writeImmediately = shuttingDown;
+        if (!writeImmediately)
+        {
+            pendingWrites[jsonFile.getFullPathName()] = jsonData;
+            lastScheduleTime = juce::Time::getMillisecondCounter();
+        }
+    }
+    if (writeImmediately)
+    {
+        if (!writeNow(jsonFile, jsonData))
+        {
+            DBG(dbgPrefix << __func__ << ": Failed to write "
+                    << jsonFile.getFullPathName());
+        }
+    }
+    else if (isThreadRunning())
+    {
+        notify();
+    }
+    else
+    {
+        startThread();
+    }
+}
+
+
+// Immediately writes JSON data to a file, cancelling any pending write to the
+// same file.
+bool Assets::JSONWriteThread::writeNow
+(const juce::File& jsonFile, const juce::var& jsonData)
+{
+    const juce::ScopedLock writeLock(writeGuard);
+    {
+        const juce::ScopedLock pendingLock(pendingGuard);
+        pendingWrites.erase(jsonFile.getFullPathName());
+    }
+    return writeFile(jsonFile, jsonData);
+}
+
+
+// Immediately writes all pending JSON data on the calling thread.
+void Assets::JSONWriteThread::flush()
+{
+    // Pending data is taken while holding the writeGuard, so older data can't
+    // be written after newer data passed to writeNow:
+    const juce::ScopedLock writeLock(writeGuard);
+    std::map<juce::String, juce::var> toWrite;
+    {
+        const juce::ScopedLock pendingLock(pendingGuard);
+        toWrite.swap(pendingWrites);
+    }
+    for (const auto& writeIter : toWrite)
+    {
+        if (!writeFile(juce::File(writeIter.first), writeIter.second))
+        {
+            DBG(dbgPrefix << __func__ << ": Failed to write "
+                    << writeIter.first);
+        }
+    }
+}
+
+
+// Writes pending data whenever new writes are scheduled, until the thread is
+// told to exit.
+void Assets::JSONWriteThread::run()
+{
+    while (!threadShouldExit())
+    {
+        // Wait until no writes were scheduled for the full write delay:
+        int waitTime = -1;
+        {
+            const juce::ScopedLock pendingLock(pendingGuard);
+            if (!pendingWrites.empty())
+            {
+                const juce::uint32 sinceSchedule
+                        = juce::Time::getMillisecondCounter()
+                        - lastScheduleTime;
+                waitTime = (sinceSchedule < writeDelayMilliseconds)
+                        ? (int) (writeDelayMilliseconds - sinceSchedule) : 0;
+            }
+        }
+        if (waitTime != 0)
+        {
+            wait(waitTime);
+            continue;
+        }
+        flush();
+    }
+}
+
+
+// Stops the write thread and writes all pending data when the application
+// starts to shut down.
+void Assets::JSONWriteThread::onShutdown()
+{
+    {
+        const juce::ScopedLock pendingLock(pendingGuard);
+        shuttingDown = true;
+    }
+    stopThread(threadExitMilliseconds);
+    flush();
+}
+
+
+// Serializes JSON data, and writes it over a file using a temporary file.
+bool Assets::JSONWriteThread::writeFile
+(const juce::File& jsonFile, const juce::var& jsonData)
+{
+    using namespace juce;
+    const String jsonText = JSON::toString(jsonData, false,
+            decimalPlacesSaved);
+    TemporaryFile tempFile(jsonFile);
+    if (!tempFile.getFile().replaceWithText(jsonText)
+            || !tempFile.overwriteTargetFileWithTemporary())
+    {
+        return false;
+    }
+    jsonFile.setLastModificationTime(Time::getCurrentTime());
+    return true;
+}
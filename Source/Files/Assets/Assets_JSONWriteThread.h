@@ -0,0 +1,125 @@
+#pragma once
+/**
+ * @file  Assets_JSONWriteThread.h
+ *
+ * @brief  Writes changed JSON files on a shared background thread.
+ */
+
+#include "SharedResource_Resource.h"
+#include "Util_ShutdownListener.h"
+#include "JuceHeader.h"
+#include <map>
+
+namespace Assets { class JSONWriteThread; }
+
+/**
+ * @brief  Serializes JSON data and writes it to its files on a background
+ *         thread, once no new writes have been scheduled for a short delay.
+ *
+ *  Scheduled JSON data is not written immediately. Instead, the JSONWriteThread
+ * waits until no writes have been scheduled for a short delay, so that many
+ * quick changes to the same file result in a single file write. Each scheduled
+ * write replaces any pending write to the same file. Scheduled data must not
+ * be shared with any object that could change it, as the background thread
+ * reads it without locking.
+ *
+ *  Files are written to a temporary file in the same directory, then renamed
+ * over the original file, so an interrupted write never leaves a partially
+ * written JSON file.
+ *
+ *  Pending writes may be forced to finish immediately with flush, and are
+ * always written before the application shuts down and before the
+ * JSONWriteThread is destroyed. The JSONWriteThread should only be accessed
+ * through the Assets::JSONWriter handler class.
+ */
+class Assets::JSONWriteThread : public SharedResource::Resource,
+        public Util::ShutdownListener, private juce::Thread
+{
+public:
+    // SharedResource object key
+    static const juce::Identifier resourceKey;
+
+    /**
+     * @brief  Creates the JSONWriteThread without starting the write thread.
+     */
+    JSONWriteThread();
+
+    /**
+     * @brief  Stops the write thread, then writes any pending data before
+     *         destruction.
+     */
+    virtual ~JSONWriteThread();
+
+    /**
+     * @brief  Schedules JSON data to be written to a file, starting the write
+     *         thread if necessary.
+     *
+     * @param jsonFile  The file where the data should be written.
+     *
+     * @param jsonData  A private copy of the JSON data to write.
+     */
+    void scheduleWrite(const juce::File& jsonFile, const juce::var& jsonData);
+
+    /**
+     * @brief  Immediately writes JSON data to a file, cancelling any pending
+     *         write to the same file.
+     *
+     * @param jsonFile  The file where the data should be written.
+     *
+     * @param jsonData  The JSON data to write.
+     *
+     * @return          Whether the file was successfully written.
+     */
+    bool writeNow(const juce::File& jsonFile, const juce::var& jsonData);
+
+    /**
+     * @brief  Immediately writes all pending JSON data on the calling thread.
+     */
+    void flush();
+
+private:
+    /**
+     * @brief  Writes pending data whenever new writes are scheduled, until the
+     *         thread is told to exit.
+     */
+    virtual void run() override;
+
+    /**
+     * @brief  Stops the write thread and writes all pending data when the
+     *         application starts to shut down.
+     */
+    virtual void onShutdown() override;
+
+    /**
+     * @brief  Serializes JSON data, and writes it over a file using a
+     *         temporary file.
+     *
+     *  This should only be called while the writeGuard is held.
+     *
+     * @param jsonFile  The file where the data should be written.
+     *
+     * @param jsonData  The JSON data to write.
+     *
+     * @return          Whether the file was successfully written.
+     */
+    static bool writeFile(const juce::File& jsonFile,
+            const juce::var& jsonData);
+
+    // Prevents writes to the same file from happening at once:
+    juce::CriticalSection writeGuard;
+
+    // Guards access to all pending write data:
+    juce::CriticalSection pendingGuard;
+
+    // Maps full file paths to JSON data waiting to be written:
+    std::map<juce::String, juce::var> pendingWrites;
+
+    // Time in milliseconds when a write was last scheduled:
+    juce::uint32 lastScheduleTime = 0;
+
+    // Whether the application started to shut down, so new writes should
+    // no longer be deferred:
+    bool shuttingDown = false;
+
+    JUCE_DECLARE_NON_COPYABLE(JSONWriteThread);
+};
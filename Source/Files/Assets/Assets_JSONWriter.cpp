@@ -0,0 +1,34 @@
+#include "Assets_JSONWriter.h"
+#include "Assets_JSONWriteThread.h"
+
+Assets::JSONWriter::JSONWriter() { }
+
+
+// Schedules JSON data to be written to a file on the write thread.
+void Assets::JSONWriter::scheduleWrite
+(const juce::File& jsonFile, const juce::var& jsonData)
+{
+    SharedResource::LockedPtr<JSONWriteThread> writeThread
+            = getWriteLockedResource();
+    writeThread->scheduleWrite(jsonFile, jsonData);
+}
+
+
+// Immediately writes JSON data to a file, cancelling any pending write to the
+// same file.
+bool Assets::JSONWriter::writeNow
+(const juce::File& jsonFile, const juce::var& jsonData)
+{
+    SharedResource::LockedPtr<JSONWriteThread> writeThread
+            = getWriteLockedResource();
+    return writeThread->writeNow(jsonFile, jsonData);
+}
+
+
+// Immediately writes all pending JSON data on the calling thread.
+void Assets::JSONWriter::flush()
+{
+    SharedResource::LockedPtr<JSONWriteThread> writeThread
+            = getWriteLockedResource();
+    writeThread->flush();
+}
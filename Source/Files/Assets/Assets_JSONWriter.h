@@ -0,0 +1,55 @@
+#pragma once
+/**
+ * @file  Assets_JSONWriter.h
+ *
+ * @brief  Provides access to the shared JSON file write thread.
+ */
+
+#include "SharedResource_Handler.h"
+#include "JuceHeader.h"
+
+namespace Assets { class JSONWriter; }
+namespace Assets { class JSONWriteThread; }
+
+/**
+ * @brief  Writes JSON data to files through the shared JSONWriteThread.
+ *
+ *  JSON writes may either be scheduled to run later on the JSONWriteThread, or
+ * written immediately on the calling thread. The JSONWriteThread exists as
+ * long as any JSONWriter exists, so objects that schedule writes should hold a
+ * JSONWriter until they are destroyed.
+ */
+class Assets::JSONWriter : public SharedResource::Handler<JSONWriteThread>
+{
+public:
+    JSONWriter();
+
+    virtual ~JSONWriter() { }
+
+    /**
+     * @brief  Schedules JSON data to be written to a file on the write thread.
+     *
+     * @param jsonFile  The file where the data should be written.
+     *
+     * @param jsonData  A private copy of the JSON data to write. This data
+     *                  must not be changed after it is scheduled.
+     */
+    void scheduleWrite(const juce::File& jsonFile, const juce::var& jsonData);
+
+    /**
+     * @brief  Immediately writes JSON data to a file, cancelling any pending
+     *         write to the same file.
+     *
+     * @param jsonFile  The file where the data should be written.
+     *
+     * @param jsonData  The JSON data to write.
+     *
+     * @return          Whether the file was successfully written.
+     */
+    bool writeNow(const juce::File& jsonFile, const juce::var& jsonData);
+
+    /**
+     * @brief  Immediately writes all pending JSON data on the calling thread.
+     */
+    void flush();
+};
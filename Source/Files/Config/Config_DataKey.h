@@ -63,4 +63,37 @@ struct Config::DataKey
      * @return  A reference to the DataKey's Identifier key.
      */
     operator const juce::Identifier&() const;
+
+    /**
+     * @brief  Selects the DataType used to store a basic value type at compile
+     *         time.
+     *
+     * @tparam ValueType  A juce::String, int, bool, or double value type. Using
+     *                    any other type is a compile error.
+     */
+    template<typename ValueType> struct TypeOf;
 };
+
+// Specializations need to be in the same namespace as the original:
+namespace Config
+{
+    template<> struct DataKey::TypeOf<juce::String>
+    {
+        static const constexpr DataType value = stringType;
+    };
+
+    template<> struct DataKey::TypeOf<int>
+    {
+        static const constexpr DataType value = intType;
+    };
+
+    template<> struct DataKey::TypeOf<bool>
+    {
+        static const constexpr DataType value = boolType;
+    };
+
+    template<> struct DataKey::TypeOf<double>
+    {
+        static const constexpr DataType value = doubleType;
+    };
+}
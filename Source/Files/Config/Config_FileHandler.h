@@ -51,9 +51,11 @@ public:
     template<typename ValueType>
     ValueType getConfigValue(const juce::Identifier& key) const
     {
-        SharedResource::LockedPtr<const ResourceType> jsonPtr
-            = SharedResource::Handler<ResourceType>::getReadLockedResource();
-        return jsonPtr->template getConfigValue<ValueType>(key);
+        // Basic values are read from the resource's value snapshot, which
+        // doesn't require the resource lock:
+        const ResourceType* jsonResource
+            = SharedResource::Handler<ResourceType>::getSnapshotResource();
+        return jsonResource->template getConfigValue<ValueType>(key);
     }
 
     /**
@@ -84,4 +86,15 @@ public:
             = SharedResource::Handler<ResourceType>::getWriteLockedResource();
         return jsonPtr->template setConfigValue<ValueType>(key, newValue);
     }
+
+    /**
+     * @brief  Immediately writes all changes to the JSON configuration file,
+     *         instead of waiting for changes to be written in the background.
+     */
+    void syncChanges()
+    {
+        SharedResource::LockedPtr<ResourceType> jsonPtr
+            = SharedResource::Handler<ResourceType>::getWriteLockedResource();
+        jsonPtr->syncChanges();
+    }
 };
@@ -41,7 +41,7 @@ defaultJson(defaultAssetPath + filename) { }
 // Writes any pending changes to the file before destruction.
 Config::FileResource::~FileResource()
 {
-    writeChanges();
+    syncChanges();
 }
 
 
@@ -49,14 +49,11 @@ Config::FileResource::~FileResource()
 void Config::FileResource::restoreDefaultValue(const juce::Identifier& key)
 {
     // Check key validity, find expected data type:
-    const std::vector<DataKey>& keys = getConfigKeys();
-    for (const DataKey& configKey : keys)
+    const int keyIndex = getKeyIndex(key);
+    if (keyIndex >= 0)
     {
-        if (configKey.key == key)
-        {
-            restoreDefaultValue(configKey);
-            return;
-        }
+        restoreDefaultValue(keyTable->getKey(keyIndex));
+        return;
     }
     DBG(dbgPrefix << __func__ << ": Key \"" << key.toString()
                 << "\" is not expected in " << filename);
@@ -79,24 +76,31 @@ void Config::FileResource::restoreDefaultValues()
 // Loads all initial configuration data from the JSON config file.
 void Config::FileResource::loadJSONData()
 {
-    const std::vector<DataKey>& keys = getConfigKeys();
-    for (const DataKey& key : keys)
+    if (keyTable == nullptr)
     {
+        keyTable.reset(new KeyTable(getConfigKeys()));
+    }
+    std::shared_ptr<ValueTable> values
+            = std::make_shared<ValueTable>(*keyTable);
+    for (int i = 0; i < keyTable->size(); i++)
+    {
+        const DataKey& key = keyTable->getKey(i);
+        const int slot = keyTable->getSlot(i);
         try
         {
             switch(key.dataType)
             {
                 case DataKey::stringType:
-                    initProperty<juce::String>(key);
+                    values->setValue(slot, initProperty<juce::String>(key));
                     break;
                 case DataKey::intType:
-                    initProperty<int>(key);
+                    values->setValue(slot, initProperty<int>(key));
                     break;
                 case DataKey::boolType:
-                    initProperty<bool>(key);
+                    values->setValue(slot, initProperty<bool>(key));
                     break;
                 case DataKey::doubleType:
-                    initProperty<double>(key);
+                    values->setValue(slot, initProperty<double>(key));
                     break;
                 default:
                     DBG(dbgPrefix << __func__ << ": Unexpected type for key \""
@@ -114,6 +118,7 @@ void Config::FileResource::loadJSONData()
                     << e.what());
         }
     }
+    configValues.publish(values);
     writeChanges();
 }
 
@@ -121,23 +126,16 @@ void Config::FileResource::loadJSONData()
 // Checks if a key string is valid for this FileResource.
 bool Config::FileResource::isValidKey(const juce::Identifier& key) const
 {
-    const std::vector<DataKey>& keys = getConfigKeys();
-    for (const DataKey& configKey : keys)
-    {
-        if (configKey.key == key)
-        {
-            return true;
-        }
-    }
-    return false;
+    return getKeyIndex(key) >= 0;
 }
 
 
-// Re-writes all data back to the config file, as long as there are changes to
-// write.
-void Config::FileResource::writeChanges()
+// Immediately writes all data back to the config file, as long as there are
+// changes to write.
+void Config::FileResource::syncChanges()
 {
     writeDataToJSON();
+    copyValuesToJSON();
     try
     {
         configJson.writeChanges();
@@ -146,9 +144,65 @@ void Config::FileResource::writeChanges()
     {
         DBG(dbgPrefix << __func__ << ": Caught FileException:" << e.what());
     }
-    catch(Assets::JSONFile::TypeException e)
+}
+
+
+// Schedules all data to be written back to the config file, as long as there
+// are changes to write.
+void Config::FileResource::writeChanges()
+{
+    writeDataToJSON();
+    saveValues();
+}
+
+
+// Finds the index assigned to a basic value key.
+int Config::FileResource::getKeyIndex(const juce::Identifier& key) const
+{
+    if (keyTable == nullptr)
     {
-        DBG(dbgPrefix << __func__ << ": Caught TypeException:" << e.what());
+        // JSON data hasn't been loaded yet:
+        return -1;
+    }
+    return keyTable->getIndex(key);
+}
+
+
+// Copies all basic values into the JSON data, and schedules the JSON file to
+// be written if any values changed.
+void Config::FileResource::saveValues()
+{
+    copyValuesToJSON();
+    configJson.scheduleWrite();
+}
+
+
+// Copies all basic values into the JSON data.
+void Config::FileResource::copyValuesToJSON()
+{
+    if (keyTable == nullptr)
+    {
+        return;
+    }
+    const ValueSnapshot::Ptr values = configValues.read();
+    for (int i = 0; i < keyTable->size(); i++)
+    {
+        const DataKey& key = keyTable->getKey(i);
+        updateProperty<juce::var>(key,
+                values->getVar(key.dataType, keyTable->getSlot(i)));
+    }
+}
+
+
+// Specializations need to be in the same namespace as the original:
+namespace Config
+{
+    // Reads a value of any type from a value table.
+    template<> juce::var FileResource::readValue<juce::var>
+    (const ValueTable& values, const int keyIndex) const
+    {
+        return values.getVar(keyTable->getKey(keyIndex).dataType,
+                keyTable->getSlot(keyIndex));
     }
 }
 
@@ -8,11 +8,15 @@
 #include "Config_ListenerInterface.h"
 #include "SharedResource_Resource.h"
 #include "SharedResource_Handler.h"
+#include "SharedResource_Snapshot.h"
 #include "Config_DataKey.h"
+#include "Config_KeyTable.h"
+#include "Config_ValueTable.h"
 #include "Assets_JSONFile.h"
 #include "JuceHeader.h"
 #include <iostream>
 #include <map>
+#include <memory>
 
 namespace Config { class FileResource; }
 namespace Config { struct DataKey; }
@@ -40,6 +44,23 @@ namespace Config { struct DataKey; }
  *  FileResource reads from each JSON file only once per program instance, so
  * any external changes to the file that occur while the program is running
  * will most likely be ignored and may be overwritten.
+ *
+ *  Changes are not written to the JSON file immediately. Instead, they are
+ * written on the shared Assets::JSONWriteThread once changes stop for a short
+ * delay, so that many quick changes only write the file once. Changes are
+ * always written before the FileResource is destroyed, and syncChanges may be
+ * used to write them immediately.
+ *
+ *  Basic configuration values are also published as an immutable
+ * SharedResource::Snapshot whenever they change. Because of this,
+ * getConfigValue may be called without locking the FileResource, so that
+ * FileHandler objects never wait on the resource lock to read basic values.
+ *
+ *  Each basic value key is assigned an index in a Config::KeyTable when JSON
+ * data is loaded, and basic values are stored in a Config::ValueTable holding
+ * typed value arrays. Reading a value only finds the key's index and copies the
+ * value from its typed array, and JSON data is only updated when values are
+ * loaded or saved.
  */
 class Config::FileResource : public SharedResource::Resource
 {
@@ -67,17 +88,22 @@ public:
     /**
      * @brief  Gets one of the values stored in the JSON configuration file.
      *
+     *  Values are read from the most recently published value snapshot, so
+     * this function does not require the resource lock.
+     *
      * @param key                       The key string that maps to the desired
      *                                  value.
      *
-     * @tparam ValueType                The value's data type.
+     * @tparam ValueType                The value's data type. This may be
+     *                                  juce::var to read a value of any type.
      *
      * @return                          The value read from the config file.
      */
     template<typename ValueType >
     ValueType getConfigValue(const juce::Identifier& key) const
     {
-        if (!isValidKey(key))
+        const int keyIndex = getKeyIndex(key);
+        if (keyIndex < 0)
         {
             DBG("Config::FileResource::" << __func__
                     << ": Attempted changing invalid key \""
@@ -85,25 +111,8 @@ public:
             jassertfalse;
             return ValueType();
         }
-        try
-        {
-            return configJson.getProperty<ValueType>(key);
-        }
-        catch(Assets::JSONFile::TypeException e)
-        {
-            std::cerr << "Config::FileResource::" << __func__
-                << ": Failed to load key \"" << e.getPropertyKey().toString()
-                << "\" in file \"" << filename << "\", expected type: "
-                << e.getExpectedType() <<", actual type: " << e.getFoundType()
-                << ", exception = " << e.what() << "\n";
-        }
-        catch(Assets::JSONFile::FileException e)
-        {
-            DBG("Config::FileResource::" << __func__
-                    << ": Failed to access file \"" << filename
-                    << "\", exception = " << e.what());
-        }
-        return ValueType();
+        const ValueSnapshot::Ptr values = configValues.read();
+        return readValue<ValueType>(*values, keyIndex);
     }
 
     /**
@@ -123,7 +132,8 @@ public:
     template<typename ValueType>
     bool setConfigValue(const juce::Identifier& key, ValueType newValue)
     {
-        if (!isValidKey(key))
+        const int keyIndex = getKeyIndex(key);
+        if (keyIndex < 0)
         {
             DBG("Config::FileResource::" << __func__
                     << ": Attempted changing invalid key \""
@@ -131,9 +141,9 @@ public:
             jassertfalse;
             return false;
         }
-        if (updateProperty<ValueType>(key, newValue))
+        if (storeValue<ValueType>(keyIndex, newValue))
         {
-            configJson.writeChanges();
+            saveValues();
             int nListeners = 0;
             int nTracked = 0;
             foreachHandler<ListenerInterface>(
@@ -175,6 +185,15 @@ public:
      */
     virtual void restoreDefaultValues();
 
+    /**
+     * @brief  Immediately writes all data back to the config file, as long as
+     *         there are changes to write.
+     *
+     *  This replaces any scheduled write to the config file that hasn't
+     * finished yet.
+     */
+    void syncChanges();
+
 protected:
     /**
      * @brief  Loads all initial configuration data from the JSON config file.
@@ -296,12 +315,106 @@ protected:
     }
 
     /**
-     * @brief  Re-writes all data back to the config file, as long as there are
-     *         changes to write.
+     * @brief  Schedules all data to be written back to the config file, as
+     *         long as there are changes to write.
+     *
+     *  The file is written on the shared Assets::JSONWriteThread once no JSON
+     * file writes have been scheduled for a short delay.
      */
     void writeChanges();
 
 private:
+    // Holds an immutable copy of all basic configuration values:
+    typedef SharedResource::Snapshot<ValueTable> ValueSnapshot;
+
+    /**
+     * @brief  Finds the index assigned to a basic value key.
+     *
+     * @param key  A key string to find.
+     *
+     * @return     The key's index in the key table, or -1 if the key is not
+     *             valid for this FileResource.
+     */
+    int getKeyIndex(const juce::Identifier& key) const;
+
+    /**
+     * @brief  Reads a value from a value table, checking that the requested
+     *         type matches the key's data type.
+     *
+     * @tparam ValueType  A juce::String, int, bool, or double value type.
+     *
+     * @param values      A copy of all basic configuration values.
+     *
+     * @param keyIndex    The index of a valid configuration key.
+     *
+     * @return            The stored value, or the default ValueType value if
+     *                    the type does not match.
+     */
+    template<typename ValueType>
+    ValueType readValue(const ValueTable& values, const int keyIndex) const
+    {
+        const DataKey& dataKey = keyTable->getKey(keyIndex);
+        if (dataKey.dataType != DataKey::TypeOf<ValueType>::value)
+        {
+            std::cerr << "Config::FileResource::" << __func__
+                << ": Failed to load key \"" << dataKey.key.toString()
+                << "\" in file \"" << filename
+                << "\", value has the wrong type.\n";
+            return ValueType();
+        }
+        return values.getValue<ValueType>(keyTable->getSlot(keyIndex));
+    }
+
+    /**
+     * @brief  Stores a new basic value, publishing a new value snapshot if the
+     *         value changes.
+     *
+     *  This does not write the value to the JSON file, or notify listeners.
+     *
+     * @tparam ValueType  A juce::String, int, bool, or double value type.
+     *
+     * @param keyIndex    The index of a valid configuration key.
+     *
+     * @param newValue    The new value to store.
+     *
+     * @return            True if the value changed, false if the new value
+     *                    matched the old value or had the wrong type.
+     */
+    template<typename ValueType>
+    bool storeValue(const int keyIndex, const ValueType newValue)
+    {
+        const DataKey& dataKey = keyTable->getKey(keyIndex);
+        if (dataKey.dataType != DataKey::TypeOf<ValueType>::value)
+        {
+            DBG("Config::FileResource::" << __func__
+                    << ": Wrong value type used to change key \""
+                    << dataKey.key.toString() << "\" in file " << filename);
+            jassertfalse;
+            return false;
+        }
+        const int slot = keyTable->getSlot(keyIndex);
+        if (configValues.read()->getValue<ValueType>(slot) == newValue)
+        {
+            return false;
+        }
+        configValues.edit([slot, &newValue](ValueTable& values)
+        {
+            values.setValue<ValueType>(slot, newValue);
+        });
+        return true;
+    }
+
+    /**
+     * @brief  Copies all basic values into the JSON data, and schedules the
+     *         JSON file to be written if any values changed.
+     */
+    void saveValues();
+
+    /**
+     * @brief  Copies all basic values into the JSON data.
+     */
+    void copyValuesToJSON();
+
     /**
      * @brief  Sets a configuration data value back to its default setting,
      *         notifying listeners if the value changes.
@@ -331,5 +444,18 @@ private:
     // Default config file values:
     Assets::JSONFile defaultJson;
 
+    // Assigns indices and value slots to all basic value keys:
+    std::unique_ptr<const KeyTable> keyTable;
+
+    // The most recently published copy of all basic configuration values:
+    ValueSnapshot configValues;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileResource)
 };
+
+// Specializations need to be in the same namespace as the original:
+namespace Config
+{
+    template<> juce::var FileResource::readValue<juce::var>
+    (const ValueTable& values, const int keyIndex) const;
+}
@@ -91,8 +91,8 @@ public:
     template<typename ValueType>
     ValueType getConfigValue(const juce::Identifier& key)
     {
-        SharedResource::LockedPtr<const ResourceClass> configFile
-            = SharedResource::Handler<ResourceClass>::getReadLockedResource();
+        const ResourceClass* configFile
+            = SharedResource::Handler<ResourceClass>::getSnapshotResource();
         return configFile->template getConfigValue<ValueType>(key);
     }
 
@@ -13,6 +13,14 @@ int Config::MainFile::getWifiScanFrequency() const
 }
 
 
+// Gets the maximum amount of memory that may be used to cache loaded icon
+// images.
+int Config::MainFile::getIconCacheSize() const
+{
+    return getConfigValue<int>(MainKeys::iconCacheSize);
+}
+
+
 // Gets the prefix to place before system commands when they should be launched
 // within a new terminal window.
 juce::String Config::MainFile::getTermLaunchPrefix() const
@@ -30,6 +30,14 @@ public:
      */
     int getWifiScanFrequency() const;
 
+    /**
+     * @brief  Gets the maximum amount of memory that may be used to cache
+     *         loaded icon images.
+     *
+     * @return  The icon cache size limit, in kilobytes.
+     */
+    int getIconCacheSize() const;
+
     /**
      * @brief  Gets the HomePage background image or colour.
      *
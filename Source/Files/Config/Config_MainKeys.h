@@ -16,6 +16,10 @@ namespace Config
         // points while the Wifi page is open.
         static const DataKey wifiScanFreq
             ("Wifi AP scan frequency", DataKey::intType);
+        // Sets the maximum amount of memory, in kilobytes, used to cache
+        // loaded icon images.
+        static const DataKey iconCacheSize
+            ("Icon cache size", DataKey::intType);
 
         //####################### String value keys: ##########################
         // Sets the name of the wifi interface
@@ -49,6 +53,7 @@ namespace Config
         static const std::vector<DataKey> allKeys
         {
             wifiScanFreq,
+            iconCacheSize,
             wifiInterface,
             termLaunchCommand,
             showCursor,
@@ -0,0 +1,95 @@
+#include "Config_KeyTable.h"
+
+// Smallest hash table size to use:
+static const constexpr int minHashSize = 8;
+
+// Value used to mark empty hash table positions:
+static const constexpr int emptyPosition = -1;
+
+
+// Creates the table, assigning indices and value slots to all keys.
+Config::KeyTable::KeyTable(const std::vector<DataKey>& keys) : keys(keys)
+{
+    for (const DataKey& key : keys)
+    {
+        slots.push_back(typeCounts[key.dataType]++);
+    }
+
+    // Keep the table at most half full so searches stay short:
+    int hashSize = minHashSize;
+    while (hashSize < (int) keys.size() * 2)
+    {
+        hashSize *= 2;
+    }
+    hashTable.resize(hashSize, emptyPosition);
+    for (int i = 0; i < (int) keys.size(); i++)
+    {
+        int position = getHashPosition(keys[i].key);
+        while (hashTable[position] != emptyPosition)
+        {
+            // Duplicate keys would be impossible to tell apart:
+            jassert(keys[hashTable[position]].key != keys[i].key);
+            position = (position + 1) & (hashSize - 1);
+        }
+        hashTable[position] = i;
+    }
+}
+
+
+// Finds the index assigned to a data key.
+int Config::KeyTable::getIndex(const juce::Identifier& key) const
+{
+    const int hashMask = hashTable.size() - 1;
+    for (int position = getHashPosition(key);
+            hashTable[position] != emptyPosition;
+            position = (position + 1) & hashMask)
+    {
+        if (keys[hashTable[position]].key == key)
+        {
+            return hashTable[position];
+        }
+    }
+    return -1;
+}
+
+
+// Gets the number of keys in the table.
+int Config::KeyTable::size() const
+{
+    return keys.size();
+}
+
+
+// Gets the data key assigned to an index.
+const Config::DataKey& Config::KeyTable::getKey(const int index) const
+{
+    jassert(index >= 0 && index < size());
+    return keys[index];
+}
+
+
+// Gets the position of a key's value within the array of values with the same
+// data type.
+int Config::KeyTable::getSlot(const int index) const
+{
+    jassert(index >= 0 && index < size());
+    return slots[index];
+}
+
+
+// Gets the number of keys in the table with a specific data type.
+int Config::KeyTable::getTypeCount(const DataKey::DataType dataType) const
+{
+    return typeCounts[dataType];
+}
+
+
+// Gets the position in the hash table where searching for a key should start.
+int Config::KeyTable::getHashPosition(const juce::Identifier& key) const
+{
+    // Pooled strings are allocated with at least eight byte alignment, so the
+    // lowest address bits are skipped:
+    const juce::pointer_sized_uint address = (juce::pointer_sized_uint)
+            key.getCharPointer().getAddress();
+    return (int) ((address >> 3) & (hashTable.size() - 1));
+}
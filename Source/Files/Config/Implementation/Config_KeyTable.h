@@ -0,0 +1,108 @@
+#pragma once
+/**
+ * @file  Config_KeyTable.h
+ *
+ * @brief  Maps the basic data keys of a configuration file to dense indices.
+ */
+
+#include "Config_DataKey.h"
+#include "JuceHeader.h"
+#include <vector>
+
+namespace Config { class KeyTable; }
+
+/**
+ * @brief  Assigns each basic value key defined by a FileResource an index, and
+ *         assigns each index a slot in the typed value array that holds its
+ *         value.
+ *
+ *  Keys are assigned indices in the order they are listed in the FileResource
+ * key list. Because all juce::Identifier objects with the same name share the
+ * same pooled string, keys are found by the address of their string data
+ * rather than by comparing strings.
+ *
+ *  A KeyTable cannot be changed once it is created, so it may be shared between
+ * threads without locking.
+ */
+class Config::KeyTable
+{
+public:
+    /**
+     * @brief  Creates the table, assigning indices and value slots to all keys.
+     *
+     * @param keys  All basic data keys used by a FileResource.
+     */
+    KeyTable(const std::vector<DataKey>& keys);
+
+    virtual ~KeyTable() { }
+
+    /**
+     * @brief  Finds the index assigned to a data key.
+     *
+     * @param key  A basic data key string.
+     *
+     * @return     The key's index, or -1 if the key is not in the table.
+     */
+    int getIndex(const juce::Identifier& key) const;
+
+    /**
+     * @brief  Gets the number of keys in the table.
+     *
+     * @return  The number of keys, which is one more than the largest key
+     *          index.
+     */
+    int size() const;
+
+    /**
+     * @brief  Gets the data key assigned to an index.
+     *
+     * @param index  A valid key index.
+     *
+     * @return       The key's name and data type.
+     */
+    const DataKey& getKey(const int index) const;
+
+    /**
+     * @brief  Gets the position of a key's value within the array of values
+     *         with the same data type.
+     *
+     * @param index  A valid key index.
+     *
+     * @return       The key's value slot.
+     */
+    int getSlot(const int index) const;
+
+    /**
+     * @brief  Gets the number of keys in the table with a specific data type.
+     *
+     * @param dataType  One of the basic data types.
+     *
+     * @return          The size of the value array needed for that type.
+     */
+    int getTypeCount(const DataKey::DataType dataType) const;
+
+private:
+    /**
+     * @brief  Gets the position in the hash table where searching for a key
+     *         should start.
+     *
+     * @param key  A basic data key string.
+     *
+     * @return     The key's hash table position.
+     */
+    int getHashPosition(const juce::Identifier& key) const;
+
+    // All keys, ordered by index:
+    std::vector<DataKey> keys;
+
+    // Value slots, ordered by key index:
+    std::vector<int> slots;
+
+    // Number of keys with each data type:
+    int typeCounts[DataKey::doubleType + 1] = {};
+
+    // Key indices stored by key hash, with -1 marking empty positions:
+    std::vector<int> hashTable;
+
+    JUCE_DECLARE_NON_COPYABLE(KeyTable);
+};
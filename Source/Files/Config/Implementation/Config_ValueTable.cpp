@@ -0,0 +1,59 @@
+#include "Config_ValueTable.h"
+#include "Config_KeyTable.h"
+
+
+// Creates a value table with a default value in each key slot.
+Config::ValueTable::ValueTable(const KeyTable& keyTable) :
+stringValues(keyTable.getTypeCount(DataKey::stringType)),
+intValues(keyTable.getTypeCount(DataKey::intType)),
+boolValues(keyTable.getTypeCount(DataKey::boolType)),
+doubleValues(keyTable.getTypeCount(DataKey::doubleType)) { }
+
+
+// Gets a single value as a juce::var.
+juce::var Config::ValueTable::getVar
+(const DataKey::DataType dataType, const int slot) const
+{
+    switch(dataType)
+    {
+        case DataKey::stringType:
+            return getValue<juce::String>(slot);
+        case DataKey::intType:
+            return getValue<int>(slot);
+        case DataKey::boolType:
+            return getValue<bool>(slot);
+        case DataKey::doubleType:
+            return getValue<double>(slot);
+    }
+    return juce::var();
+}
+
+
+// Specializations need to be in the same namespace as the original:
+namespace Config
+{
+    // Gets the array holding all values of a single type.
+    template<> std::vector<juce::String>&
+    ValueTable::getValues<juce::String>() { return stringValues; }
+
+    template<> std::vector<int>&
+    ValueTable::getValues<int>() { return intValues; }
+
+    template<> std::vector<bool>&
+    ValueTable::getValues<bool>() { return boolValues; }
+
+    template<> std::vector<double>&
+    ValueTable::getValues<double>() { return doubleValues; }
+
+    template<> const std::vector<juce::String>&
+    ValueTable::getValues<juce::String>() const { return stringValues; }
+
+    template<> const std::vector<int>&
+    ValueTable::getValues<int>() const { return intValues; }
+
+    template<> const std::vector<bool>&
+    ValueTable::getValues<bool>() const { return boolValues; }
+
+    template<> const std::vector<double>&
+    ValueTable::getValues<double>() const { return doubleValues; }
+}
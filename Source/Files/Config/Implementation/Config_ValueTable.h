@@ -0,0 +1,124 @@
+#pragma once
+/**
+ * @file  Config_ValueTable.h
+ *
+ * @brief  Stores all basic values of a configuration file in typed arrays.
+ */
+
+#include "Config_DataKey.h"
+#include "JuceHeader.h"
+#include <vector>
+
+namespace Config { class ValueTable; }
+namespace Config { class KeyTable; }
+
+/**
+ * @brief  Holds one copy of every basic configuration value, with each value
+ *         stored in a contiguous array of values with the same type.
+ *
+ *  Values are accessed by their slot, as assigned by a Config::KeyTable. Value
+ * tables don't check key types themselves, so each value must be accessed
+ * using the type of its DataKey.
+ */
+class Config::ValueTable
+{
+public:
+    /**
+     * @brief  Creates an empty value table.
+     */
+    ValueTable() { }
+
+    /**
+     * @brief  Creates a value table with a default value in each key slot.
+     *
+     * @param keyTable  The key table used to find value slots.
+     */
+    ValueTable(const KeyTable& keyTable);
+
+    virtual ~ValueTable() { }
+
+    /**
+     * @brief  Gets a single value.
+     *
+     * @tparam ValueType  A juce::String, int, bool, or double value type.
+     *
+     * @param slot        The value's slot within the array of values with the
+     *                    same type.
+     *
+     * @return            The stored value.
+     */
+    template<typename ValueType> ValueType getValue(const int slot) const
+    {
+        return getValues<ValueType>()[slot];
+    }
+
+    /**
+     * @brief  Replaces a single value.
+     *
+     * @tparam ValueType  A juce::String, int, bool, or double value type.
+     *
+     * @param slot        The value's slot within the array of values with the
+     *                    same type.
+     *
+     * @param newValue    The new value to store.
+     */
+    template<typename ValueType>
+    void setValue(const int slot, const ValueType newValue)
+    {
+        getValues<ValueType>()[slot] = newValue;
+    }
+
+    /**
+     * @brief  Gets a single value as a juce::var.
+     *
+     * @param dataType  The value's data type.
+     *
+     * @param slot      The value's slot within the array of values with the
+     *                  same type.
+     *
+     * @return          The stored value.
+     */
+    juce::var getVar(const DataKey::DataType dataType, const int slot) const;
+
+private:
+    /**
+     * @brief  Gets the array holding all values of a single type.
+     *
+     * @tparam ValueType  A juce::String, int, bool, or double value type.
+     *
+     * @return            The value array for that type.
+     */
+    template<typename ValueType> std::vector<ValueType>& getValues();
+
+    /**
+     * @brief  Gets the array holding all values of a single type.
+     *
+     * @tparam ValueType  A juce::String, int, bool, or double value type.
+     *
+     * @return            The value array for that type.
+     */
+    template<typename ValueType>
+    const std::vector<ValueType>& getValues() const;
+
+    std::vector<juce::String> stringValues;
+    std::vector<int> intValues;
+    std::vector<bool> boolValues;
+    std::vector<double> doubleValues;
+};
+
+// Specializations need to be in the same namespace as the original:
+namespace Config
+{
+    template<> std::vector<juce::String>&
+    ValueTable::getValues<juce::String>();
+    template<> std::vector<int>& ValueTable::getValues<int>();
+    template<> std::vector<bool>& ValueTable::getValues<bool>();
+    template<> std::vector<double>& ValueTable::getValues<double>();
+
+    template<> const std::vector<juce::String>&
+    ValueTable::getValues<juce::String>() const;
+    template<> const std::vector<int>& ValueTable::getValues<int>() const;
+    template<> const std::vector<bool>& ValueTable::getValues<bool>() const;
+    template<> const std::vector<double>&
+    ValueTable::getValues<double>() const;
+}
@@ -0,0 +1,280 @@
+#define DESKTOP_ENTRY_IMPLEMENTATION
+#include "DesktopEntry_EntryCache.h"
+#include "Assets_XDGDirectories.h"
+#include "Locale.h"
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "DesktopEntry::EntryCache::";
+#endif
+
+// Path to the cache file within the user's cache directory:
+static const constexpr char* cachePath = "/pocket-home/desktop-entries.cache";
+
+// Marks the start of every valid cache file:
+static const constexpr int cacheMagic = 0x50484443; // "PHDC"
+
+// Cache file format version. Increment this whenever the cache file format or
+// the EntryFile stream format changes, so that old cache files are ignored
+// instead of misread.
+static const constexpr int cacheVersion = 2;
+
+// Creates a record holding a file's current modification time and size.
+DesktopEntry::EntryCache::FileRecord::FileRecord(const juce::File& file) :
+file(file),
+modTime(file.getLastModificationTime().toMilliseconds()),
+size(file.getSize()) { }
+
+
+// Checks if two records describe the same version of the same file.
+bool DesktopEntry::EntryCache::FileRecord::operator==
+(const FileRecord& toCompare) const
+{
+    return modTime == toCompare.modTime && size == toCompare.size
+            && file == toCompare.file;
+}
+
+
+/**
+ * @brief  Reads a list of file records from a cache file's data stream.
+ *
+ * @param input    A stream positioned at the start of a file record list.
+ *
+ * @param records  An empty map where the file records will be stored.
+ *
+ * @return         Whether a complete record list was read.
+ */
+static bool readFileRecords(juce::MemoryInputStream& input,
+        std::map<juce::String, DesktopEntry::EntryCache::FileRecord>& records)
+{
+    const int recordCount = input.readInt();
+    for (int i = 0; i < recordCount && !input.isExhausted(); i++)
+    {
+        DesktopEntry::EntryCache::FileRecord& record
+                = records[input.readString()];
+        record.file = juce::File(input.readString());
+        record.modTime = input.readInt64();
+        record.size = input.readInt64();
+    }
+    return (int) records.size() == recordCount;
+}
+
+
+/**
+ * @brief  Writes a list of file records to a cache file's output stream.
+ *
+ * @param output   The cache file's output stream.
+ *
+ * @param records  The file records to write.
+ */
+static void writeFileRecords(juce::OutputStream& output,
+        const std::map<juce::String, DesktopEntry::EntryCache::FileRecord>&
+        records)
+{
+    output.writeInt((int) records.size());
+    for (const auto& recordIter : records)
+    {
+        output.writeString(recordIter.first);
+        output.writeString(recordIter.second.file.getFullPathName());
+        output.writeInt64(recordIter.second.modTime);
+        output.writeInt64(recordIter.second.size);
+    }
+}
+
+
+/**
+ * @brief  Reads all desktop entry data from a cache file's data stream.
+ *
+ * @param input        A stream holding all cache file data.
+ *
+ * @param fileRecords     An empty map where cached entry file records will be
+ *                        stored.
+ *
+ * @param failedFiles     An empty map where cached records of files that
+ *                        failed to parse will be stored.
+ *
+ * @param directoryTimes  An empty map where cached entry directory
+ *                        modification times will be stored.
+ *
+ * @param entries         An empty map where cached entry data will be stored.
+ *
+ * @param categories      An empty map where cached category lists will be
+ *                        stored.
+ *
+ * @return                Whether the stream held complete and valid cache
+ *                        data for the current locale.
+ */
+static bool readCacheData(juce::MemoryInputStream& input,
+        std::map<juce::String, DesktopEntry::EntryCache::FileRecord>&
+        fileRecords,
+        std::map<juce::String, DesktopEntry::EntryCache::FileRecord>&
+        failedFiles,
+        std::map<juce::String, juce::int64>& directoryTimes,
+        std::map<juce::String, DesktopEntry::EntryFile>& entries,
+        std::map<juce::String, juce::StringArray>& categories)
+{
+    using juce::String;
+    if (input.readInt() != cacheMagic || input.readInt() != cacheVersion
+            || input.readString() != Locale::getLocaleName())
+    {
+        DBG(dbgPrefix << __func__ << ": Cache file is outdated.");
+        return false;
+    }
+    if (!readFileRecords(input, fileRecords)
+            || !readFileRecords(input, failedFiles))
+    {
+        return false;
+    }
+    const int directoryCount = input.readInt();
+    for (int i = 0; i < directoryCount && !input.isExhausted(); i++)
+    {
+        juce::int64& modTime = directoryTimes[input.readString()];
+        modTime = input.readInt64();
+    }
+    const int entryCount = input.readInt();
+    for (int i = 0; i < entryCount && !input.isExhausted(); i++)
+    {
+        const String entryID = input.readString();
+        if (fileRecords.count(entryID) == 0
+                || !entries[entryID].readFromStream(input))
+        {
+            return false;
+        }
+    }
+    const int categoryCount = input.readInt();
+    for (int i = 0; i < categoryCount && !input.isExhausted(); i++)
+    {
+        juce::StringArray& categoryIDs = categories[input.readString()];
+        const int idCount = input.readInt();
+        if (idCount < 0 || idCount > input.getNumBytesRemaining())
+        {
+            return false;
+        }
+        for (int idNum = 0; idNum < idCount; idNum++)
+        {
+            categoryIDs.add(input.readString());
+        }
+    }
+    return (int) directoryTimes.size() == directoryCount
+            && (int) entries.size() == entryCount
+            && (int) categories.size() == categoryCount
+            && input.getPosition() == input.getTotalLength();
+}
+
+
+DesktopEntry::EntryCache::EntryCache() :
+cacheFile(Assets::XDGDirectories::getUserCachePath() + cachePath) { }
+
+
+// Loads all saved desktop entry data from the cache file.
+bool DesktopEntry::EntryCache::readCache
+(std::map<juce::String, FileRecord>& fileRecords,
+        std::map<juce::String, FileRecord>& failedFiles,
+        std::map<juce::String, juce::int64>& directoryTimes,
+        std::map<juce::String, EntryFile>& entries,
+        std::map<juce::String, juce::StringArray>& categories) const
+{
+    using juce::String;
+    const juce::int64 fileLen = cacheFile.getSize();
+    if (fileLen <= 0)
+    {
+        return false;
+    }
+    const int fd = open(cacheFile.getFullPathName().toRawUTF8(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    void* fileMap = mmap(nullptr, fileLen, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (fileMap == MAP_FAILED)
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to map cache file "
+                << cacheFile.getFullPathName());
+        return false;
+    }
+
+    std::map<String, FileRecord> cachedRecords;
+    std::map<String, FileRecord> cachedFailures;
+    std::map<String, juce::int64> cachedDirectoryTimes;
+    std::map<String, EntryFile> cachedEntries;
+    std::map<String, juce::StringArray> cachedCategories;
+    juce::MemoryInputStream input(fileMap, (size_t) fileLen, false);
+    const bool dataValid = readCacheData(input, cachedRecords, cachedFailures,
+            cachedDirectoryTimes, cachedEntries, cachedCategories);
+    munmap(fileMap, fileLen);
+    if (!dataValid)
+    {
+        DBG(dbgPrefix << __func__ << ": Ignoring invalid cache file "
+                << cacheFile.getFullPathName());
+        return false;
+    }
+    fileRecords.swap(cachedRecords);
+    failedFiles.swap(cachedFailures);
+    directoryTimes.swap(cachedDirectoryTimes);
+    entries.swap(cachedEntries);
+    categories.swap(cachedCategories);
+    return true;
+}
+
+
+// Saves all desktop entry data to the cache file, replacing any previously
+// saved data.
+bool DesktopEntry::EntryCache::writeCache
+(const std::map<juce::String, FileRecord>& fileRecords,
+        const std::map<juce::String, FileRecord>& failedFiles,
+        const std::map<juce::String, juce::int64>& directoryTimes,
+        const std::map<juce::String, EntryFile>& entries,
+        const std::map<juce::String, juce::StringArray>& categories) const
+{
+    if (!cacheFile.getParentDirectory().createDirectory())
+    {
+        return false;
+    }
+    // Write to a temporary file first, so that partially written cache files
+    // are never read:
+    juce::TemporaryFile tempFile(cacheFile);
+    {
+        juce::FileOutputStream output(tempFile.getFile());
+        if (output.failedToOpen())
+        {
+            return false;
+        }
+        output.writeInt(cacheMagic);
+        output.writeInt(cacheVersion);
+        output.writeString(Locale::getLocaleName());
+        writeFileRecords(output, fileRecords);
+        writeFileRecords(output, failedFiles);
+        output.writeInt((int) directoryTimes.size());
+        for (const auto& directoryIter : directoryTimes)
+        {
+            output.writeString(directoryIter.first);
+            output.writeInt64(directoryIter.second);
+        }
+        output.writeInt((int) entries.size());
+        for (const auto& entryIter : entries)
+        {
+            output.writeString(entryIter.first);
+            entryIter.second.writeToStream(output);
+        }
+        output.writeInt((int) categories.size());
+        for (const auto& categoryIter : categories)
+        {
+            output.writeString(categoryIter.first);
+            output.writeInt(categoryIter.second.size());
+            for (const juce::String& entryID : categoryIter.second)
+            {
+                output.writeString(entryID);
+            }
+        }
+        output.flush();
+        if (output.getStatus().failed())
+        {
+            return false;
+        }
+    }
+    return tempFile.overwriteTargetFileWithTemporary();
+}
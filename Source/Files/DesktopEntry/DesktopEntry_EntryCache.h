@@ -0,0 +1,138 @@
+#ifndef DESKTOP_ENTRY_IMPLEMENTATION
+    #error File included directly outside of DesktopEntry implementation.
+#endif
+#pragma once
+/**
+ * @file  DesktopEntry_EntryCache.h
+ *
+ * @brief  Saves loaded desktop entry data to the user's cache directory, so
+ *         that it can be reloaded without parsing desktop entry files.
+ */
+
+#include "DesktopEntry_EntryFile.h"
+#include <map>
+
+namespace DesktopEntry { class EntryCache; }
+
+/**
+ * @brief  Reads and writes a binary snapshot of all loaded desktop entry data
+ *         within the user's XDG cache directory.
+ *
+ *  The cache file stores the path, modification time, and size of each
+ * desktop entry file found when the snapshot was saved, along with all parsed
+ * EntryFile data and the desktop entry category map. After reading the cache
+ * file, the LoadingThread only needs to parse desktop entry files that were
+ * added, or that no longer match their saved modification time and size.
+ *
+ *  Records of entry files that failed to parse are saved separately, so that
+ * those files are only parsed again once they change. The modification times
+ * of all desktop entry directories are also saved, so the LoadingThread may
+ * skip checking individual entry files when no directory has changed.
+ *
+ *  Cache files are mapped to memory when read. Cache files saved using a
+ * different cache format version or system locale are ignored, as are cache
+ * files that are incomplete or invalid. EntryCache objects hold no mutable
+ * state, so they may be used from multiple threads at once.
+ */
+class DesktopEntry::EntryCache
+{
+public:
+    /**
+     * @brief  Identifies the exact version of a desktop entry file.
+     */
+    struct FileRecord
+    {
+        /**
+         * @brief  Creates an empty record that matches no files.
+         */
+        FileRecord() { }
+
+        /**
+         * @brief  Creates a record holding a file's current modification time
+         *         and size.
+         *
+         * @param file  A desktop entry file.
+         */
+        FileRecord(const juce::File& file);
+
+        /**
+         * @brief  Checks if two records describe the same version of the same
+         *         file.
+         *
+         * @param toCompare  Another file record to compare with this one.
+         *
+         * @return           Whether both records have identical paths,
+         *                   modification times, and sizes.
+         */
+        bool operator== (const FileRecord& toCompare) const;
+
+        // The desktop entry file:
+        juce::File file;
+        // The file's modification time in milliseconds since the Unix epoch:
+        juce::int64 modTime = 0;
+        // The file's size in bytes:
+        juce::int64 size = 0;
+    };
+
+    EntryCache();
+
+    virtual ~EntryCache() { }
+
+    /**
+     * @brief  Loads all saved desktop entry data from the cache file.
+     *
+     * @param fileRecords     A map where desktop file IDs will be mapped to
+     *                        records of the entry files found when the cache
+     *                        was saved.
+     *
+     * @param failedFiles     A map where desktop file IDs will be mapped to
+     *                        records of entry files that failed to parse.
+     *
+     * @param directoryTimes  A map where desktop entry directory paths will be
+     *                        mapped to their saved modification times.
+     *
+     * @param entries         A map where desktop file IDs will be mapped to
+     *                        saved EntryFile data.
+     *
+     * @param categories      A map where category names will be mapped to
+     *                        saved lists of desktop file IDs.
+     *
+     * @return                Whether valid data was loaded. If this returns
+     *                        false, all maps will be left unchanged.
+     */
+    bool readCache(std::map<juce::String, FileRecord>& fileRecords,
+            std::map<juce::String, FileRecord>& failedFiles,
+            std::map<juce::String, juce::int64>& directoryTimes,
+            std::map<juce::String, EntryFile>& entries,
+            std::map<juce::String, juce::StringArray>& categories) const;
+
+    /**
+     * @brief  Saves all desktop entry data to the cache file, replacing any
+     *         previously saved data.
+     *
+     * @param fileRecords     Maps desktop file IDs to records of all known
+     *                        entry files.
+     *
+     * @param failedFiles     Maps desktop file IDs to records of entry files
+     *                        that failed to parse.
+     *
+     * @param directoryTimes  Maps desktop entry directory paths to their
+     *                        modification times when they were last scanned.
+     *
+     * @param entries         Maps desktop file IDs to all loaded EntryFile
+     *                        data.
+     *
+     * @param categories      Maps category names to lists of desktop file IDs.
+     *
+     * @return                Whether the cache file was successfully saved.
+     */
+    bool writeCache(const std::map<juce::String, FileRecord>& fileRecords,
+            const std::map<juce::String, FileRecord>& failedFiles,
+            const std::map<juce::String, juce::int64>& directoryTimes,
+            const std::map<juce::String, EntryFile>& entries,
+            const std::map<juce::String, juce::StringArray>& categories) const;
+
+private:
+    // The file where desktop entry data is saved:
+    const juce::File cacheFile;
+};
@@ -3,6 +3,7 @@
 #include "DesktopEntry_FileError.h"
 #include "DesktopEntry_FormatError.h"
 #include "DesktopEntry_FileUtils.h"
+#include "DesktopEntry_LineParser.h"
 #include "Assets_XDGDirectories.h"
 #include "Config_MainFile.h"
 #include "Config_MainKeys.h"
@@ -29,16 +30,16 @@ static const juce::String entryDirectory = "/applications/";
  */
 #define STRING_CONVERTER(stringParam, isLocaleString)                        \
 {                                                                            \
-    .readValue = [](DesktopEntry::EntryFile* thisEntry,                     \
+    .readValue = [](Data& entryData,                                         \
         const juce::String& value)                                           \
     {                                                                        \
-        thisEntry->stringParam = DesktopEntry::FileUtils::processStringValue \
-            (value, thisEntry->file, isLocaleString);                        \
+        entryData.stringParam = DesktopEntry::FileUtils::processStringValue  \
+            (value, entryData.file, isLocaleString);                         \
     },                                                                       \
-    .getValue = [](DesktopEntry::EntryFile* thisEntry)->juce::String        \
+    .getValue = [](const Data& entryData)->juce::String                      \
     {                                                                        \
         return DesktopEntry::FileUtils::addEscapeSequences                   \
-            (thisEntry->stringParam);                                        \
+            (entryData.stringParam);                                         \
     }                                                                        \
 }
 
@@ -55,15 +56,15 @@ static const juce::String entryDirectory = "/applications/";
  */
 #define LIST_CONVERTER(listParam, isLocaleString)                             \
 {                                                                             \
-    .readValue = [](DesktopEntry::EntryFile* thisEntry,                      \
+    .readValue = [](Data& entryData,                                          \
         const juce::String& value)                                            \
     {                                                                         \
-        thisEntry->listParam = DesktopEntry::FileUtils::parseList             \
-            (value, thisEntry->file, isLocaleString);                         \
+        entryData.listParam = DesktopEntry::FileUtils::parseList              \
+            (value, entryData.file, isLocaleString);                          \
     },                                                                        \
-    .getValue = [](DesktopEntry::EntryFile* thisEntry)->juce::String         \
+    .getValue = [](const Data& entryData)->juce::String                       \
     {                                                                         \
-        return DesktopEntry::FileUtils::listString(thisEntry->listParam,      \
+        return DesktopEntry::FileUtils::listString(entryData.listParam,       \
             isLocaleString);                                                  \
     }                                                                         \
 }
@@ -78,47 +79,47 @@ static const juce::String entryDirectory = "/applications/";
  */
 #define BOOL_CONVERTER(boolParam)                                             \
 {                                                                             \
-    .readValue = [](DesktopEntry::EntryFile* thisEntry,                      \
+    .readValue = [](Data& entryData,                                          \
             const juce::String& value)                                        \
     {                                                                         \
-        thisEntry->boolParam = DesktopEntry::FileUtils::parseBool             \
-                (value, thisEntry->file);                                     \
+        entryData.boolParam = DesktopEntry::FileUtils::parseBool              \
+                (value, entryData.file);                                      \
     },                                                                        \
-    .getValue = [](DesktopEntry::EntryFile* thisEntry)->juce::String         \
+    .getValue = [](const Data& entryData)->juce::String                       \
     {                                                                         \
-        return DesktopEntry::FileUtils::boolString(thisEntry->boolParam);     \
+        return DesktopEntry::FileUtils::boolString(entryData.boolParam);      \
     }                                                                         \
 }
 
 
 // Stores all data keys defined in the desktop entry specifications,
 // mapped to functions for importing and exporting that key's data.
-const std::map<juce::Identifier, DesktopEntry::EntryFile::DataConverter>
+const std::map<DesktopEntry::DataKey, DesktopEntry::EntryFile::DataConverter>
 DesktopEntry::EntryFile::keyGuide
 {
-    { "Name",             STRING_CONVERTER(name, true)            },
-    { "GenericName",      STRING_CONVERTER(genericName, true)     },
-    { "Comment",          STRING_CONVERTER(comment, true)         },
-    { "Icon",             STRING_CONVERTER(icon, true)            },
-    { "TryExec",          STRING_CONVERTER(tryExec, false)        },
-    { "Path",             STRING_CONVERTER(path, false)           },
-    { "StartupWMClass",   STRING_CONVERTER(startupWMClass, false) },
-    { "URL",              STRING_CONVERTER(url, false)            },
-    { "OnlyShowIn",       LIST_CONVERTER(onlyShowIn, false)       },
-    { "NotShowIn",        LIST_CONVERTER(notShowIn, false)        },
-    { "Actions",          LIST_CONVERTER(actionTypes, false)      },
-    { "MimeType",         LIST_CONVERTER(mimeTypes, false)        },
-    { "Categories",       LIST_CONVERTER(categories, false)       },
-    { "Implements",       LIST_CONVERTER(implements, false)       },
-    { "Keywords",         LIST_CONVERTER(keywords, true)          },
-    { "NoDisplay",        BOOL_CONVERTER(noDisplay)               },
-    { "DBusActivatable",  BOOL_CONVERTER(dBusActivatable)         },
-    { "Terminal",         BOOL_CONVERTER(terminal)                },
-    { "StartupNotify",    BOOL_CONVERTER(startupNotify)           },
-    { "Type",
+    { DataKey::name,            STRING_CONVERTER(name, true)            },
+    { DataKey::genericName,     STRING_CONVERTER(genericName, true)     },
+    { DataKey::comment,         STRING_CONVERTER(comment, true)         },
+    { DataKey::icon,            STRING_CONVERTER(icon, true)            },
+    { DataKey::tryExec,         STRING_CONVERTER(tryExec, false)        },
+    { DataKey::path,            STRING_CONVERTER(path, false)           },
+    { DataKey::startupWMClass,  STRING_CONVERTER(startupWMClass, false) },
+    { DataKey::url,             STRING_CONVERTER(url, false)            },
+    { DataKey::onlyShowIn,      LIST_CONVERTER(onlyShowIn, false)       },
+    { DataKey::notShowIn,       LIST_CONVERTER(notShowIn, false)        },
+    { DataKey::actions,         LIST_CONVERTER(actionTypes, false)      },
+    { DataKey::mimeType,        LIST_CONVERTER(mimeTypes, false)        },
+    { DataKey::categories,      LIST_CONVERTER(categories, false)       },
+    { DataKey::implements,      LIST_CONVERTER(implements, false)       },
+    { DataKey::keywords,        LIST_CONVERTER(keywords, true)          },
+    { DataKey::noDisplay,       BOOL_CONVERTER(noDisplay)               },
+    { DataKey::dBusActivatable, BOOL_CONVERTER(dBusActivatable)         },
+    { DataKey::terminal,        BOOL_CONVERTER(terminal)                },
+    { DataKey::startupNotify,   BOOL_CONVERTER(startupNotify)           },
+    { DataKey::type,
         {
             .readValue = []
-            (DesktopEntry::EntryFile* thisEntry, const juce::String& value)
+            (Data& entryData, const juce::String& value)
             {
                 using namespace juce;
                 const std::map <juce::String, Type> typeMap =
@@ -131,15 +132,15 @@ DesktopEntry::EntryFile::keyGuide
                 {
                     const String errorMessage = String("Invalid entry type ")
                         + value + " encountered";
-                    throw FileError(thisEntry->file,
+                    throw FileError(entryData.file,
                         errorMessage);
                 }
                 return searchIter->second;
             },
             .getValue = []
-            (DesktopEntry::EntryFile* thisEntry)->juce::String
+            (const Data& entryData)->juce::String
             {
-                switch(thisEntry->type)
+                switch(entryData.type)
                 {
                     case Type::application:
                         return "Application";
@@ -151,10 +152,10 @@ DesktopEntry::EntryFile::keyGuide
             }
         }
     },
-    { "Version",
+    { DataKey::version,
         {
             .readValue = []
-            (DesktopEntry::EntryFile* thisEntry, const juce::String& value)
+            (Data& entryData, const juce::String& value)
             {
                 if (value != "1.1")
                 {
@@ -164,48 +165,48 @@ DesktopEntry::EntryFile::keyGuide
                 }
             },
             .getValue = []
-            (DesktopEntry::EntryFile* thisEntry)->juce::String
+            (const Data& entryData)->juce::String
             {
                 return "1.1";
             }
         }
     },
-    { "Hidden",
+    { DataKey::hidden,
         {
             .readValue = []
-            (DesktopEntry::EntryFile* thisEntry, const juce::String& value)
+            (Data& entryData, const juce::String& value)
             {
-                if (DesktopEntry::FileUtils::parseBool(value, thisEntry->file))
+                if (DesktopEntry::FileUtils::parseBool(value, entryData.file))
                 {
                     const juce::String errorMessage
                         ("File marked hidden, should have been deleted");
-                    throw FileError(thisEntry->file, errorMessage);
+                    throw FileError(entryData.file, errorMessage);
                 }
             },
             .getValue = []
-            (DesktopEntry::EntryFile* thisEntry)->juce::String
+            (const Data& entryData)->juce::String
             {
                 return DesktopEntry::FileUtils::boolString(false);
             }
         }
     },
-    { "Exec",
+    { DataKey::exec,
         {
             .readValue = []
-            (DesktopEntry::EntryFile* thisEntry, const juce::String& value)
+            (Data& entryData, const juce::String& value)
             {
                 juce::String execString
                     = DesktopEntry::FileUtils::processStringValue(value,
-                    thisEntry->file, false);
-                thisEntry->exec = DesktopEntry::FileUtils::unquoteCommandFields
+                    entryData.file, false);
+                entryData.exec = DesktopEntry::FileUtils::unquoteCommandFields
                     (execString);
             },
             .getValue = []
-            (DesktopEntry::EntryFile* thisEntry)->juce::String
+            (const Data& entryData)->juce::String
             {
                 juce::String execString
                     = DesktopEntry::FileUtils::addEscapeSequences
-                    (thisEntry->exec);
+                    (entryData.exec);
                 return DesktopEntry::FileUtils::quoteCommandFields(execString);
             }
         }
@@ -215,8 +216,10 @@ DesktopEntry::EntryFile::keyGuide
 // Loads desktop entry data from a .desktop file.
 DesktopEntry::EntryFile::EntryFile
 (const juce::File& sourceFile, const juce::String& desktopFileID) :
-file(sourceFile), desktopFileID(desktopFileID)
+data(new Data())
 {
+    data->file = sourceFile;
+    data->desktopFileID = desktopFileID;
     readEntryFile();
 }
 
@@ -226,7 +229,7 @@ DesktopEntry::EntryFile::EntryFile(
         const juce::String& name,
         const juce::String& desktopFileID,
         const Type type) :
-desktopFileID(desktopFileID)
+data(new Data())
 {
     using juce::String;
     using juce::File;
@@ -262,90 +265,97 @@ desktopFileID(desktopFileID)
                 << " Filename=" << filename);
         throw FormatError(filename);
     }
-    file = File(Assets::XDGDirectories::getUserDataPath() + entryDirectory
+    data->desktopFileID = desktopFileID;
+    data->file = File(Assets::XDGDirectories::getUserDataPath() + entryDirectory
         + filename + ".desktop");
     // Check if the file exists already, and if so, read data from it.
-    if (file.existsAsFile())
+    if (data->file.existsAsFile())
     {
         readEntryFile();
     }
     // Apply name and type, possibly replacing existing file values.
-    this->type = type;
+    getEditableData(DataKey::type).type = type;
     setName(name);
 }
 
 
+// Creates an empty desktop entry object with no data.
+DesktopEntry::EntryFile::EntryFile() : data(getEmptyData()) { }
+
+
 // Checks if the EntryFile does not contain all data required by a valid
 // desktop entry.
 bool DesktopEntry::EntryFile::isMissingData() const
 {
-    return name.isEmpty() || (exec.isEmpty() && !dBusActivatable);
+    return data->name.isEmpty()
+            || (data->exec.isEmpty() && !data->dBusActivatable);
 }
 
 
 // Checks if two desktop entries have the same desktop file ID.
 bool DesktopEntry::EntryFile::operator== (const EntryFile& toCompare) const
 {
-    return desktopFileID == toCompare.desktopFileID;
+    return data->desktopFileID == toCompare.data->desktopFileID;
 }
 
 
 // Alphabetically compares entries based on their names.
 bool DesktopEntry::EntryFile::operator< (const EntryFile& toCompare) const
 {
-    return name.toUpperCase() < toCompare.name.toUpperCase();
+    return data->name.toUpperCase() < toCompare.data->name.toUpperCase();
 }
 
 
 // Gets the desktop entry's type.
 DesktopEntry::EntryFile::Type DesktopEntry::EntryFile::getType() const
 {
-    return type;
+    return data->type;
 }
 
 
 // Gets the unique desktop file ID that identifies this entry.
 juce::String DesktopEntry::EntryFile::getDesktopFileID() const
 {
-    return desktopFileID;
+    return data->desktopFileID;
 }
 
 
 // Gets the desktop entry's name.
 juce::String DesktopEntry::EntryFile::getName() const
 {
-    return name;
+    return data->name;
 }
 
 
 // Gets a generic name describing the entry.
 juce::String DesktopEntry::EntryFile::getGenericName() const
 {
-    return genericName;
+    return data->genericName;
 }
 
 
 // Checks if this desktop entry should appear in application menus.
 bool DesktopEntry::EntryFile::shouldBeDisplayed() const
 {
-    return !noDisplay
-        && (onlyShowIn.isEmpty() || onlyShowIn.contains("pocket-home"))
-        && ! notShowIn.contains("pocket-home");
+    return !data->noDisplay
+        && (data->onlyShowIn.isEmpty()
+            || data->onlyShowIn.contains("pocket-home"))
+        && ! data->notShowIn.contains("pocket-home");
 }
 
 
 // Gets the name or path of the desktop entry's icon.
 juce::String DesktopEntry::EntryFile::getIcon() const
 {
-    return icon;
+    return data->icon;
 }
 
 
 // Gets the command string used to launch this entry's application.
 juce::String DesktopEntry::EntryFile::getLaunchCommand() const
 {
-    juce::String command = exec;
-    if (terminal && command.isNotEmpty())
+    juce::String command = data->exec;
+    if (data->terminal && command.isNotEmpty())
     {
         Config::MainFile config;
         command = config.getTermLaunchPrefix() + " " + command;
@@ -357,7 +367,7 @@ juce::String DesktopEntry::EntryFile::getLaunchCommand() const
 // Gets the string value used to construct the launch command.
 juce::String DesktopEntry::EntryFile::getExec() const
 {
-    return exec;
+    return data->exec;
 }
 
 
@@ -365,14 +375,14 @@ juce::String DesktopEntry::EntryFile::getExec() const
 // application is valid.
 juce::String DesktopEntry::EntryFile::getTryExec() const
 {
-    return tryExec;
+    return data->tryExec;
 }
 
 
 // Gets the path where this application should run.
 juce::String DesktopEntry::EntryFile::getRunDirectory() const
 {
-    return path;
+    return data->path;
 }
 
 
@@ -380,14 +390,14 @@ juce::String DesktopEntry::EntryFile::getRunDirectory() const
 // window.
 bool DesktopEntry::EntryFile::getLaunchedInTerm() const
 {
-    return terminal;
+    return data->terminal;
 }
 
 
 // Gets the names of all alternate actions supported by this desktop entry.
 juce::StringArray DesktopEntry::EntryFile::getActionIDs() const
 {
-    return actionTypes;
+    return data->actionTypes;
 }
 
 
@@ -395,11 +405,11 @@ juce::StringArray DesktopEntry::EntryFile::getActionIDs() const
 juce::String DesktopEntry::EntryFile::getActionTitle
 (const juce::String actionID) const
 {
-    if (actions.count(actionID) == 0)
+    if (data->actions.count(actionID) == 0)
     {
         return juce::String();
     }
-    return actions.at(actionID).title;
+    return data->actions.at(actionID).title;
 }
 
 
@@ -407,11 +417,11 @@ juce::String DesktopEntry::EntryFile::getActionTitle
 juce::String DesktopEntry::EntryFile::getActionIcon
 (const juce::String actionID) const
 {
-    if (actions.count(actionID) == 0)
+    if (data->actions.count(actionID) == 0)
     {
         return juce::String();
     }
-    return actions.at(actionID).icon;
+    return data->actions.at(actionID).icon;
 }
 
 
@@ -419,32 +429,32 @@ juce::String DesktopEntry::EntryFile::getActionIcon
 juce::String DesktopEntry::EntryFile::getActionLaunchCommand
 (const juce::String actionID) const
 {
-    if (actions.count(actionID) == 0)
+    if (data->actions.count(actionID) == 0)
     {
         return juce::String();
     }
-    return expandFieldCodes(actions.at(actionID).exec);
+    return expandFieldCodes(data->actions.at(actionID).exec);
 }
 
 
 // Gets the list of categories associated with this desktop entry.
 juce::StringArray DesktopEntry::EntryFile::getCategories() const
 {
-    return categories;
+    return data->categories;
 }
 
 
 // Gets a list of keywords associated with this desktop entry.
 juce::StringArray DesktopEntry::EntryFile::getKeywords() const
 {
-    return keywords;
+    return data->keywords;
 }
 
 
 // Sets the desktop entry's name.
 void DesktopEntry::EntryFile::setName(const juce::String& newName)
 {
-    name = newName;
+    getEditableData(DataKey::name).name = newName;
 }
 
 
@@ -452,28 +462,28 @@ void DesktopEntry::EntryFile::setName(const juce::String& newName)
 void DesktopEntry::EntryFile::setGenericName
 (const juce::String& newGenericName)
 {
-    genericName = newGenericName;
+    getEditableData(DataKey::genericName).genericName = newGenericName;
 }
 
 
 // Sets if this desktop entry should appear in application menus.
 void DesktopEntry::EntryFile::setIfDisplayed(const bool showEntry)
 {
-    noDisplay = !showEntry;
+    getEditableData(DataKey::noDisplay).noDisplay = !showEntry;
 }
 
 
 // Sets the name or path of the desktop entry's icon.
 void DesktopEntry::EntryFile::setIcon(const juce::String& newIcon)
 {
-    icon = newIcon;
+    getEditableData(DataKey::icon).icon = newIcon;
 }
 
 
 // Sets the string value used to construct the entry's launch command.
 void DesktopEntry::EntryFile::setExec(const juce::String& newExec)
 {
-    exec = newExec;
+    getEditableData(DataKey::exec).exec = newExec;
 }
 
 
@@ -481,7 +491,7 @@ void DesktopEntry::EntryFile::setExec(const juce::String& newExec)
 // valid.
 void DesktopEntry::EntryFile::setTryExec(const juce::String& newTryExec)
 {
-    tryExec = newTryExec;
+    getEditableData(DataKey::tryExec).tryExec = newTryExec;
 }
 
 
@@ -489,14 +499,14 @@ void DesktopEntry::EntryFile::setTryExec(const juce::String& newTryExec)
 void DesktopEntry::EntryFile::setRunDirectory
 (const juce::String& runningDirectory)
 {
-    path = runningDirectory;
+    getEditableData(DataKey::path).path = runningDirectory;
 }
 
 
 // Sets if this entry's application should be launched in a new terminal window.
 void DesktopEntry::EntryFile::setLaunchedInTerm(const bool termLaunch)
 {
-    terminal = termLaunch;
+    getEditableData(DataKey::terminal).terminal = termLaunch;
 }
 
 
@@ -504,216 +514,387 @@ void DesktopEntry::EntryFile::setLaunchedInTerm(const bool termLaunch)
 void DesktopEntry::EntryFile::setCategories
 (const juce::StringArray& newCategories)
 {
-    categories = newCategories;
+    getEditableData(DataKey::categories).categories = newCategories;
 }
 
 
 // Sets the list of keywords associated with this desktop entry.
 void DesktopEntry::EntryFile::setKeywords(const juce::StringArray& newKeywords)
 {
-    keywords = newKeywords;
+    getEditableData(DataKey::keywords).keywords = newKeywords;
 }
 
 
 // Writes this desktop entry to the user's local application data directory.
-void DesktopEntry::EntryFile::writeFile()
+void DesktopEntry::EntryFile::writeFile() const
 {
     using juce::String;
-    String outFileText = "";
-    String locale = Locale::getLocaleName();
-    juce::Array<juce::Identifier> foundKeys;
-    juce::Array<juce::Identifier> foundLocaleKeys;
-
-    // Reload the source file to preserve comments and alternate locale data.
-    juce::StringArray lines;
-    file.readLines(lines);
-    String sectionHeader;
-    for (const String& line : lines)
-    {
-        if (outFileText.isNotEmpty() && line.isNotEmpty())
+    const juce::File outFile(Assets::XDGDirectories::getUserDataPath()
+            + entryDirectory + data->file.getFullPathName()
+            .fromLastOccurrenceOf(entryDirectory, false, false));
+    // Update the user's copy of the entry if one exists. Otherwise, copy the
+    // source file to preserve comments, actions, and alternate locale data.
+    const juce::File baseFile = outFile.existsAsFile() ? outFile : data->file;
+    juce::MemoryBlock fileData;
+    juce::Array<DataKey> keysToWrite;
+    if (baseFile.existsAsFile() && baseFile.loadFileAsData(fileData))
+    {
+        if (data->editedKeys.isEmpty() && baseFile == outFile)
         {
-            outFileText += "\n";
+            return;
         }
-        // Copy comments and empty lines without further processing
-        if (line.startsWithChar('#') || line.isEmpty())
+        keysToWrite = data->editedKeys;
+    }
+    else
+    {
+        for (const auto& keyIter : keyGuide)
         {
-            outFileText += line;
-            continue;
+            keysToWrite.add(keyIter.first);
         }
-        // Find and copy section headers
-        else if (FileUtils::isHeaderLine(line))
+    }
+
+    const String locale = Locale::getLocaleName();
+    const char* localeText = locale.toRawUTF8();
+    const int localeLength = (int) locale.getNumBytesAsUTF8();
+    juce::Array<DataKey> foundKeys;
+    juce::Array<DataKey> foundLocaleKeys;
+    juce::MemoryOutputStream outText;
+    // Adds all keys to write that weren't found in the main data group. This
+    // runs when the main group ends, so keys are never added to action groups.
+    const auto writeMissingKeys = [this, &keysToWrite, &foundKeys,
+         &foundLocaleKeys, &outText]()
+    {
+        for (const DataKey key : keysToWrite)
         {
-            sectionHeader = FileUtils::extractHeader(line);
+            if (foundKeys.contains(key) || foundLocaleKeys.contains(key))
+            {
+                continue;
+            }
+            const String value = getValue(key);
+            if (value.isNotEmpty())
+            {
+                outText << FileUtils::getKeyName(key) << "=" << value << "\n";
+            }
+            foundKeys.add(key);
         }
-        // Parse lines that aren't section headers, empty, or comments if under
-        // the main data header.
-        else if (line.isNotEmpty() && FileUtils::isMainDataHeader(
-                    sectionHeader))
+    };
+
+    LineParser parser(fileData.getData(), fileData.getSize());
+    LineParser::Line line;
+    bool foundMainGroup = false;
+    bool inMainGroup = false;
+    while (parser.nextLine(line))
+    {
+        if (line.type == LineParser::LineType::header)
         {
-            String lineLocale = FileUtils::parseLocale(line);
-            if (lineLocale.isEmpty()  || lineLocale == locale)
+            if (inMainGroup)
             {
-                try
-                {
-                    const juce::Identifier& key = FileUtils::parseKey(line);
-                    if (foundLocaleKeys.contains(key) || (lineLocale.isEmpty()
-                            && foundKeys.contains(key)))
-                    {
-                        DBG(dbgPrefix << __func__
-                                << ": Skipping duplicate key "
-                                << key.toString());
-                    }
-                    else
-                    {
-                        foundKeys.add(key);
-                        outFileText += key.toString();
-                        if (lineLocale.isNotEmpty())
-                        {
-                            foundLocaleKeys.add(key);
-                            outFileText += "[";
-                            outFileText += lineLocale;
-                            outFileText += "]";
-                        }
-                        outFileText += "=";
-                        outFileText += getValue(key);
-                    }
-                    continue;
-                }
-                catch(FormatError e)
-                {
-                    // Non-standard key, just copy the line without further
-                    // processing.
-                    DBG(dbgPrefix << __func__ << ": Copying non-standard line="
-                            << line);
-                }
+                writeMissingKeys();
             }
+            inMainGroup = FileUtils::isMainDataHeader(line.header.toString());
+            foundMainGroup = foundMainGroup || inMainGroup;
         }
-        // If no header has been located, the main header must be added before
-        // any non-comment content.
-        if (sectionHeader.isEmpty())
+        // Replace lines holding keys to write within the main data group,
+        // unless they target a different locale:
+        else if (inMainGroup && line.type == LineParser::LineType::keyValue
+                && keysToWrite.contains(line.key)
+                && (line.locale.isEmpty()
+                    || line.locale.equals(localeText, localeLength)))
         {
-            sectionHeader = FileUtils::getMainHeader();
-            outFileText += sectionHeader + "\n";
+            const bool isLocaleLine = !line.locale.isEmpty();
+            juce::Array<DataKey>& lineKeys = isLocaleLine
+                    ? foundLocaleKeys : foundKeys;
+            if (lineKeys.contains(line.key))
+            {
+                DBG(dbgPrefix << __func__ << ": Skipping duplicate key "
+                        << FileUtils::getKeyName(line.key));
+                continue;
+            }
+            lineKeys.add(line.key);
+            outText << FileUtils::getKeyName(line.key);
+            if (isLocaleLine)
+            {
+                outText << "[" << locale << "]";
+            }
+            outText << "=" << getValue(line.key) << "\n";
+            continue;
         }
-        // Copy field headers, unexpected lines, Actions, nonstandard keys, and
-        // data from other locales unedited.
-        outFileText += line;
+        // Copy all other lines unchanged:
+        outText.write(line.text.start, line.text.length);
+        outText << "\n";
     }
-    // Add the main group header if no header has been found yet.
-    if (sectionHeader.isEmpty())
+    if (!foundMainGroup)
     {
-        outFileText += FileUtils::getMainHeader() + "\n";
+        outText << FileUtils::getMainHeader() << "\n";
+        inMainGroup = true;
     }
-    // Copy keys not found in the original file
-    for (auto keyIter : keyGuide)
+    if (inMainGroup)
     {
-        if (!foundLocaleKeys.contains(keyIter.first)
-                && !foundKeys.contains(keyIter.first))
-        {
-            String value = keyIter.second.getValue(this);
-            if (value.isNotEmpty())
-            {
-                outFileText += String("\n") + keyIter.first + String("=")
-                        + value;
-            }
-        }
+        writeMissingKeys();
+    }
 
+    // Write to a temporary file, then replace the entry file, so that
+    // partially written entry files are never read:
+    if (!outFile.getParentDirectory().createDirectory())
+    {
+        throw FileError(outFile, "Failed to create entry directory.");
     }
-    // Write files to the user data directory:
-    juce::File outFile(Assets::XDGDirectories::getUserDataPath()
-            + entryDirectory + file.getFullPathName().fromLastOccurrenceOf
-            (entryDirectory, false, false));
-    outFile.create();
     DBG(dbgPrefix << __func__ << ": writing file "
             << outFile.getFullPathName());
-    outFile.replaceWithText(outFileText);
+    juce::TemporaryFile tempFile(outFile);
+    {
+        juce::FileOutputStream output(tempFile.getFile());
+        if (output.failedToOpen())
+        {
+            throw FileError(outFile, "Failed to open temporary file.");
+        }
+        output.write(outText.getData(), outText.getDataSize());
+        output.flush();
+        if (output.getStatus().failed())
+        {
+            throw FileError(outFile, "Failed to write temporary file.");
+        }
+    }
+    if (!tempFile.overwriteTargetFileWithTemporary())
+    {
+        throw FileError(outFile, "Failed to replace entry file.");
+    }
+}
+
+
+/**
+ * @brief  Writes a list of strings to a binary data stream.
+ *
+ * @param output  The stream where the list will be written.
+ *
+ * @param list    The list of strings to write.
+ */
+static void writeList(juce::OutputStream& output, const juce::StringArray& list)
+{
+    output.writeInt(list.size());
+    for (const juce::String& listItem : list)
+    {
+        output.writeString(listItem);
+    }
+}
+
+
+/**
+ * @brief  Reads a list of strings from a binary data stream.
+ *
+ * @param input  A stream holding a list saved by writeList.
+ *
+ * @param list   The array where list strings will be added.
+ *
+ * @return       Whether the list's size was valid.
+ */
+static bool readList(juce::InputStream& input, juce::StringArray& list)
+{
+    const int listSize = input.readInt();
+    // Each list string uses at least one byte, so larger sizes can only be
+    // caused by invalid data:
+    if (listSize < 0 || listSize > input.getNumBytesRemaining())
+    {
+        return false;
+    }
+    list.ensureStorageAllocated(listSize);
+    for (int i = 0; i < listSize; i++)
+    {
+        list.add(input.readString());
+    }
+    return true;
+}
+
+
+// Marks the end of each desktop entry written to a data stream, so that
+// truncated entry data is never read:
+static const constexpr int streamEndMarker = 0x50484545; // "PHEE"
+
+// Writes all desktop entry data to a binary data stream.
+void DesktopEntry::EntryFile::writeToStream(juce::OutputStream& output) const
+{
+    output.writeString(data->file.getFullPathName());
+    output.writeString(data->desktopFileID);
+    output.writeInt((int) data->type);
+    output.writeString(data->name);
+    output.writeString(data->genericName);
+    output.writeBool(data->noDisplay);
+    output.writeString(data->comment);
+    output.writeString(data->icon);
+    writeList(output, data->onlyShowIn);
+    writeList(output, data->notShowIn);
+    output.writeBool(data->dBusActivatable);
+    output.writeString(data->tryExec);
+    output.writeString(data->exec);
+    output.writeString(data->path);
+    output.writeBool(data->terminal);
+    writeList(output, data->actionTypes);
+    output.writeInt((int) data->actions.size());
+    for (const auto& actionIter : data->actions)
+    {
+        output.writeString(actionIter.first);
+        output.writeString(actionIter.second.title);
+        output.writeString(actionIter.second.icon);
+        output.writeString(actionIter.second.exec);
+    }
+    writeList(output, data->mimeTypes);
+    writeList(output, data->categories);
+    writeList(output, data->implements);
+    writeList(output, data->keywords);
+    output.writeBool(data->startupNotify);
+    output.writeString(data->startupWMClass);
+    output.writeString(data->url);
+    output.writeInt(streamEndMarker);
+}
+
+
+// Replaces all desktop entry data with data read from a binary data stream.
+bool DesktopEntry::EntryFile::readFromStream(juce::InputStream& input)
+{
+    juce::ReferenceCountedObjectPtr<Data> readData = new Data();
+    const juce::String filePath = input.readString();
+    if (!juce::File::isAbsolutePath(filePath))
+    {
+        return false;
+    }
+    readData->file = juce::File(filePath);
+    readData->desktopFileID = input.readString();
+    const int typeValue = input.readInt();
+    if (typeValue != (int) Type::application && typeValue != (int) Type::link)
+    {
+        return false;
+    }
+    readData->type = (Type) typeValue;
+    readData->name = input.readString();
+    readData->genericName = input.readString();
+    readData->noDisplay = input.readBool();
+    readData->comment = input.readString();
+    readData->icon = input.readString();
+    if (!readList(input, readData->onlyShowIn)
+            || !readList(input, readData->notShowIn))
+    {
+        return false;
+    }
+    readData->dBusActivatable = input.readBool();
+    readData->tryExec = input.readString();
+    readData->exec = input.readString();
+    readData->path = input.readString();
+    readData->terminal = input.readBool();
+    if (!readList(input, readData->actionTypes))
+    {
+        return false;
+    }
+    const int actionCount = input.readInt();
+    if (actionCount < 0 || actionCount > input.getNumBytesRemaining())
+    {
+        return false;
+    }
+    for (int i = 0; i < actionCount; i++)
+    {
+        Action& action = readData->actions[input.readString()];
+        action.title = input.readString();
+        action.icon = input.readString();
+        action.exec = input.readString();
+    }
+    if (!readList(input, readData->mimeTypes)
+            || !readList(input, readData->categories)
+            || !readList(input, readData->implements)
+            || !readList(input, readData->keywords))
+    {
+        return false;
+    }
+    readData->startupNotify = input.readBool();
+    readData->startupWMClass = input.readString();
+    readData->url = input.readString();
+    if (input.readInt() != streamEndMarker)
+    {
+        return false;
+    }
+    data = readData;
+    return true;
 }
 
 
 // Given a standard desktop entry data key, get the value mapped to that key.
-juce::String DesktopEntry::EntryFile::getValue(const juce::Identifier& key)
+juce::String DesktopEntry::EntryFile::getValue(const DataKey key) const
 {
     auto searchIter = keyGuide.find(key);
     if (searchIter == keyGuide.end())
     {
-        throw FormatError(key.toString());
+        throw FormatError(FileUtils::getKeyName(key));
     }
-    return searchIter->second.getValue(this);
+    return searchIter->second.getValue(*data);
 }
 
 
 // Loads all desktop entry data from the desktop entry's file.
 void DesktopEntry::EntryFile::readEntryFile()
 {
-    using juce::StringArray;
     using juce::String;
-    StringArray lines;
-    if (!file.existsAsFile())
+    juce::MemoryBlock fileData;
+    if (!data->file.existsAsFile() || !data->file.loadFileAsData(fileData))
     {
         String errorMessage("File does not exist.");
-        throw FileError(file, errorMessage);
+        throw FileError(data->file, errorMessage);
     }
-    file.readLines(lines);
-    String locale = Locale::getLocaleName();
+    const String locale = Locale::getLocaleName();
+    const char* localeText = locale.toRawUTF8();
+    const int localeLength = (int) locale.getNumBytesAsUTF8();
     // Last group header read:
     String groupHeader;
-    // Action ID, if the current header defines an action:
-    String actionId;
+    // Whether the current group is the main data group:
+    bool inMainGroup = false;
     //If true, the current group is a custom one that should be skipped:
     bool skipCurrentGroup = false;
-    for (const String& line : lines)
+    LineParser parser(fileData.getData(), fileData.getSize());
+    LineParser::Line line;
+    while (parser.nextLine(line))
     {
-        if (line.isEmpty() || line.startsWithChar('#'))
-        {
-            continue; //skip comments and empty lines
-        }
-        else if (FileUtils::isHeaderLine(line))
-        {
-            skipCurrentGroup = false;
-            groupHeader = FileUtils::extractHeader(line);
-            if (FileUtils::isValidActionHeader(groupHeader))
-            {
-                groupHeader = FileUtils::extractActionID(groupHeader);
-            }
-            else if (!FileUtils::isMainDataHeader(groupHeader))
-            {
-                DBG(dbgPrefix << __func__ << ": Ignoring nonstandard group "
-                        << groupHeader);
-                skipCurrentGroup = true;
-            }
-            continue;
-        }
-        if (skipCurrentGroup)
-        {
-            continue;
-        }
-        String lineLocale = FileUtils::parseLocale(line);
-        if (lineLocale.isEmpty() || lineLocale == locale)
+        switch (line.type)
         {
-            try
+            case LineParser::LineType::empty:
+                continue; //skip comments and empty lines
+            case LineParser::LineType::header:
             {
-                const juce::Identifier& key = FileUtils::parseKey(line);
-                String value = FileUtils::parseValue(line);
-                if (FileUtils::isMainDataHeader(groupHeader))
+                skipCurrentGroup = false;
+                groupHeader = line.header.toString();
+                inMainGroup = FileUtils::isMainDataHeader(groupHeader);
+                if (FileUtils::isValidActionHeader(groupHeader))
                 {
-                    saveLineData(key, value);
+                    groupHeader = FileUtils::extractActionID(groupHeader);
                 }
-                else if (groupHeader.isNotEmpty())
+                else if (!inMainGroup)
                 {
-                    saveActionLineData(groupHeader, key, value);
+                    DBG(dbgPrefix << __func__
+                            << ": Ignoring nonstandard group " << groupHeader);
+                    skipCurrentGroup = true;
                 }
+                continue;
             }
-            catch(FormatError e)
-            {
-                if (e.getBadValue() != line)
+            case LineParser::LineType::invalid:
+                if (!skipCurrentGroup)
                 {
-                    continue;
+                    throw FormatError(line.text.toString());
                 }
-                else
-                {
-                    throw e;
-                }
-            }
+                continue;
+            case LineParser::LineType::unknownKey:
+                continue;
+            case LineParser::LineType::keyValue:
+                break;
+        }
+        if (skipCurrentGroup || groupHeader.isEmpty() || (!line.locale.isEmpty()
+                && !line.locale.equals(localeText, localeLength)))
+        {
+            continue;
+        }
+        const String value = line.value.toString();
+        if (inMainGroup)
+        {
+            saveLineData(line.key, value);
+        }
+        else
+        {
+            saveActionLineData(groupHeader, line.key, value);
         }
     }
 }
@@ -721,39 +902,36 @@ void DesktopEntry::EntryFile::readEntryFile()
 
 // Saves data from a desktop entry line to the appropriate EntryFile fields.
 void DesktopEntry::EntryFile::saveLineData
-(const juce::Identifier& key, const juce::String& value)
+(const DataKey key, const juce::String& value)
 {
     auto searchIter = keyGuide.find(key);
     if (searchIter == keyGuide.end())
     {
-        throw FormatError(key.toString());
+        throw FormatError(FileUtils::getKeyName(key));
     }
-    searchIter->second.readValue(this, value);
+    searchIter->second.readValue(getEditableData(), value);
 }
 
 
 // Saves data from a desktop entry line to the most recently created desktop
 // action.
 void DesktopEntry::EntryFile::saveActionLineData(const juce::String actionID,
-        const juce::Identifier& key, const juce::String& value)
+        const DataKey key, const juce::String& value)
 {
-    using juce::StringRef;
-    if (key == StringRef("Name"))
-    {
-        actions[actionID].title = value;
-    }
-    else if (key == StringRef("Icon"))
-    {
-        actions[actionID].icon = value;
-    }
-    else if (key == StringRef("Exec"))
+    switch (key)
     {
-        actions[actionID].exec = value;
-    }
-    else
-    {
-        DBG(dbgPrefix << __func__ << ": Skipping unexpected action data "
-                << key.toString() << " = " << value);
+        case DataKey::name:
+            getEditableData().actions[actionID].title = value;
+            break;
+        case DataKey::icon:
+            getEditableData().actions[actionID].icon = value;
+            break;
+        case DataKey::exec:
+            getEditableData().actions[actionID].exec = value;
+            break;
+        default:
+            DBG(dbgPrefix << __func__ << ": Skipping unexpected action data "
+                    << FileUtils::getKeyName(key) << " = " << value);
     }
 }
 
@@ -793,16 +971,17 @@ juce::String DesktopEntry::EntryFile::expandFieldCodes
             case 'U':
                 break;
             case 'i':
-                if (icon.isNotEmpty())
+                if (data->icon.isNotEmpty())
                 {
-                    replacementValue = String("\"--icon ") + icon + "\"";
+                    replacementValue = String("\"--icon ") + data->icon
+                            + "\"";
                 }
                 break;
             case 'c':
-                replacementValue = name;
+                replacementValue = data->name;
                 break;
             case 'k':
-                replacementValue = file.getFileName();
+                replacementValue = data->file.getFileName();
                 break;
             case '%':
                 replacementValue = "%";
@@ -818,3 +997,34 @@ juce::String DesktopEntry::EntryFile::expandFieldCodes
     }
     return expanded;
 }
+
+
+// Gets the entry's data so that it may be changed, first copying it if it is
+// shared with any other EntryFile.
+DesktopEntry::EntryFile::Data& DesktopEntry::EntryFile::getEditableData()
+{
+    if (data->getReferenceCount() > 1)
+    {
+        data = new Data(*data);
+    }
+    return *data;
+}
+
+
+// Gets the entry's data so that a key's value may be changed, and adds the key
+// to the entry's journal of edited keys.
+DesktopEntry::EntryFile::Data& DesktopEntry::EntryFile::getEditableData
+(const DataKey editedKey)
+{
+    Data& editableData = getEditableData();
+    editableData.editedKeys.addIfNotAlreadyThere(editedKey);
+    return editableData;
+}
+
+
+// Gets the data object shared by all empty EntryFile objects.
+DesktopEntry::EntryFile::Data* DesktopEntry::EntryFile::getEmptyData()
+{
+    static const juce::ReferenceCountedObjectPtr<Data> emptyData = new Data();
+    return emptyData.get();
+}
@@ -5,6 +5,7 @@
  * @brief  Reads and writes standardized .desktop application shortcut files.
  */
 
+#include "DesktopEntry_DataKey.h"
 #include "JuceHeader.h"
 #include <map>
 
@@ -25,6 +26,11 @@ namespace DesktopEntry { class EntryFile; }
  *
  *  Although .directory files are part of the desktop entry standard, they are
  * not relevant to this module and will be ignored.
+ *
+ *  EntryFile objects are lightweight handles to reference counted entry data.
+ * Copying an EntryFile only shares its data, and the data is only copied when
+ * a shared entry is edited. This lets the LoadingThread and the application
+ * menu hold the same entry data without making deep copies.
  */
 class DesktopEntry::EntryFile
 {
@@ -67,7 +73,7 @@ public:
     /**
      * @brief  Creates an empty desktop entry object with no data.
      */
-    EntryFile() { }
+    EntryFile();
 
     virtual ~EntryFile() { }
 
@@ -337,27 +343,65 @@ public:
      * @brief  Writes this desktop entry to the user's local application data
      *         directory.
      *
-     * @throws FileError  If necessary field values were not defined, or the
-     *                    file could not be written for any other reason.
+     *  Each EntryFile keeps a journal of all data keys changed through its
+     * setter functions. If the user's data directory already holds a copy of
+     * the entry, or the entry was loaded from a file in another directory,
+     * only lines holding journaled keys are replaced, and all other lines are
+     * copied without changes. New entries write every key that has a value.
+     *
+     *  The file is written to a temporary file first, then renamed to replace
+     * the old file, so a partially written entry file is never read.
+     *
+     *  Writing files may be slow, so the application menu saves edited
+     * entries through the DesktopEntry::Loader, which writes them on a
+     * background thread.
+     *
+     * @throws FileError  If the file could not be written.
+     */
+    void writeFile() const;
+
+    /**
+     * @brief  Writes all desktop entry data to a binary data stream, so that
+     *         the entry may be restored without reading its source file.
+     *
+     * @param output  The stream where entry data will be written.
+     */
+    void writeToStream(juce::OutputStream& output) const;
+
+    /**
+     * @brief  Replaces all desktop entry data with data read from a binary
+     *         data stream.
+     *
+     * @param input  A stream holding entry data saved by writeToStream.
+     *
+     * @return       Whether complete entry data was read from the stream. If
+     *               this returns false, the entry's data is left unchanged.
      */
-    void writeFile();
+    bool readFromStream(juce::InputStream& input);
 
 private:
     /**
      * @brief  Given a standard desktop entry data key, get the value mapped to
      *         that key.
      *
-     * @param key  A key string defined in the Desktop Entry specifications.
+     * @param key  A key defined in the Desktop Entry specifications.
      *
      * @return     The corresponding value, encoded as a String that may be
      *             written to a desktop entry file.
      */
-    juce::String getValue(const juce::Identifier& key);
+    juce::String getValue(const DataKey key) const;
 
     /**
      * @brief  Loads all desktop entry data from the desktop entry's file.
      *
-     * @throws FileError  If the file doesn't exist or contains invalid data.
+     *  The file is read into memory once, and parsed in a single pass using a
+     * LineParser. Lines targeting other locales and lines with nonstandard
+     * keys are skipped without copying any of their data.
+     *
+     * @throws FileError    If the file doesn't exist or contains invalid data.
+     *
+     * @throws FormatError  If the file contains a line that isn't a comment,
+     *                      group header, or key/value pair.
      */
     void readEntryFile();
 
@@ -371,7 +415,7 @@ private:
      *
      * @throws FileError  If the key or value were invalid.
      */
-    void saveLineData(const juce::Identifier& key, const juce::String& value);
+    void saveLineData(const DataKey key, const juce::String& value);
 
     /**
      * @brief  Saves data from a desktop entry line to the most recently
@@ -383,8 +427,8 @@ private:
      *
      * @param value     The value read from the desktop entry line.
      */
-    void saveActionLineData(const juce::String actionID,
-            const juce::Identifier& key, const juce::String& value);
+    void saveActionLineData(const juce::String actionID, const DataKey key,
+            const juce::String& value);
 
     /**
      * @brief  Expands all field codes in a command string, removing them and
@@ -398,109 +442,150 @@ private:
      */
     juce::String expandFieldCodes(const juce::String& execString) const;
 
+    // An alternate action the entry can perform:
+    struct Action
+    {
+        // The action's title:
+        juce::String title;
+        // The action's icon name or path:
+        juce::String icon;
+        // The command to execute the action:
+        juce::String exec;
+    };
+
     /**
-     * @brief  For a single data key, stores how to read that key's EntryFile
-     *         data from a .desktop file, and how to convert that EntryFile
-     *         data back into .desktop file data.
+     * @brief  Holds all desktop entry data. Copied EntryFile objects share the
+     *         same Data object until one of the copies is edited.
      */
-    struct DataConverter
+    struct Data : public juce::ReferenceCountedObject
     {
-        // Stores a desktop entry file value in an EntryFile
-        const std::function<void(EntryFile*, const juce::String&)> readValue;
-        // Reads a desktop entry value from an EntryFile
-        const std::function<juce::String(EntryFile*)> getValue;
-    };
+        // The source .desktop file:
+        juce::File file;
 
-    // Stores all data keys defined in the desktop entry specifications,
-    // mapped to functions for importing and exporting that key's data.
-    static const std::map<juce::Identifier, DataConverter> keyGuide;
+        // The desktop entry's desktop file ID:
+        juce::String desktopFileID;
+
+        // The desktop entry's type:
+        Type type = Type::application;
+
+        // Specific name of the entry's application:
+        juce::String name;
 
-    // The source .desktop file:
-    juce::File file;
+        // Generic name of the entry's application:
+        juce::String genericName;
 
-    // The desktop entry's desktop file ID:
-    juce::String desktopFileID;
+        // Sets if the entry should appear in menus:
+        bool noDisplay = false;
 
-    // The desktop entry's type:
-    Type type = Type::application;
+        // Tooltip describing the entry:
+        juce::String comment;
 
-    // Specific name of the entry's application:
-    juce::String name;
+        // The entry icon's name or path:
+        juce::String icon;
 
-    // Generic name of the entry's application:
-    juce::String genericName;
+        // If not empty, defines the only desktop environments that should show
+        // the entry.
+        juce::StringArray onlyShowIn;
 
-    // Sets if the entry should appear in menus:
-    bool noDisplay = false;
+        // The list of desktop environments where the entry should not appear:
+        juce::StringArray notShowIn;
 
-    // Tooltip describing the entry:
-    juce::String comment;
+        // Sets if this entry is an application that should be activated over
+        // D-Bus.
+        bool dBusActivatable = false;
 
-    // The entry icon's name or path:
-    juce::String icon;
+        // Path to an executable file on disk used to determine if the program
+        // is actually installed:
+        juce::String tryExec;
 
-    // If not empty, defines the only desktop environments that should show the
-    // entry.
-    juce::StringArray onlyShowIn;
+        // Program to execute, possibly with arguments:
+        juce::String exec;
 
-    // The list of desktop environments where the entry should not appear:
-    juce::StringArray notShowIn;
+        // If the entry is an application, the working directory where the
+        // program should run:
+        juce::String path;
 
-    // Sets if this entry is an application that should be activated over
-    // D-Bus.
-    bool dBusActivatable = false;
+        // Whether this entry's program runs in a terminal window:
+        bool terminal = false;
 
-    // Path to an executable file on disk used to determine if the program is
-    // actually installed:
-    juce::String tryExec;
+        // Names identifying application actions:
+        juce::StringArray actionTypes;
 
-    // Program to execute, possibly with arguments:
-    juce::String exec;
+        // Maps Action ID strings to Action data.
+        std::map<juce::String, Action> actions;
 
-    // If the entry is an application, the working directory where the program
-    // should run:
-    juce::String path;
+        // MIME types supported by this entry's application:.
+        juce::StringArray mimeTypes;
 
-    // Whether this entry's program runs in a terminal window:
-    bool terminal = false;
+        // Categories in which this entry should be shown:
+        juce::StringArray categories;
 
-    // An alternate action the entry can perform:
-    struct Action
-    {
-        // The action's title:
-        juce::String title;
-        // The action's icon name or path:
-        juce::String icon;
-        // The command to execute the action:
-        juce::String exec;
-    };
+        // A list of interfaces that this entry's application implements:
+        juce::StringArray implements;
 
-    // Names identifying application actions:
-    juce::StringArray actionTypes;
+        // A list of strings describing the entry:
+        juce::StringArray keywords;
 
-    // Maps Action ID strings to Action data.
-    std::map<juce::String, Action> actions;
+        // Whether the entry's application is known to support startup
+        // notifications:
+        bool startupNotify = false;
 
-    // MIME types supported by this entry's application:.
-    juce::StringArray mimeTypes;
+        // If specified, it is known that the entry's application will map to
+        // a window with this string as its WM class or name hint.
+        juce::String startupWMClass;
 
-    // Categories in which this entry should be shown:
-    juce::StringArray categories;
+        // The URL used if this entry is a link:
+        juce::String url;
 
-    // A list of interfaces that this entry's application implements:
-    juce::StringArray implements;
+        // All keys with values changed since the entry was loaded:
+        juce::Array<DataKey> editedKeys;
+    };
 
-    // A list of strings describing the entry:
-    juce::StringArray keywords;
+    /**
+     * @brief  For a single data key, stores how to read that key's EntryFile
+     *         data from a .desktop file, and how to convert that EntryFile
+     *         data back into .desktop file data.
+     */
+    struct DataConverter
+    {
+        // Stores a desktop entry file value in EntryFile data
+        const std::function<void(Data&, const juce::String&)> readValue;
+        // Reads a desktop entry value from EntryFile data
+        const std::function<juce::String(const Data&)> getValue;
+    };
 
-    // Whether the entry's application is known to support startup
-    // notifications:
-    bool startupNotify;
+    // Stores all data keys defined in the desktop entry specifications,
+    // mapped to functions for importing and exporting that key's data.
+    static const std::map<DataKey, DataConverter> keyGuide;
+
+    /**
+     * @brief  Gets the entry's data so that it may be changed. If the data is
+     *         shared with any other EntryFile, it is copied first so that other
+     *         EntryFile objects are never affected.
+     *
+     * @return  Entry data that is not shared with any other EntryFile.
+     */
+    Data& getEditableData();
 
-    // If specified, it is known that the entry's application will map to a
-    // window with this string as its WM class or name hint.
-    juce::String startupWMClass;
+    /**
+     * @brief  Gets the entry's data so that a key's value may be changed, and
+     *         adds the key to the entry's journal of edited keys.
+     *
+     * @param editedKey  The key whose value will be changed.
+     *
+     * @return           Entry data that is not shared with any other EntryFile.
+     */
+    Data& getEditableData(const DataKey editedKey);
+
+    /**
+     * @brief  Gets the data object shared by all empty EntryFile objects, so
+     *         that creating empty entries doesn't allocate any memory.
+     *
+     * @return  The shared empty entry data.
+     */
+    static Data* getEmptyData();
 
-    // The URL used if this entry is a link:
-    juce::String url;
+    // The entry's data, shared with all copies of this EntryFile. Shared data
+    // is never changed.
+    juce::ReferenceCountedObjectPtr<Data> data;
 };
@@ -0,0 +1,99 @@
+#define DESKTOP_ENTRY_IMPLEMENTATION
+#include "DesktopEntry_EntryWatcher.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "DesktopEntry::EntryWatcher::";
+#endif
+
+// Watcher thread name:
+static const constexpr char* threadName = "DesktopEntry_EntryWatcher";
+
+// Milliseconds to wait for the woken watcher thread to exit:
+static const constexpr int threadExitMilliseconds = 1000;
+
+// Creates an EntryWatcher that isn't watching any directories.
+DesktopEntry::EntryWatcher::EntryWatcher
+(const std::function<void()> onChange) :
+juce::Thread(threadName),
+onChange(onChange) { }
+
+
+// Stops the watcher thread before destruction.
+DesktopEntry::EntryWatcher::~EntryWatcher()
+{
+    signalThreadShouldExit();
+    fileWatcher.wake();
+    stopThread(threadExitMilliseconds);
+}
+
+
+// Replaces the set of watched directories, starting the watcher thread if
+// necessary.
+void DesktopEntry::EntryWatcher::watchDirectories
+(const juce::StringArray& dirPaths)
+{
+    {
+        const juce::ScopedLock changeLock(changeGuard);
+        fileWatcher.removeAllDirectories();
+        for (const juce::String& dirPath : dirPaths)
+        {
+            if (!fileWatcher.addDirectory(dirPath))
+            {
+                DBG(dbgPrefix << __func__ << ": Failed to watch " << dirPath);
+            }
+        }
+    }
+    if (fileWatcher.isValid() && !isThreadRunning())
+    {
+        startThread();
+    }
+}
+
+
+// Checks if changes were found that haven't been taken yet.
+bool DesktopEntry::EntryWatcher::hasChanges() const
+{
+    const juce::ScopedLock changeLock(changeGuard);
+    return changesLost || !changedPaths.isEmpty();
+}
+
+
+// Gets and clears all changes found since the last time changes were taken.
+bool DesktopEntry::EntryWatcher::takeChanges(juce::StringArray& changedPaths)
+{
+    const juce::ScopedLock changeLock(changeGuard);
+    changedPaths.addArray(this->changedPaths);
+    this->changedPaths.clear();
+    const bool changesTracked = !changesLost && isThreadRunning();
+    changesLost = false;
+    return changesTracked;
+}
+
+
+// Waits for and collects changes until the thread is told to exit.
+void DesktopEntry::EntryWatcher::run()
+{
+    while (!threadShouldExit())
+    {
+        // Sleep until files change, or until the destructor wakes the thread
+        // to exit:
+        fileWatcher.waitForChanges();
+        if (threadShouldExit())
+        {
+            return;
+        }
+        {
+            const juce::ScopedLock changeLock(changeGuard);
+            if (!fileWatcher.readChanges(changedPaths))
+            {
+                changesLost = true;
+            }
+            if (changedPaths.isEmpty() && !changesLost)
+            {
+                continue;
+            }
+        }
+        onChange();
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef DESKTOP_ENTRY_IMPLEMENTATION
+    #error File included directly outside of DesktopEntry implementation.
+#endif
+#pragma once
+/**
+ * @file  DesktopEntry_EntryWatcher.h
+ *
+ * @brief  Detects changes to desktop entry directories as soon as they occur.
+ */
+
+#include "Util_FileWatcher.h"
+#include "JuceHeader.h"
+#include <functional>
+
+namespace DesktopEntry { class EntryWatcher; }
+
+/**
+ * @brief  Runs a thread that waits for files to change within desktop entry
+ *         directories, collecting the paths of all changed files and running a
+ *         callback function whenever changes occur.
+ *
+ *  The LoadingThread uses the EntryWatcher to wake itself when desktop entry
+ * files are added, changed, or removed, and to update only the entries with
+ * changed files instead of scanning all desktop entry directories.
+ *
+ *  The watcher thread blocks until inotify reports changes, and never wakes
+ * up just to poll. The destructor wakes it through the FileWatcher when the
+ * thread needs to exit.
+ *
+ *  The callback function runs on the EntryWatcher's thread. All other
+ * EntryWatcher functions may be called from any thread.
+ */
+class DesktopEntry::EntryWatcher : private juce::Thread
+{
+public:
+    /**
+     * @brief  Creates an EntryWatcher that isn't watching any directories.
+     *
+     * @param onChange  A function to call each time new changes are found.
+     */
+    EntryWatcher(const std::function<void()> onChange);
+
+    /**
+     * @brief  Stops the watcher thread before destruction.
+     */
+    virtual ~EntryWatcher();
+
+    /**
+     * @brief  Replaces the set of watched directories, starting the watcher
+     *         thread if necessary.
+     *
+     * @param dirPaths  The full paths of all directories to watch.
+     */
+    void watchDirectories(const juce::StringArray& dirPaths);
+
+    /**
+     * @brief  Checks if changes were found that haven't been taken yet.
+     *
+     * @return  Whether the next takeChanges call will provide changes, or
+     *          report that changes were lost.
+     */
+    bool hasChanges() const;
+
+    /**
+     * @brief  Gets and clears all changes found since the last time changes
+     *         were taken.
+     *
+     * @param changedPaths  An array where the full paths of all changed files
+     *                      and directories will be added.
+     *
+     * @return              False if directories aren't being watched, or some
+     *                      changes were lost, meaning that any desktop entry
+     *                      file could have changed. Otherwise, true.
+     */
+    bool takeChanges(juce::StringArray& changedPaths);
+
+private:
+    /**
+     * @brief  Waits for and collects changes until the thread is told to exit.
+     */
+    virtual void run() override;
+
+    // Function to call when changes are found:
+    const std::function<void()> onChange;
+
+    // Tracks changes within watched directories:
+    Util::FileWatcher fileWatcher;
+
+    // Guards access to the fileWatcher and all change data. The watcher
+    // thread doesn't hold this while waiting for changes:
+    juce::CriticalSection changeGuard;
+
+    // Paths of all changed files that haven't been taken yet:
+    juce::StringArray changedPaths;
+
+    // Tracks if changes were lost since changes were last taken:
+    bool changesLost = false;
+
+    JUCE_DECLARE_NON_COPYABLE(EntryWatcher);
+};
@@ -0,0 +1,112 @@
+#define DESKTOP_ENTRY_IMPLEMENTATION
+#include "DesktopEntry_EntryWriter.h"
+#include "DesktopEntry_FileError.h"
+#include "DesktopEntry_FormatError.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "DesktopEntry::EntryWriter::";
+#endif
+
+// Writer thread name:
+static const constexpr char* threadName = "DesktopEntry_EntryWriter";
+
+// Milliseconds to wait after an entry is saved before writing entry files, so
+// that quick edits are written together:
+static const constexpr juce::uint32 writeDelayMilliseconds = 500;
+
+// Milliseconds to wait for the thread to exit before forcing it to stop:
+static const constexpr int threadExitMilliseconds = 2000;
+
+// Creates an EntryWriter without any entries to write.
+DesktopEntry::EntryWriter::EntryWriter(const std::function<void()> onWrite) :
+juce::Thread(threadName),
+onWrite(onWrite) { }
+
+
+// Stops the writer thread, then writes any remaining entries before
+// destruction.
+DesktopEntry::EntryWriter::~EntryWriter()
+{
+    stopThread(threadExitMilliseconds);
+    writePendingEntries();
+}
+
+
+// Schedules an entry to be written, starting the writer thread if necessary.
+void DesktopEntry::EntryWriter::saveEntry(const EntryFile& entry)
+{
+    {
+        const juce::ScopedLock entryLock(entryGuard);
+        pendingEntries[entry.getDesktopFileID()] = entry;
+        lastSaveTime = juce::Time::getMillisecondCounter();
+    }
+    if (isThreadRunning())
+    {
+        notify();
+    }
+    else
+    {
+        startThread();
+    }
+}
+
+
+// Writes pending entries whenever new entries are saved, until the thread is
+// told to exit.
+void DesktopEntry::EntryWriter::run()
+{
+    while (!threadShouldExit())
+    {
+        // Wait until no entries were saved for the full write delay:
+        int waitTime = -1;
+        {
+            const juce::ScopedLock entryLock(entryGuard);
+            if (!pendingEntries.empty())
+            {
+                const juce::uint32 sinceSave
+                        = juce::Time::getMillisecondCounter() - lastSaveTime;
+                waitTime = (sinceSave < writeDelayMilliseconds)
+                        ? (int) (writeDelayMilliseconds - sinceSave) : 0;
+            }
+        }
+        if (waitTime != 0)
+        {
+            wait(waitTime);
+            continue;
+        }
+        if (writePendingEntries())
+        {
+            onWrite();
+        }
+    }
+}
+
+
+// Writes and clears all pending entries.
+bool DesktopEntry::EntryWriter::writePendingEntries()
+{
+    std::map<juce::String, EntryFile> toWrite;
+    {
+        const juce::ScopedLock entryLock(entryGuard);
+        toWrite.swap(pendingEntries);
+    }
+    for (const auto& entryIter : toWrite)
+    {
+        try
+        {
+            entryIter.second.writeFile();
+        }
+        catch(FileError e)
+        {
+            DBG(dbgPrefix << __func__ << ": Failed to write "
+                    << entryIter.first << ": " << e.what());
+        }
+        catch(FormatError e)
+        {
+            DBG(dbgPrefix << __func__ << ": Failed to write "
+                    << entryIter.first << ": " << e.what());
+        }
+    }
+    return !toWrite.empty();
+}
@@ -0,0 +1,86 @@
+#ifndef DESKTOP_ENTRY_IMPLEMENTATION
+    #error File included directly outside of DesktopEntry implementation.
+#endif
+#pragma once
+/**
+ * @file  DesktopEntry_EntryWriter.h
+ *
+ * @brief  Writes edited desktop entry files on a background thread.
+ */
+
+#include "DesktopEntry_EntryFile.h"
+#include "JuceHeader.h"
+#include <functional>
+#include <map>
+
+namespace DesktopEntry { class EntryWriter; }
+
+/**
+ * @brief  Runs a thread that writes edited desktop entries to the user's
+ *         application data directory.
+ *
+ *  Entries are not written as soon as they are saved. Instead, the EntryWriter
+ * waits until no entries have been saved for a short delay, so that several
+ * quick edits to the same entry are written to its file only once. Each saved
+ * entry replaces any pending version of the same entry, and EntryFile edit
+ * journals are never cleared, so the newest version of an entry always holds
+ * every edit made to earlier versions.
+ *
+ *  The LoadingThread owns the EntryWriter, and uses it to save entries edited
+ * through the DesktopEntry::Loader. The callback function runs on the
+ * EntryWriter's thread after pending entries are written. All other
+ * EntryWriter functions may be called from any thread.
+ */
+class DesktopEntry::EntryWriter : private juce::Thread
+{
+public:
+    /**
+     * @brief  Creates an EntryWriter without any entries to write.
+     *
+     * @param onWrite  A function to call each time pending entries are
+     *                 written.
+     */
+    EntryWriter(const std::function<void()> onWrite);
+
+    /**
+     * @brief  Stops the writer thread, then writes any remaining entries
+     *         before destruction.
+     */
+    virtual ~EntryWriter();
+
+    /**
+     * @brief  Schedules an entry to be written, starting the writer thread if
+     *         necessary.
+     *
+     * @param entry  An edited desktop entry to write to its file.
+     */
+    void saveEntry(const EntryFile& entry);
+
+private:
+    /**
+     * @brief  Writes pending entries whenever new entries are saved, until
+     *         the thread is told to exit.
+     */
+    virtual void run() override;
+
+    /**
+     * @brief  Writes and clears all pending entries.
+     *
+     * @return  Whether any entries were written.
+     */
+    bool writePendingEntries();
+
+    // Function to call after entries are written:
+    const std::function<void()> onWrite;
+
+    // Guards access to all pending entry data:
+    juce::CriticalSection entryGuard;
+
+    // Maps desktop file IDs to entries waiting to be written:
+    std::map<juce::String, EntryFile> pendingEntries;
+
+    // Time in milliseconds when an entry was last saved:
+    juce::uint32 lastSaveTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(EntryWriter);
+};
@@ -3,7 +3,7 @@
 #include "DesktopEntry_FormatError.h"
 #include "DesktopEntry_FileError.h"
 #include <map>
-#include <set>
+#include <cstring>
 
 // Group header identifying the main section of desktop entry data.
 static const juce::Identifier mainGroupHeader("Desktop Entry");
@@ -17,80 +17,149 @@ static const juce::String charsToEscape("\"`$\\");
 // Characters that must be enclosed in double quotes
 static const juce::String reservedChars(" \t\n\"'\\><~|&;$*?#()`");
 
-// Extracts the locale string from a line read from a desktop entry file.
-juce::String DesktopEntry::FileUtils::parseLocale(const juce::String& line)
+// Names of all standard data keys, in DataKey order:
+static const constexpr char* keyNames[] =
 {
-    using namespace juce;
-    int openIndex = line.indexOfChar('[');
-    if (openIndex > 0)
+    "Type",
+    "Version",
+    "Name",
+    "GenericName",
+    "NoDisplay",
+    "Comment",
+    "Icon",
+    "Hidden",
+    "OnlyShowIn",
+    "NotShowIn",
+    "DBusActivatable",
+    "TryExec",
+    "Exec",
+    "Path",
+    "Terminal",
+    "Actions",
+    "MimeType",
+    "Categories",
+    "Implements",
+    "Keywords",
+    "StartupNotify",
+    "StartupWMClass",
+    "URL"
+};
+
+// Number of standard data keys:
+static const constexpr int keyCount = (int) DesktopEntry::DataKey::unknown;
+static_assert(sizeof(keyNames) / sizeof(keyNames[0]) == keyCount,
+        "Desktop entry key names don't match the DataKey enum.");
+
+// Number of slots in the key hash table:
+static const constexpr int keyTableSize = 64;
+
+/**
+ * @brief  Calculates the key hash table slot for a key string.
+ *
+ *  The hash uses only the first and last characters of the key, which is
+ * enough to give every standard key a unique table slot.
+ *
+ * @param keyText    The first character of a non-empty key string.
+ *
+ * @param keyLength  The number of bytes in the key string.
+ *
+ * @return           The key's table slot.
+ */
+static constexpr int keyHash(const char* keyText, const int keyLength)
+{
+    return ((unsigned char) keyText[0]
+            + 4 * (unsigned char) keyText[keyLength - 1]) % keyTableSize;
+}
+
+/**
+ * @brief  Gets the length of a null-terminated string at compile time.
+ *
+ * @param text  A null-terminated string.
+ *
+ * @return      The number of characters before the null terminator.
+ */
+static constexpr int constLength(const char* text)
+{
+    int length = 0;
+    while (text[length] != '\0')
     {
-        int closeIndex = line.indexOfChar(']');
-        if (closeIndex > openIndex)
+        length++;
+    }
+    return length;
+}
+
+/**
+ * @brief  Maps hash table slots to the index of the key stored in that slot,
+ *         or -1 for empty slots.
+ */
+struct KeyTable
+{
+    int keyIndices[keyTableSize];
+    // Tracks if any keys share a table slot:
+    bool hasCollisions;
+};
+
+/**
+ * @brief  Builds the key hash table at compile time.
+ *
+ * @return  The complete key table.
+ */
+static constexpr KeyTable buildKeyTable()
+{
+    KeyTable table = {{}, false};
+    for (int i = 0; i < keyTableSize; i++)
+    {
+        table.keyIndices[i] = -1;
+    }
+    for (int i = 0; i < keyCount; i++)
+    {
+        const int slot = keyHash(keyNames[i], constLength(keyNames[i]));
+        if (table.keyIndices[slot] != -1)
         {
-            return line.substring(openIndex+1, closeIndex);
+            table.hasCollisions = true;
         }
+        table.keyIndices[slot] = i;
     }
-    return String();
+    return table;
 }
 
+// The hash table used to find standard data keys:
+static const constexpr KeyTable keyTable = buildKeyTable();
+static_assert(!keyTable.hasCollisions,
+        "Desktop entry key hash is no longer a perfect hash, update keyHash.");
 
-// Extracts the data key from a line read from a desktop entry file.
-const juce::Identifier& DesktopEntry::FileUtils::parseKey
-(const juce::String& line)
+// Finds the standard data key matching a key string read from a desktop entry
+// file.
+DesktopEntry::DataKey DesktopEntry::FileUtils::findDataKey
+(const char* keyText, const int keyLength)
 {
-    using juce::Identifier;
-    using juce::String;
-    static const std::set<Identifier> keyList =
+    if (keyLength <= 0)
     {
-        "Type",
-        "Version",
-        "Name",
-        "GenericName",
-        "NoDisplay",
-        "Comment",
-        "Icon",
-        "Hidden",
-        "OnlyShowIn",
-        "NotShowIn",
-        "DBusActivatable",
-        "TryExec",
-        "Exec",
-        "Path",
-        "Terminal",
-        "Actions",
-        "MimeType",
-        "Categories",
-        "Implements",
-        "Keywords",
-        "StartupNotify",
-        "StartupWMClass",
-        "URL"
-    };
-
-    if (!line.containsChar('='))
+        return DataKey::unknown;
+    }
+    const int keyIndex = keyTable.keyIndices[keyHash(keyText, keyLength)];
+    if (keyIndex < 0)
     {
-        throw FormatError(line);
+        return DataKey::unknown;
     }
-    String keyStr = line.initialSectionNotContaining("[=").trim();
-    for (const Identifier& key : keyList)
+    const char* keyName = keyNames[keyIndex];
+    if (strncmp(keyName, keyText, keyLength) != 0
+            || keyName[keyLength] != '\0')
     {
-        if (key == juce::StringRef(keyStr))
-        {
-            return key;
-        }
+        return DataKey::unknown;
     }
-    throw FormatError(keyStr);
+    return (DataKey) keyIndex;
 }
 
 
-// Extracts the data value from a line read from a desktop entry file.
-juce::String DesktopEntry::FileUtils::parseValue(const juce::String& line)
+// Gets the string used to write a data key to desktop entry files.
+const char* DesktopEntry::FileUtils::getKeyName(const DataKey key)
 {
-    if (!line.containsChar('='))
+    if (key == DataKey::unknown)
     {
-        throw FormatError(line);
+        return "";
     }
-    return line.fromLastOccurrenceOf("=", false, false);
+    return keyNames[(int) key];
 }
 
 
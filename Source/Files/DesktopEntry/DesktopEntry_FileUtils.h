@@ -8,6 +8,7 @@
  * @brief  Helps DesktopEntry validate, process, and create desktop entry data.
  */
 
+#include "DesktopEntry_DataKey.h"
 #include "JuceHeader.h"
 
 namespace DesktopEntry
@@ -15,41 +16,32 @@ namespace DesktopEntry
     namespace FileUtils
     {
         /**
-         * @brief  Extracts the locale string from a line read from a desktop
-         *         entry file.
-         *
-         * @param line  A desktop entry line that may target a specific locale.
+         * @brief  Finds the standard data key matching a key string read from
+         *         a desktop entry file.
          *
-         * @return      The extracted locale string, or the empty string if the
-         *              line does not target a specific locale.
-         */
-        juce::String parseLocale(const juce::String& line);
-
-        /**
-         * @brief  Extracts the data key from a line read from a desktop entry
-         *         file.
+         *  Keys are found using a perfect hash table built at compile time, so
+         * finding keys never allocates memory or throws exceptions.
          *
-         * @param line          A line from a desktop entry containing a
-         *                      key/value pair.
+         * @param keyText    The first character of the key string. The key
+         *                   string does not need to be null-terminated.
          *
-         * @throws FormatError  If the line does not contain a valid key.
+         * @param keyLength  The number of bytes in the key string.
          *
-         * @return              The extracted key string.
+         * @return           The matching key, or DataKey::unknown if the key
+         *                   string isn't a standard desktop entry key.
          */
-        const juce::Identifier& parseKey(const juce::String& line);
+        DataKey findDataKey(const char* keyText, const int keyLength);
 
         /**
-         * @brief  Extracts the data value from a line read from a desktop
-         *         entry file.
-         *
-         * @param line          A line from a desktop entry containing a
-         *                      key/value pair.
+         * @brief  Gets the string used to write a data key to desktop entry
+         *         files.
          *
-         * @throws FormatError  If the line does not contain a valid value.
+         * @param key  A standard desktop entry data key.
          *
-         * @return              The extracted value string.
+         * @return     The key's name, or the empty string if key is
+         *             DataKey::unknown.
          */
-        juce::String parseValue(const juce::String& line);
+        const char* getKeyName(const DataKey key);
 
         /**
          * @brief  Makes a command execution string valid for writing into a
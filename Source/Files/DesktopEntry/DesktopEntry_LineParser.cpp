@@ -0,0 +1,141 @@
+#define DESKTOP_ENTRY_IMPLEMENTATION
+#include "DesktopEntry_LineParser.h"
+#include "DesktopEntry_FileUtils.h"
+#include <cstring>
+
+/**
+ * @brief  Checks if a character is a space or tab.
+ *
+ * @param c  Any character.
+ *
+ * @return   Whether the character is whitespace that may surround keys and
+ *           values.
+ */
+static inline bool isBlank(const char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+
+// Checks if the range contains no text.
+bool DesktopEntry::LineParser::TextRange::isEmpty() const
+{
+    return length == 0;
+}
+
+
+// Checks if the range holds specific text.
+bool DesktopEntry::LineParser::TextRange::equals
+(const char* text, const int textLength) const
+{
+    return length == textLength && memcmp(start, text, length) == 0;
+}
+
+
+// Copies the range's text into a new String.
+juce::String DesktopEntry::LineParser::TextRange::toString() const
+{
+    if (length == 0)
+    {
+        return juce::String();
+    }
+    return juce::String::fromUTF8(start, length);
+}
+
+
+// Prepares to parse lines from a desktop entry file's data.
+DesktopEntry::LineParser::LineParser(const void* data, const size_t size) :
+position(static_cast<const char*>(data)),
+dataEnd(static_cast<const char*>(data) + size) { }
+
+
+// Parses the next line in the file data.
+bool DesktopEntry::LineParser::nextLine(Line& line)
+{
+    if (position >= dataEnd)
+    {
+        return false;
+    }
+    const char* lineStart = position;
+    const char* lineEnd = static_cast<const char*>
+            (memchr(lineStart, '\n', dataEnd - lineStart));
+    if (lineEnd == nullptr)
+    {
+        lineEnd = dataEnd;
+        position = dataEnd;
+    }
+    else
+    {
+        position = lineEnd + 1;
+    }
+    if (lineEnd > lineStart && lineEnd[-1] == '\r')
+    {
+        lineEnd--;
+    }
+
+    line = Line();
+    line.text.start = lineStart;
+    line.text.length = (int) (lineEnd - lineStart);
+    if (lineStart == lineEnd || *lineStart == '#')
+    {
+        line.type = LineType::empty;
+        return true;
+    }
+    if (*lineStart == '[')
+    {
+        if (lineEnd[-1] == ']' && lineEnd - lineStart >= 2)
+        {
+            line.type = LineType::header;
+            line.header.start = lineStart + 1;
+            line.header.length = (int) (lineEnd - lineStart - 2);
+        }
+        else
+        {
+            line.type = LineType::invalid;
+        }
+        return true;
+    }
+
+    // Find the key, optional locale, and value:
+    const char* separator = static_cast<const char*>
+            (memchr(lineStart, '=', lineEnd - lineStart));
+    if (separator == nullptr)
+    {
+        line.type = LineType::invalid;
+        return true;
+    }
+    const char* keyEnd = lineStart;
+    while (keyEnd < separator && *keyEnd != '[')
+    {
+        keyEnd++;
+    }
+    if (keyEnd < separator)
+    {
+        const char* localeEnd = static_cast<const char*>
+                (memchr(keyEnd, ']', separator - keyEnd));
+        if (localeEnd != nullptr)
+        {
+            line.locale.start = keyEnd + 1;
+            line.locale.length = (int) (localeEnd - keyEnd - 1);
+        }
+    }
+    while (keyEnd > lineStart && isBlank(keyEnd[-1]))
+    {
+        keyEnd--;
+    }
+    line.keyText.start = lineStart;
+    line.keyText.length = (int) (keyEnd - lineStart);
+    const char* valueStart = separator + 1;
+    while (valueStart < lineEnd && isBlank(*valueStart))
+    {
+        valueStart++;
+    }
+    line.value.start = valueStart;
+    line.value.length = (int) (lineEnd - valueStart);
+
+    line.key = FileUtils::findDataKey(line.keyText.start,
+            line.keyText.length);
+    line.type = (line.key == DataKey::unknown) ? LineType::unknownKey
+            : LineType::keyValue;
+    return true;
+}
@@ -0,0 +1,134 @@
+#ifndef DESKTOP_ENTRY_IMPLEMENTATION
+    #error File included directly outside of DesktopEntry implementation.
+#endif
+#pragma once
+/**
+ * @file  DesktopEntry_LineParser.h
+ *
+ * @brief  Splits desktop entry file data into parsed lines in a single pass.
+ */
+
+#include "DesktopEntry_DataKey.h"
+#include "JuceHeader.h"
+
+namespace DesktopEntry { class LineParser; }
+
+/**
+ * @brief  Reads desktop entry file data one line at a time, directly from a
+ *         buffer holding the entire file.
+ *
+ *  Each parsed line only holds pointers into the file buffer, so parsing lines
+ * never copies or allocates memory. Keys are matched against standard desktop
+ * entry keys using FileUtils::findDataKey, and lines with nonstandard keys or
+ * invalid syntax are reported through the line's type instead of by throwing
+ * exceptions.
+ *
+ *  The file buffer must remain valid and unchanged for as long as the
+ * LineParser and any parsed lines are in use.
+ */
+class DesktopEntry::LineParser
+{
+public:
+    /**
+     * @brief  Points to a section of text within the file buffer.
+     */
+    struct TextRange
+    {
+        // The first character in the range:
+        const char* start = nullptr;
+        // The number of bytes in the range:
+        int length = 0;
+
+        /**
+         * @brief  Checks if the range contains no text.
+         *
+         * @return  Whether the range's length is zero.
+         */
+        bool isEmpty() const;
+
+        /**
+         * @brief  Checks if the range holds specific text.
+         *
+         * @param text        The text to compare with the range's text.
+         *
+         * @param textLength  The number of bytes in the compared text.
+         *
+         * @return            Whether the range holds exactly the same text.
+         */
+        bool equals(const char* text, const int textLength) const;
+
+        /**
+         * @brief  Copies the range's text into a new String.
+         *
+         * @return  The range's text, interpreted as UTF-8.
+         */
+        juce::String toString() const;
+    };
+
+    /**
+     * @brief  Defines all types of desktop entry file line.
+     */
+    enum class LineType
+    {
+        // An empty line, or a comment:
+        empty,
+        // A group header line:
+        header,
+        // A line holding a standard data key and its value:
+        keyValue,
+        // A line holding a nonstandard data key and its value:
+        unknownKey,
+        // A non-empty line that isn't a comment, header, or key/value pair:
+        invalid
+    };
+
+    /**
+     * @brief  Stores a single parsed line.
+     */
+    struct Line
+    {
+        // The type of line parsed:
+        LineType type = LineType::empty;
+        // The full line, excluding its line ending:
+        TextRange text;
+        // The group name within header lines:
+        TextRange header;
+        // The key within key/value lines:
+        TextRange keyText;
+        // The standard data key within keyValue lines:
+        DataKey key = DataKey::unknown;
+        // The locale within key/value lines, or an empty range if the line
+        // doesn't target a specific locale:
+        TextRange locale;
+        // The value within key/value lines:
+        TextRange value;
+    };
+
+    /**
+     * @brief  Prepares to parse lines from a desktop entry file's data.
+     *
+     * @param data  The entire contents of a desktop entry file.
+     *
+     * @param size  The number of bytes of file data.
+     */
+    LineParser(const void* data, const size_t size);
+
+    virtual ~LineParser() { }
+
+    /**
+     * @brief  Parses the next line in the file data.
+     *
+     * @param line  An object where the parsed line data will be saved.
+     *
+     * @return      True if a line was parsed, false if all lines have already
+     *              been parsed.
+     */
+    bool nextLine(Line& line);
+
+private:
+    // The start of the next line to parse:
+    const char* position;
+
+    // The end of the file data:
+    const char* const dataEnd;
+};
@@ -50,6 +50,16 @@ juce::Array<DesktopEntry::EntryFile> DesktopEntry::Loader::getCategoryEntries
 }
 
 
+// Finds all EntryFile objects that match a search query.
+juce::Array<DesktopEntry::EntryFile> DesktopEntry::Loader::findEntries
+(const juce::String& query, const int maxResults) const
+{
+    SharedResource::LockedPtr<const LoadingThread> loadingThread
+            = getReadLockedResource();
+    return loadingThread->findEntries(query, maxResults);
+}
+
+
 // Scans all desktop entry files for any changes made since the last time the
 // DesktopEntry::Loader read the entry files.
 void DesktopEntry::Loader::scanForChanges()
@@ -67,6 +77,19 @@ void DesktopEntry::Loader::scanForChanges()
 }
 
 
+// Saves changes to an edited EntryFile.
+void DesktopEntry::Loader::saveEntry(const EntryFile& entry)
+{
+    SharedResource::LockedPtr<LoadingThread> loadingThread
+            = getWriteLockedResource();
+    if (!loadingThread->isThreadRunning())
+    {
+        loadingThread->startResourceThread();
+    }
+    loadingThread->saveEntry(entry);
+}
+
+
 // Schedules an action to run once all entries have been loaded.
 DesktopEntry::CallbackID DesktopEntry::Loader::waitUntilLoaded
 (std::function<void()> onFinish)
@@ -64,12 +64,41 @@ public:
     juce::Array<EntryFile> getCategoryEntries
     (const juce::StringArray& categoryList) const;
 
+    /**
+     * @brief  Finds all EntryFile objects that match a search query.
+     *
+     *  Query words may match entry names, generic names, keywords, categories,
+     * or executable names, either exactly, as a prefix, or with minor typos.
+     * Only entries matching all query words are returned.
+     *
+     * @param query       The search text to match.
+     *
+     * @param maxResults  The maximum number of EntryFile objects to return.
+     *
+     * @return            All matching EntryFile objects, sorted from the best
+     *                    match to the worst match.
+     */
+    juce::Array<EntryFile> findEntries(const juce::String& query,
+            const int maxResults) const;
+
     /**
      * @brief  Scans all desktop entry files for any changes made since the
      *         last time the LoadingThread read the entry files.
      */
     void scanForChanges();
 
+    /**
+     * @brief  Saves changes to an edited EntryFile.
+     *
+     *  Changes are written to the entry's file in the user's application data
+     * directory on a background thread after a short delay, so that repeated
+     * edits to the same entry are only written once. Updated entry files are
+     * loaded again once they are written.
+     *
+     * @param entry  An EntryFile with edited data to save.
+     */
+    void saveEntry(const EntryFile& entry);
+
     /**
      * @brief  Schedules an action to run once all entries have been loaded.
      *
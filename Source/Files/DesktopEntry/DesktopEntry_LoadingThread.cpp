@@ -3,6 +3,7 @@
 #include "DesktopEntry_FileError.h"
 #include "DesktopEntry_FormatError.h"
 #include "DesktopEntry_UpdateInterface.h"
+#include "SharedResource_Thread_ScopedReadLock.h"
 #include "SharedResource_Thread_ScopedWriteLock.h"
 #include "Assets_XDGDirectories.h"
 
@@ -30,14 +31,36 @@ static const constexpr char* miscEntryCategory = "Other";
 // Desktop entry file extension:
 static const constexpr char* fileExtension = ".desktop";
 
+// Maximum number of worker threads used to parse desktop entry files:
+static const constexpr int maxWorkerThreads = 4;
+
+// Minimum number of files to assign to each parsing job, so that small updates
+// don't need to use every worker thread:
+static const constexpr int minFilesPerJob = 16;
+
+// Milliseconds to wait for a parsing job before checking if the thread should
+// exit:
+static const constexpr int jobWaitMilliseconds = 100;
+
 // Creates and starts the thread resource.
 DesktopEntry::LoadingThread::LoadingThread() :
-SharedResource::Thread::Resource(resourceKey, ::threadName)
+SharedResource::Thread::Resource(resourceKey, ::threadName),
+parsingPool(juce::jlimit(1, maxWorkerThreads,
+            juce::SystemStats::getNumCpus())),
+entryWatcher([this]() { notify(); }),
+entryWriter([this]() { notify(); })
 {
     startResourceThread();
 }
 
 
+// Ensures all parsing jobs are stopped before destruction.
+DesktopEntry::LoadingThread::~LoadingThread()
+{
+    parsingPool.removeAllJobs();
+}
+
+
 // Finds a desktop entry from its desktop file ID.
 DesktopEntry::EntryFile DesktopEntry::LoadingThread::getDesktopEntry
     (const juce::String entryFileID) const
@@ -58,6 +81,7 @@ juce::Array<DesktopEntry::EntryFile>
 DesktopEntry::LoadingThread::getAllEntries() const
 {
     juce::Array<EntryFile> entryList;
+    entryList.ensureStorageAllocated((int) entries.size());
     for (const auto& entryIter : entries)
     {
         entryList.add(entryIter.second);
@@ -126,6 +150,24 @@ DesktopEntry::LoadingThread::getCategoryEntries
 }
 
 
+// Finds all desktop entries that match a search query.
+juce::Array<DesktopEntry::EntryFile> DesktopEntry::LoadingThread::findEntries
+(const juce::String& query, const int maxResults) const
+{
+    juce::Array<EntryFile> entryList;
+    for (const juce::String& entryID :
+            searchIndex.findEntries(query, maxResults))
+    {
+        auto entryIter = entries.find(entryID);
+        if (entryIter != entries.end())
+        {
+            entryList.add(entryIter->second);
+        }
+    }
+    return entryList;
+}
+
+
 // Adds a callback function to run once when the thread finishes loading or
 // updating desktop entries.
 DesktopEntry::CallbackID DesktopEntry::LoadingThread::addLoadingCallback
@@ -153,14 +195,49 @@ void DesktopEntry::LoadingThread::cancelCallback(const CallbackID toCancel)
 }
 
 
-// Finds all relevant changes to the set of loaded desktop entry files, and
-// prepares to fully update desktop entry data.
+// Finds all relevant changes to the set of loaded desktop entry files by
+// scanning all desktop entry directories, and prepares to fully update desktop
+// entry data.
 void DesktopEntry::LoadingThread::findUpdatedFiles()
 {
     using juce::String;
     using juce::File;
     juce::StringArray dirs = Assets::XDGDirectories::getDataSearchPaths();
-    std::map<String, File> oldFiles = entryFiles;
+    if (!entryDirectoriesChanged(dirs))
+    {
+        // No entry files were added, removed, or replaced, so only files that
+        // previously failed to parse need to be checked for changes:
+        for (const auto& failedIter : failedFiles)
+        {
+            const EntryCache::FileRecord& failedRecord = failedIter.second;
+            if (failedRecord.file.getLastModificationTime().toMilliseconds()
+                    != failedRecord.modTime)
+            {
+                const String& desktopID = failedIter.first;
+                entryFiles[desktopID] = EntryCache::FileRecord(
+                        failedRecord.file);
+                pendingFiles[desktopID] = failedRecord.file;
+                if (entries.count(desktopID) > 0)
+                {
+                    lastChangedIDs.add(desktopID);
+                }
+                else
+                {
+                    lastAddedIDs.add(desktopID);
+                }
+                cacheOutdated = true;
+            }
+        }
+        DBG(dbgPrefix << __func__ << ": Entry directories are unchanged, "
+                << "reloading " << ((int) pendingFiles.size())
+                << " previously failed entry files.");
+        return;
+    }
+    // Save directory times before scanning, so that changes made during the
+    // scan will be found by the next scan:
+    std::map<String, juce::int64> scannedDirectoryTimes
+            = getDirectoryTimes(dirs);
+    std::map<String, EntryCache::FileRecord> oldFiles = entryFiles;
     entryFiles.clear();
     for (const String& dir : dirs)
     {
@@ -175,11 +252,15 @@ void DesktopEntry::LoadingThread::findUpdatedFiles()
                 if (entryFiles.count(desktopID) == 0
                         && pendingFiles.count(desktopID) == 0)
                 {
-                    entryFiles[desktopID] = file;
+                    const EntryCache::FileRecord fileRecord(file);
+                    entryFiles[desktopID] = fileRecord;
                     // Skip updates to files that have not changed since the
-                    // last scan:
-                    if (file.getLastModificationTime() > lastScanTime
-                            || file != oldFiles[desktopID])
+                    // last scan, or since they last failed to parse:
+                    if (oldFiles.count(desktopID) == 0
+                            || !(fileRecord == oldFiles[desktopID])
+                            || (failedFiles.count(desktopID) > 0
+                                && failedFiles[desktopID].modTime
+                                != fileRecord.modTime))
                     {
                         pendingFiles[desktopID] = file;
                         if (!oldFiles.count(desktopID))
@@ -203,10 +284,15 @@ void DesktopEntry::LoadingThread::findUpdatedFiles()
             if (!entryFiles.count(desktopID))
             {
                 lastRemovedIDs.add(desktopID);
+                failedFiles.erase(desktopID);
             }
         }
     }
-    lastScanTime = juce::Time::getCurrentTime();
+    directoryTimes.swap(scannedDirectoryTimes);
+    if (!pendingFiles.empty() || !lastRemovedIDs.isEmpty())
+    {
+        cacheOutdated = true;
+    }
     DBG(dbgPrefix << __func__ << ": Found " << String(entryFiles.size())
             << " unique desktop entry files in " << dirs.size()
             << " data directories.");
@@ -215,6 +301,92 @@ void DesktopEntry::LoadingThread::findUpdatedFiles()
 }
 
 
+// Checks if any desktop entry directory was added, removed, or changed since
+// entry directories were last scanned.
+bool DesktopEntry::LoadingThread::entryDirectoriesChanged
+(const juce::StringArray& dataDirs) const
+{
+    using juce::String;
+    if (directoryTimes.empty())
+    {
+        return true;
+    }
+    juce::StringArray entryDirs;
+    for (const String& dataDir : dataDirs)
+    {
+        const String entryDir
+                = juce::File(dataDir + entryDirectory).getFullPathName();
+        if (directoryTimes.count(entryDir) == 0)
+        {
+            return true;
+        }
+        entryDirs.add(entryDir);
+    }
+    for (const auto& dirIter : directoryTimes)
+    {
+        const juce::File directory(dirIter.first);
+        if (directory.getLastModificationTime().toMilliseconds()
+                != dirIter.second)
+        {
+            return true;
+        }
+        // Check for directories from data directories that are no longer used:
+        bool inEntryDir = false;
+        for (const String& entryDir : entryDirs)
+        {
+            if (dirIter.first == entryDir
+                    || directory.isAChildOf(juce::File(entryDir)))
+            {
+                inEntryDir = true;
+                break;
+            }
+        }
+        if (!inEntryDir)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Gets the modification times of all desktop entry directories and their
+// subdirectories.
+std::map<juce::String, juce::int64>
+DesktopEntry::LoadingThread::getDirectoryTimes
+(const juce::StringArray& dataDirs) const
+{
+    using juce::File;
+    std::map<juce::String, juce::int64> modTimes;
+    for (const juce::String& dataDir : dataDirs)
+    {
+        // Missing entry directories are saved with a zero modification time,
+        // so that their creation is noticed:
+        const File entryDir(dataDir + entryDirectory);
+        modTimes[entryDir.getFullPathName()]
+                = entryDir.getLastModificationTime().toMilliseconds();
+        if (entryDir.isDirectory())
+        {
+            for (const File& subdir : entryDir.findChildFiles(
+                        File::findDirectories, true))
+            {
+                modTimes[subdir.getFullPathName()]
+                        = subdir.getLastModificationTime().toMilliseconds();
+            }
+        }
+    }
+    return modTimes;
+}
+
+
+// Schedules an edited desktop entry to be written to the user's application
+// data directory.
+void DesktopEntry::LoadingThread::saveEntry(const EntryFile& entry)
+{
+    entryWriter.saveEntry(entry);
+}
+
+
 // Checks if the thread has finished loading desktop entry files, and is either
 // running cleanup or waiting for another request.
 bool DesktopEntry::LoadingThread::isFinishedLoading()
@@ -223,8 +395,7 @@ bool DesktopEntry::LoadingThread::isFinishedLoading()
 }
 
 
-// Finds all unloaded or updated desktop entry files within the application
-// data directories, ignoring files with duplicate desktop file IDs.
+// Finds new and updated desktop entry files for the thread to process.
 void DesktopEntry::LoadingThread::init
 (SharedResource::Thread::Lock& threadLock)
 {
@@ -232,64 +403,158 @@ void DesktopEntry::LoadingThread::init
     lastAddedIDs.clear();
     lastChangedIDs.clear();
     lastRemovedIDs.clear();
-    findUpdatedFiles();
+    if (!cacheRead)
+    {
+        cacheRead = true;
+        const SharedResource::Thread::ScopedWriteLock writeLock(threadLock);
+        if (entryCache.readCache(entryFiles, failedFiles, directoryTimes,
+                    entries, categories))
+        {
+            DBG(dbgPrefix << __func__ << ": Loaded " << (int) entries.size()
+                    << " cached desktop entries.");
+            for (const auto& entryIter : entries)
+            {
+                searchIndex.addEntry(entryIter.first, entryIter.second);
+            }
+        }
+    }
+    findWatchedChanges();
 }
 
 
-// Loads or updates a single desktop entry file in the list of pending files.
+// Loads or updates all desktop entry files in the list of pending files.
 void DesktopEntry::LoadingThread::runLoop
 (SharedResource::Thread::Lock& threadLock)
 {
-    using juce::String;
-    const SharedResource::Thread::ScopedWriteLock writeLock(threadLock);
-    if (!pendingFiles.empty())
+    // Divide all pending files between parsing jobs:
+    juce::OwnedArray<ParsingJob> parsingJobs;
     {
-        String entryID = pendingFiles.begin()->first;
-        juce::File entryFile = pendingFiles.begin()->second;
-        pendingFiles.erase(pendingFiles.begin());
-        try
+        const SharedResource::Thread::ScopedWriteLock writeLock(threadLock);
+        // Include files that changed since the thread last checked:
+        if (entryWatcher.hasChanges())
+        {
+            findWatchedChanges();
+        }
+        const int fileCount = (int) pendingFiles.size();
+        const int jobCount = juce::jlimit(1, parsingPool.getNumThreads(),
+                fileCount / minFilesPerJob);
+        int fileIndex = 0;
+        for (const auto& pendingFile : pendingFiles)
         {
-            EntryFile entry(entryFile, entryID);
-            if (entry.shouldBeDisplayed())
+            if (parsingJobs.size() < jobCount)
             {
-                juce::StringArray entryCategories = entry.getCategories();
-                if (entryCategories.isEmpty())
-                {
-                    // Categorize as "Other"
-                    entryCategories.add(miscEntryCategory);
-                }
-                // Add to list of all entries
-                entryCategories.add(everyEntryCategory);
-                for (const String& category : entryCategories)
-                {
-                    categories[category].add(entryID);
-                }
-                entries[entryID] = entry;
+                parsingJobs.add(new ParsingJob);
             }
-            // If an updated entry is hidden, mark it as removed in the change
-            // list. If a new entry was hidden, don't mention in in the change
-            // list at all.
-            else
+            parsingJobs[fileIndex % jobCount]->addFile(pendingFile.first,
+                    pendingFile.second);
+            fileIndex++;
+        }
+        pendingFiles.clear();
+    }
+
+    // Parse files without holding the resource lock, so loaded entries may
+    // still be read:
+    for (ParsingJob* job : parsingJobs)
+    {
+        parsingPool.addJob(job);
+    }
+    for (ParsingJob* job : parsingJobs)
+    {
+        while (!parsingPool.waitForJobToFinish(job, jobWaitMilliseconds))
+        {
+            if (threadShouldExit())
             {
-                if (entries.count(entryID) > 0)
+                DBG(dbgPrefix << __func__
+                        << ": Exiting, cancelling desktop entry parsing.");
+                parsingPool.removeAllJobs();
+                // None of the parsed entries are published, so keep the entry
+                // cache from recording their files as loaded:
+                const SharedResource::Thread::ScopedWriteLock writeLock(
+                        threadLock);
+                for (const ParsingJob* cancelledJob : parsingJobs)
                 {
-                    lastChangedIDs.removeString(entryID);
-                    lastRemovedIDs.add(entryID);
-                    entries.erase(entryID);
-                }
-                else
-                {
-                    lastAddedIDs.removeString(entryID);
+                    for (const ParsedEntry& cancelledEntry
+                            : cancelledJob->getParsedEntries())
+                    {
+                        entryFiles.erase(cancelledEntry.entryID);
+                        pendingFiles[cancelledEntry.entryID]
+                                = cancelledEntry.file;
+                    }
                 }
+                // Cancelled files are missing from the saved file records, so
+                // the next launch needs to scan all entry directories:
+                directoryTimes.clear();
+                return;
             }
         }
-        catch(FileError e)
+    }
+
+    // Add all parsed entries to the loaded entry data:
+    const SharedResource::Thread::ScopedWriteLock writeLock(threadLock);
+    for (const ParsingJob* job : parsingJobs)
+    {
+        for (const ParsedEntry& parsedEntry : job->getParsedEntries())
         {
-            DBG(dbgPrefix << __func__ << ": File error: " << e.what());
+            publishEntry(parsedEntry);
         }
-        catch(FormatError e)
+    }
+}
+
+
+// Adds a parsed desktop entry to the loaded entry data, replacing any previous
+// version of the entry and updating the lists of changed desktop entries.
+void DesktopEntry::LoadingThread::publishEntry(const ParsedEntry& parsedEntry)
+{
+    using juce::String;
+    const String& entryID = parsedEntry.entryID;
+    if (!parsedEntry.parsed)
+    {
+        // Save the failed file's modification time, so it's only parsed again
+        // once it changes:
+        failedFiles[entryID] = EntryCache::FileRecord(parsedEntry.file);
+        return;
+    }
+    failedFiles.erase(entryID);
+    const EntryFile& entry = parsedEntry.entry;
+    // Remove the previous version of updated entries from all categories:
+    if (entries.count(entryID) > 0)
+    {
+        for (auto& categoryIter : categories)
         {
-            DBG(dbgPrefix << __func__ << ": Format error: " << e.what());
+            categoryIter.second.removeString(entryID);
+        }
+    }
+    if (entry.shouldBeDisplayed())
+    {
+        juce::StringArray entryCategories = entry.getCategories();
+        if (entryCategories.isEmpty())
+        {
+            // Categorize as "Other"
+            entryCategories.add(miscEntryCategory);
+        }
+        // Add to list of all entries
+        entryCategories.add(everyEntryCategory);
+        for (const String& category : entryCategories)
+        {
+            categories[category].add(entryID);
+        }
+        entries[entryID] = entry;
+        searchIndex.addEntry(entryID, entry);
+    }
+    // If an updated entry is hidden, mark it as removed in the change list. If
+    // a new entry was hidden, don't mention in in the change list at all.
+    else
+    {
+        if (entries.count(entryID) > 0)
+        {
+            lastChangedIDs.removeString(entryID);
+            lastRemovedIDs.add(entryID);
+            entries.erase(entryID);
+            searchIndex.removeEntry(entryID);
+        }
+        else
+        {
+            lastAddedIDs.removeString(entryID);
         }
     }
 }
@@ -300,45 +565,232 @@ void DesktopEntry::LoadingThread::runLoop
 void DesktopEntry::LoadingThread::cleanup
 (SharedResource::Thread::Lock& threadLock)
 {
-    const SharedResource::Thread::ScopedWriteLock writeLock(threadLock);
-    finishedLoading = true;
-    DBG(dbgPrefix << __func__ << ": "
-            << lastAddedIDs.size() << " added, "
-            << lastChangedIDs.size() << " updated, "
-            << lastRemovedIDs.size() << " removed.");
-    juce::MessageManager::callAsync(buildAsyncFunction(
-                SharedResource::LockType::read, [this]
     {
-        for (const auto& callback : onFinish)
+        const SharedResource::Thread::ScopedWriteLock writeLock(threadLock);
+        // Remove entries with deleted files from the loaded entry data:
+        for (auto entryIter = entries.begin(); entryIter != entries.end();)
         {
-            callback.second();
+            if (entryFiles.count(entryIter->first) == 0)
+            {
+                for (auto& categoryIter : categories)
+                {
+                    categoryIter.second.removeString(entryIter->first);
+                }
+                searchIndex.removeEntry(entryIter->first);
+                entryIter = entries.erase(entryIter);
+            }
+            else
+            {
+                entryIter++;
+            }
         }
-        onFinish.clear();
+        finishedLoading = true;
+        DBG(dbgPrefix << __func__ << ": "
+                << lastAddedIDs.size() << " added, "
+                << lastChangedIDs.size() << " updated, "
+                << lastRemovedIDs.size() << " removed.");
+        juce::MessageManager::callAsync(buildAsyncFunction(
+                    SharedResource::LockType::read, [this]
+        {
+            for (const auto& callback : onFinish)
+            {
+                callback.second();
+            }
+            onFinish.clear();
 
-        foreachHandler<UpdateInterface>(
-        [this](UpdateInterface* updateListener)
+            foreachHandler<UpdateInterface>(
+            [this](UpdateInterface* updateListener)
+            {
+                if (!lastAddedIDs.isEmpty())
+                {
+                    updateListener->entriesAdded(lastAddedIDs);
+                }
+                if (!lastChangedIDs.isEmpty())
+                {
+                    updateListener->entriesUpdated(lastChangedIDs);
+                }
+                if (!lastRemovedIDs.isEmpty())
+                {
+                    updateListener->entriesRemoved(lastRemovedIDs);
+                }
+            });
+        }));
+    }
+    // Save changes to the entry cache, only blocking entry data updates:
+    if (cacheOutdated)
+    {
+        const SharedResource::Thread::ScopedReadLock readLock(threadLock);
+        if (!entryCache.writeCache(entryFiles, failedFiles, directoryTimes,
+                    entries, categories))
+        {
+            DBG(dbgPrefix << __func__ << ": Failed to save entry cache.");
+        }
+        cacheOutdated = false;
+    }
+}
+
+
+// Makes the thread sleep after loading or updating all desktop files.
+bool DesktopEntry::LoadingThread::threadShouldWait()
+{
+    return pendingFiles.empty() && !entryWatcher.hasChanges();
+}
+
+
+// Finds all pending changes to desktop entry files using changes found by the
+// EntryWatcher, scanning all desktop entry directories only if necessary.
+void DesktopEntry::LoadingThread::findWatchedChanges()
+{
+    juce::StringArray changedPaths;
+    const bool changesTracked = entryWatcher.takeChanges(changedPaths);
+    if (changesTracked && watchingDirectories
+            && updateChangedFiles(changedPaths))
+    {
+        return;
+    }
+    // Start watching directories before scanning them, so that no changes are
+    // missed:
+    watchEntryDirectories();
+    findUpdatedFiles();
+}
+
+
+// Updates desktop entry file records and pending files to match a list of
+// changed file paths.
+bool DesktopEntry::LoadingThread::updateChangedFiles
+(const juce::StringArray& changedPaths)
+{
+    using juce::String;
+    using juce::File;
+    const juce::StringArray dataDirs
+            = Assets::XDGDirectories::getDataSearchPaths();
+    juce::Array<File> entryDirs;
+    for (const String& dataDir : dataDirs)
+    {
+        entryDirs.add(File(dataDir + entryDirectory));
+    }
+    for (const String& changedPath : changedPaths)
+    {
+        const File changedFile(changedPath);
+        if (entryDirs.contains(changedFile))
+        {
+            // A desktop entry directory was added, removed, or moved:
+            return false;
+        }
+        const File* entryDir = nullptr;
+        for (const File& dir : entryDirs)
+        {
+            if (changedFile.isAChildOf(dir))
+            {
+                entryDir = &dir;
+                break;
+            }
+        }
+        if (entryDir == nullptr)
+        {
+            // Ignore other changes within watched data directories.
+            continue;
+        }
+        if (changedFile.getFileExtension() != fileExtension)
         {
-            if (!lastAddedIDs.isEmpty())
+            // Desktop entry subdirectories need to be scanned for entry files,
+            // but other files may be ignored:
+            if (changedFile.isDirectory())
             {
-                updateListener->entriesAdded(lastAddedIDs);
+                return false;
             }
-            if (!lastChangedIDs.isEmpty())
+            const String dirPrefix = changedFile.getFullPathName() + "/";
+            for (const auto& fileIter : entryFiles)
             {
-                updateListener->entriesUpdated(lastChangedIDs);
+                if (fileIter.second.file.getFullPathName().startsWith(
+                            dirPrefix))
+                {
+                    return false;
+                }
             }
-            if (!lastRemovedIDs.isEmpty())
+            continue;
+        }
+
+        // Find the entry file that should be used for the changed file's
+        // desktop file ID, which may not be the changed file:
+        const String desktopID = changedFile.getRelativePathFrom(*entryDir);
+        const File entryFile = findEntryFile(desktopID);
+        const bool wasFound = entryFiles.count(desktopID) > 0;
+        if (entryFile == File())
+        {
+            if (wasFound)
             {
-                updateListener->entriesRemoved(lastRemovedIDs);
+                entryFiles.erase(desktopID);
+                failedFiles.erase(desktopID);
+                pendingFiles.erase(desktopID);
+                if (lastAddedIDs.contains(desktopID))
+                {
+                    lastAddedIDs.removeString(desktopID);
+                }
+                else
+                {
+                    lastChangedIDs.removeString(desktopID);
+                    lastRemovedIDs.addIfNotAlreadyThere(desktopID);
+                }
+                cacheOutdated = true;
             }
-        });
-    }));
+            continue;
+        }
+        const EntryCache::FileRecord fileRecord(entryFile);
+        if (wasFound && fileRecord == entryFiles[desktopID])
+        {
+            continue;
+        }
+        entryFiles[desktopID] = fileRecord;
+        pendingFiles[desktopID] = entryFile;
+        if (lastRemovedIDs.contains(desktopID))
+        {
+            lastRemovedIDs.removeString(desktopID);
+            lastChangedIDs.addIfNotAlreadyThere(desktopID);
+        }
+        else if (!wasFound)
+        {
+            lastAddedIDs.addIfNotAlreadyThere(desktopID);
+        }
+        else if (!lastAddedIDs.contains(desktopID))
+        {
+            lastChangedIDs.addIfNotAlreadyThere(desktopID);
+        }
+        cacheOutdated = true;
+    }
+    DBG(dbgPrefix << __func__ << ": Reloading "
+            << ((int) pendingFiles.size()) << " changed entry files.");
+    return true;
 }
 
 
-// Makes the thread sleep after loading or updating all desktop files.
-bool DesktopEntry::LoadingThread::threadShouldWait()
+// Makes the EntryWatcher watch all desktop entry directories and their
+// subdirectories, along with all data directories that don't yet have a
+// desktop entry directory.
+void DesktopEntry::LoadingThread::watchEntryDirectories()
 {
-    return pendingFiles.empty();
+    using juce::File;
+    juce::StringArray watchedDirs;
+    for (const juce::String& dataDir :
+            Assets::XDGDirectories::getDataSearchPaths())
+    {
+        const File entryDir(dataDir + entryDirectory);
+        if (!entryDir.isDirectory())
+        {
+            // Watch the data directory so the entry directory's creation is
+            // noticed:
+            watchedDirs.add(File(dataDir).getFullPathName());
+            continue;
+        }
+        watchedDirs.add(entryDir.getFullPathName());
+        for (const File& subdir : entryDir.findChildFiles(
+                    File::findDirectories, true))
+        {
+            watchedDirs.add(subdir.getFullPathName());
+        }
+    }
+    entryWatcher.watchDirectories(watchedDirs);
+    watchingDirectories = true;
 }
 
 
@@ -365,8 +817,7 @@ juce::File DesktopEntry::LoadingThread::findEntryFile
     juce::StringArray dirs = Assets::XDGDirectories::getDataSearchPaths();
     for (const juce::String& dir : dirs)
     {
-        juce::File entryFile(dir + entryDirectory + entryFileID
-                + fileExtension);
+        juce::File entryFile(dir + entryDirectory + entryFileID);
         if (entryFile.existsAsFile())
         {
             return entryFile;
@@ -374,3 +825,56 @@ juce::File DesktopEntry::LoadingThread::findEntryFile
     }
     return juce::File();
 }
+
+
+// Creates an empty parsing job.
+DesktopEntry::LoadingThread::ParsingJob::ParsingJob() :
+juce::ThreadPoolJob("DesktopEntry_ParsingJob") { }
+
+
+// Adds a desktop entry file for the job to parse.
+void DesktopEntry::LoadingThread::ParsingJob::addFile
+(const juce::String& entryID, const juce::File& entryFile)
+{
+    ParsedEntry newEntry;
+    newEntry.entryID = entryID;
+    newEntry.file = entryFile;
+    parsedEntries.add(newEntry);
+}
+
+
+// Parses all of the job's desktop entry files.
+juce::ThreadPoolJob::JobStatus
+DesktopEntry::LoadingThread::ParsingJob::runJob()
+{
+    for (ParsedEntry& parsedEntry : parsedEntries)
+    {
+        if (shouldExit())
+        {
+            break;
+        }
+        try
+        {
+            parsedEntry.entry = EntryFile(parsedEntry.file,
+                    parsedEntry.entryID);
+            parsedEntry.parsed = true;
+        }
+        catch(FileError e)
+        {
+            DBG(dbgPrefix << __func__ << ": File error: " << e.what());
+        }
+        catch(FormatError e)
+        {
+            DBG(dbgPrefix << __func__ << ": Format error: " << e.what());
+        }
+    }
+    return jobHasFinished;
+}
+
+
+// Gets all of the job's desktop entry files and their parsed data.
+const juce::Array<DesktopEntry::LoadingThread::ParsedEntry>&
+DesktopEntry::LoadingThread::ParsingJob::getParsedEntries() const
+{
+    return parsedEntries;
+}
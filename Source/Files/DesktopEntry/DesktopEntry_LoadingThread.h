@@ -9,7 +9,12 @@
  */
 
 #include "SharedResource_Thread_Resource.h"
+#include "SharedResource_Thread_JobPool.h"
 #include "DesktopEntry_EntryFile.h"
+#include "DesktopEntry_EntryCache.h"
+#include "DesktopEntry_EntryWatcher.h"
+#include "DesktopEntry_EntryWriter.h"
+#include "DesktopEntry_SearchIndex.h"
 #include "DesktopEntry_CallbackID.h"
 #include <map>
 
@@ -31,6 +36,28 @@ namespace DesktopEntry { class LoadingThread; }
  * first loaded, the LoadingThread may be used to update the data, scanning all
  * desktop entry file directories for changes, and sharing these changes with
  * all DesktopEntry::UpdateListener objects.
+ *
+ *  Desktop entry files are parsed by a small pool of worker threads without
+ * holding the resource lock, so loaded entry data remains readable while files
+ * are parsed. Once all pending files are parsed, the new entry data is added to
+ * the loaded entry data in a single step. When thread resources share the
+ * SharedResource::Thread::Pool, parsing jobs run within that pool, and the
+ * LoadingThread runs waiting pool tasks while it waits for parsing to finish.
+ *
+ *  When the LoadingThread first runs, it loads the entry data saved by the
+ * last application instance from the EntryCache, and only parses entry files
+ * that changed since that data was saved. If no desktop entry directory was
+ * modified since the cache was saved, individual entry files aren't checked
+ * at all, except for files that failed to parse, which are only parsed again
+ * once their modification time changes. Whenever loaded entry data changes,
+ * the LoadingThread saves the updated data to the EntryCache before it stops
+ * running.
+ *
+ *  Once entries are loaded, the LoadingThread uses an EntryWatcher to wake
+ * itself whenever files change within desktop entry directories. Only the
+ * entries with changed files are updated, and all desktop entry directories
+ * are only scanned again if the watched directories change, or if too many
+ * changes occur at once to track individually.
  */
 class DesktopEntry::LoadingThread : public SharedResource::Thread::Resource
 {
@@ -43,7 +70,10 @@ public:
      */
     LoadingThread();
 
-    virtual ~LoadingThread() { }
+    /**
+     * @brief  Ensures all parsing jobs are stopped before destruction.
+     */
+    virtual ~LoadingThread();
 
     /**
      * @brief  Finds a desktop entry from its desktop file ID.
@@ -86,6 +116,20 @@ public:
     juce::Array<EntryFile> getCategoryEntries
         (const juce::StringArray categoryList) const;
 
+    /**
+     * @brief  Finds all desktop entries that match a search query.
+     *
+     * @param query       Search text matched against entry names, generic
+     *                    names, keywords, categories, and executable names.
+     *
+     * @param maxResults  The maximum number of entries to return.
+     *
+     * @return            All matching entries, sorted from the best match to
+     *                    the worst match.
+     */
+    juce::Array<EntryFile> findEntries(const juce::String& query,
+            const int maxResults) const;
+
     /**
      * @brief  Adds a callback function to run once when the thread finishes
      *         loading or updating desktop entries. This will only be added if
@@ -110,10 +154,23 @@ public:
 
     /**
      * @brief  Finds all relevant changes to the set of loaded desktop entry
-     *         files, and prepares to fully update desktop entry data.
+     *         files by scanning all desktop entry directories, and prepares to
+     *         fully update desktop entry data.
      */
     void findUpdatedFiles();
 
+    /**
+     * @brief  Schedules an edited desktop entry to be written to the user's
+     *         application data directory.
+     *
+     *  Entries are written on the EntryWriter's thread after a short delay,
+     * and the LoadingThread is notified once they are written so that the
+     * updated files are loaded.
+     *
+     * @param entry  An edited desktop entry.
+     */
+    void saveEntry(const EntryFile& entry);
+
     /**
      * @brief  Checks if the thread has finished loading desktop entry files,
      *         and is either running cleanup or waiting for another request.
@@ -125,11 +182,68 @@ public:
 
 private:
     /**
-     * @brief  Scans for new and updated desktop entry files for the thread to
+     * @brief  Holds a desktop entry file, and the entry data parsed from that
+     *         file.
+     */
+    struct ParsedEntry
+    {
+        // The entry's desktop file ID:
+        juce::String entryID;
+        // The desktop entry file to parse:
+        juce::File file;
+        // The parsed desktop entry:
+        EntryFile entry;
+        // Whether the file was successfully parsed:
+        bool parsed = false;
+    };
+
+    /**
+     * @brief  Parses a set of desktop entry files within the parsing thread
+     *         pool.
+     */
+    class ParsingJob : public juce::ThreadPoolJob
+    {
+    public:
+        ParsingJob();
+
+        virtual ~ParsingJob() { }
+
+        /**
+         * @brief  Adds a desktop entry file for the job to parse.
+         *
+         * @param entryID    The file's desktop file ID.
+         *
+         * @param entryFile  The desktop entry file.
+         */
+        void addFile(const juce::String& entryID, const juce::File& entryFile);
+
+        /**
+         * @brief  Parses all of the job's desktop entry files.
+         *
+         * @return  The jobHasFinished status, as parsing jobs only run once.
+         */
+        virtual JobStatus runJob() override;
+
+        /**
+         * @brief  Gets all of the job's desktop entry files and their parsed
+         *         data.
+         *
+         * @return  The job's entries. Parsed data will only be set once the
+         *          job has finished running.
+         */
+        const juce::Array<ParsedEntry>& getParsedEntries() const;
+
+    private:
+        juce::Array<ParsedEntry> parsedEntries;
+    };
+
+    /**
+     * @brief  Finds new and updated desktop entry files for the thread to
      *         process.
      *
      *  This function runs once whenever the desktop entry thread starts
-     * running.
+     * running. The first time it runs, all cached entry data is loaded before
+     * scanning for updated files.
      *
      * @param threadLock  An object used to access the desktop entry thread's
      *                    SharedResource lock.
@@ -137,11 +251,13 @@ private:
     virtual void init(SharedResource::Thread::Lock& threadLock) override;
 
     /**
-     * @brief  Loads or updates a single desktop entry file in the list of
-     *         pending files.
+     * @brief  Loads or updates all desktop entry files in the list of pending
+     *         files.
      *
-     *  This function will be called repeatedly on the desktop entry thread
-     * until all entry files have been loaded or updated.
+     *  Pending files are divided between parsing jobs, and parsed without
+     * holding the resource lock. Once all jobs finish, the resource lock is
+     * held for writing while the parsed entries are added to the loaded entry
+     * data.
      *
      * @param threadLock  An object used to access the desktop entry thread's
      *                    SharedResource lock.
@@ -150,8 +266,8 @@ private:
 
     /**
      * @brief  Runs all registered callback functions once all desktop entry
-     *         files have been loaded or updated, and notifies UpdateListeners
-     *         of all new changes.
+     *         files have been loaded or updated, notifies UpdateListeners of
+     *         all new changes, and saves changed entry data to the cache.
      *
      * This function will be called on the desktop entry thread just before the
      * thread stops running.
@@ -165,11 +281,78 @@ private:
      * @brief  Makes the thread sleep after loading or updating all desktop
      *         files.
      *
-     * @return  True if there are still files to(re)load, false if all desktop
-     *          files were loaded or updated.
+     * @return  True if there are still files to(re)load or unprocessed file
+     *          changes, false if all desktop files were loaded or updated.
      */
     virtual bool threadShouldWait() override;
 
+    /**
+     * @brief  Checks if any desktop entry directory was added, removed, or
+     *         changed since entry directories were last scanned.
+     *
+     *  Adding, removing, or renaming files changes their directory's
+     * modification time, so if no entry directory changed, all saved entry
+     * file records still refer to existing files.
+     *
+     * @param dataDirs  All application data directories.
+     *
+     * @return          Whether all entry directories need to be scanned for
+     *                  changed files.
+     */
+    bool entryDirectoriesChanged(const juce::StringArray& dataDirs) const;
+
+    /**
+     * @brief  Gets the modification times of all desktop entry directories
+     *         and their subdirectories.
+     *
+     * @param dataDirs  All application data directories.
+     *
+     * @return          A map of directory paths to modification times in
+     *                  milliseconds since the Unix epoch. Missing entry
+     *                  directories are included with a modification time of
+     *                  zero.
+     */
+    std::map<juce::String, juce::int64> getDirectoryTimes
+    (const juce::StringArray& dataDirs) const;
+
+    /**
+     * @brief  Finds all pending changes to desktop entry files using changes
+     *         found by the EntryWatcher, scanning all desktop entry directories
+     *         only if necessary.
+     */
+    void findWatchedChanges();
+
+    /**
+     * @brief  Updates desktop entry file records and pending files to match a
+     *         list of changed file paths.
+     *
+     * @param changedPaths  Paths of files and directories that changed within
+     *                      watched directories.
+     *
+     * @return              False if any changes could not be handled
+     *                      individually, and all desktop entry directories
+     *                      should be scanned again. Otherwise, true.
+     */
+    bool updateChangedFiles(const juce::StringArray& changedPaths);
+
+    /**
+     * @brief  Makes the EntryWatcher watch all desktop entry directories and
+     *         their subdirectories, along with all data directories that don't
+     *         yet have a desktop entry directory.
+     */
+    void watchEntryDirectories();
+
+    /**
+     * @brief  Adds a parsed desktop entry to the loaded entry data, replacing
+     *         any previous version of the entry and updating the lists of
+     *         changed desktop entries.
+     *
+     *  This should only be called while the resource lock is held for writing.
+     *
+     * @param parsedEntry  A desktop entry parsed within a ParsingJob.
+     */
+    void publishEntry(const ParsedEntry& parsedEntry);
+
     /**
      * @brief  Generates a unique callback ID the thread can assign to a
      *         callback function.
@@ -181,7 +364,9 @@ private:
     /**
      * @brief  Find a desktop entry file using its desktop file ID.
      *
-     * @param entryFileID  The desktop file ID of a desktop entry.
+     * @param entryFileID  The desktop file ID of a desktop entry, which is the
+     *                     entry file's path relative to its desktop entry
+     *                     directory.
      *
      * @return             The first matching file found within application
      *                     data directories, or an empty file object if no
@@ -192,15 +377,47 @@ private:
     // Maps desktop ID strings to desktop entry objects.
     std::map<juce::String, EntryFile> entries;
 
-    // Maps desktop ID strings to .desktop files.
-    std::map<juce::String, juce::File> entryFiles;
+    // Maps desktop ID strings to records of their .desktop files.
+    std::map<juce::String, EntryCache::FileRecord> entryFiles;
+
+    // Maps desktop ID strings to records of .desktop files that failed to
+    // parse, taken when parsing failed.
+    std::map<juce::String, EntryCache::FileRecord> failedFiles;
+
+    // Maps desktop entry directory paths to their modification times when
+    // they were last scanned.
+    std::map<juce::String, juce::int64> directoryTimes;
 
     // All <Desktop file ID, .desktop file> pairs waiting to be loaded.
     std::map<juce::String, juce::File> pendingFiles;
 
+    // Runs the jobs used to parse desktop entry files:
+    SharedResource::Thread::JobPool parsingPool;
+
     // Maps category names to lists of desktop file IDs.
     std::map<juce::String, juce::StringArray> categories;
 
+    // Indexes all loaded entries for search queries:
+    SearchIndex searchIndex;
+
+    // Saves and restores loaded entry data between application launches:
+    const EntryCache entryCache;
+
+    // Tracks if the entry cache was already read:
+    bool cacheRead = false;
+
+    // Tracks if loaded entry data changed since it was last cached:
+    bool cacheOutdated = false;
+
+    // Wakes the thread when desktop entry files change:
+    EntryWatcher entryWatcher;
+
+    // Writes edited desktop entries to their files:
+    EntryWriter entryWriter;
+
+    // Tracks if the entryWatcher is watching all desktop entry directories:
+    bool watchingDirectories = false;
+
     // Tracks if desktop entries were completely loaded, and aren't currently
     // being updated.
     bool finishedLoading = false;
@@ -210,9 +427,6 @@ private:
 
     // Stored data from the last desktop entry update:
 
-    // The last time desktop entry files were scanned.
-    juce::Time lastScanTime;
-
     // Lists the IDs of all new desktop entry files discovered in the last
     // update scan.
     juce::StringArray lastAddedIDs;
@@ -0,0 +1,372 @@
+#define DESKTOP_ENTRY_IMPLEMENTATION
+#include "DesktopEntry_SearchIndex.h"
+#include <algorithm>
+#include <vector>
+
+// Weights given to words found in each indexed entry field:
+static const constexpr int nameWeight = 8;
+static const constexpr int genericNameWeight = 4;
+static const constexpr int execWeight = 3;
+static const constexpr int keywordWeight = 3;
+static const constexpr int categoryWeight = 2;
+
+// Score multipliers for each type of word match:
+static const constexpr int exactMatchMultiplier = 4;
+static const constexpr int prefixMatchMultiplier = 3;
+static const constexpr int typoMatchMultiplier = 1;
+
+// Minimum query word length where a single typo is allowed:
+static const constexpr int minSingleTypoLength = 4;
+
+// Minimum query word length where two typos are allowed:
+static const constexpr int minDoubleTypoLength = 8;
+
+// Maximum word length compared when checking for typos. Longer words may still
+// match exactly or by prefix.
+static const constexpr int maxTypoWordLength = 32;
+
+/**
+ * @brief  Copies a word's characters into a fixed-size buffer, so typo
+ *         checks can access characters directly without allocating memory.
+ *
+ * @param word    A word to copy.
+ *
+ * @param buffer  A buffer with space for at least maxTypoWordLength
+ *                characters.
+ *
+ * @return        The number of characters copied, or -1 if the word was too
+ *                long to fit in the buffer.
+ */
+static int copyWordChars(const juce::String& word, juce::juce_wchar* buffer)
+{
+    int length = 0;
+    for (juce::String::CharPointerType charPtr = word.getCharPointer();
+            !charPtr.isEmpty(); length++)
+    {
+        if (length == maxTypoWordLength)
+        {
+            return -1;
+        }
+        buffer[length] = charPtr.getAndAdvance();
+    }
+    return length;
+}
+
+/**
+ * @brief  Checks if a query word is within a maximum number of single
+ *         character insertions, deletions, substitutions, or adjacent
+ *         transpositions of any prefix of an indexed word, so that incomplete
+ *         words with typos still match.
+ *
+ * @param first         The query word's characters.
+ *
+ * @param firstLength   The number of characters in the query word.
+ *
+ * @param second        The indexed word's characters.
+ *
+ * @param secondLength  The number of indexed word characters to compare. This
+ *                      should be no more than firstLength + maxEdits, as
+ *                      longer prefixes can't match.
+ *
+ * @param maxEdits      The maximum number of edits allowed.
+ *
+ * @return              Whether the query word is within maxEdits edits of any
+ *                      prefix of the indexed word's compared characters.
+ */
+static bool matchesPrefixWithTypos(const juce::juce_wchar* first,
+        const int firstLength, const juce::juce_wchar* second,
+        const int secondLength, const int maxEdits)
+{
+    if (secondLength < firstLength - maxEdits)
+    {
+        return false;
+    }
+    // Three rows of the edit distance matrix are needed to check
+    // transpositions:
+    int rows[3][maxTypoWordLength + 1];
+    int* lastLastRow = rows[0];
+    int* lastRow = rows[1];
+    int* row = rows[2];
+    for (int j = 0; j <= secondLength; j++)
+    {
+        lastRow[j] = j;
+    }
+    for (int i = 1; i <= firstLength; i++)
+    {
+        row[0] = i;
+        int rowMinimum = row[0];
+        for (int j = 1; j <= secondLength; j++)
+        {
+            const int cost = (first[i - 1] == second[j - 1]) ? 0 : 1;
+            row[j] = std::min({ lastRow[j] + 1, row[j - 1] + 1,
+                    lastRow[j - 1] + cost });
+            if (i > 1 && j > 1 && first[i - 1] == second[j - 2]
+                    && first[i - 2] == second[j - 1])
+            {
+                row[j] = std::min(row[j], lastLastRow[j - 2] + 1);
+            }
+            rowMinimum = std::min(rowMinimum, row[j]);
+        }
+        if (rowMinimum > maxEdits)
+        {
+            return false;
+        }
+        int* const oldestRow = lastLastRow;
+        lastLastRow = lastRow;
+        lastRow = row;
+        row = oldestRow;
+    }
+    for (int j = std::max(0, firstLength - maxEdits); j <= secondLength; j++)
+    {
+        if (lastRow[j] <= maxEdits)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Adds an entry to the index, replacing any indexed data previously added
+// using the same desktop file ID.
+void DesktopEntry::SearchIndex::addEntry
+(const juce::String& entryID, const EntryFile& entry)
+{
+    using juce::String;
+    using juce::StringArray;
+    removeEntry(entryID);
+    // Index each field's words with that field's weight:
+    const std::pair<StringArray, int> fields[] =
+    {
+        { StringArray(entry.getName()), nameWeight },
+        { StringArray(entry.getGenericName()), genericNameWeight },
+        { entry.getKeywords(), keywordWeight },
+        { entry.getCategories(), categoryWeight },
+        {
+            StringArray(entry.getExec().upToFirstOccurrenceOf(" ", false,
+                    false).fromLastOccurrenceOf("/", false, false)),
+            execWeight
+        }
+    };
+    for (const auto& field : fields)
+    {
+        StringArray words;
+        for (const String& fieldText : field.first)
+        {
+            splitWords(fieldText, words);
+        }
+        for (const String& word : words)
+        {
+            indexWord(entryID, word, field.second);
+        }
+    }
+    entryNames[entryID] = entry.getName().toLowerCase();
+}
+
+
+// Removes an entry from the index.
+void DesktopEntry::SearchIndex::removeEntry(const juce::String& entryID)
+{
+    auto wordsIter = entryWords.find(entryID);
+    if (wordsIter == entryWords.end())
+    {
+        return;
+    }
+    for (const juce::String& word : wordsIter->second)
+    {
+        auto entriesIter = wordEntries.find(word);
+        if (entriesIter != wordEntries.end())
+        {
+            entriesIter->second.erase(entryID);
+            if (entriesIter->second.empty())
+            {
+                wordEntries.erase(entriesIter);
+            }
+        }
+    }
+    entryWords.erase(wordsIter);
+    entryNames.erase(entryID);
+}
+
+
+// Removes all entries from the index.
+void DesktopEntry::SearchIndex::clear()
+{
+    wordEntries.clear();
+    entryWords.clear();
+    entryNames.clear();
+}
+
+
+// Finds all indexed entries that match a search query.
+juce::StringArray DesktopEntry::SearchIndex::findEntries
+(const juce::String& query, const int maxResults) const
+{
+    using juce::String;
+    juce::StringArray queryWords;
+    splitWords(query, queryWords);
+    queryWords.removeDuplicates(false);
+    if (queryWords.isEmpty() || maxResults <= 0)
+    {
+        return juce::StringArray();
+    }
+
+    // Only keep entries that match every query word, adding their scores:
+    std::map<String, int> totalScores;
+    for (int i = 0; i < queryWords.size(); i++)
+    {
+        std::map<String, int> wordScores;
+        scoreQueryWord(queryWords[i], wordScores);
+        if (i == 0)
+        {
+            totalScores.swap(wordScores);
+            continue;
+        }
+        for (auto scoreIter = totalScores.begin();
+                scoreIter != totalScores.end();)
+        {
+            auto wordScore = wordScores.find(scoreIter->first);
+            if (wordScore == wordScores.end())
+            {
+                scoreIter = totalScores.erase(scoreIter);
+            }
+            else
+            {
+                scoreIter->second += wordScore->second;
+                scoreIter++;
+            }
+        }
+        if (totalScores.empty())
+        {
+            return juce::StringArray();
+        }
+    }
+
+    // Sort by score, then by name:
+    std::vector<std::pair<int, const String*>> rankedEntries;
+    rankedEntries.reserve(totalScores.size());
+    for (const auto& scoreIter : totalScores)
+    {
+        rankedEntries.push_back({ scoreIter.second, &scoreIter.first });
+    }
+    const int resultCount = std::min<int>(maxResults, rankedEntries.size());
+    std::partial_sort(rankedEntries.begin(),
+            rankedEntries.begin() + resultCount, rankedEntries.end(),
+            [this](const std::pair<int, const String*>& first,
+                const std::pair<int, const String*>& second)
+    {
+        if (first.first != second.first)
+        {
+            return first.first > second.first;
+        }
+        return entryNames.at(*first.second) < entryNames.at(*second.second);
+    });
+    juce::StringArray results;
+    results.ensureStorageAllocated(resultCount);
+    for (int i = 0; i < resultCount; i++)
+    {
+        results.add(*rankedEntries[i].second);
+    }
+    return results;
+}
+
+
+// Splits text into lowercase words, ignoring all characters that aren't
+// letters or digits.
+void DesktopEntry::SearchIndex::splitWords
+(const juce::String& text, juce::StringArray& words)
+{
+    const juce::String lowerText = text.toLowerCase();
+    juce::String::CharPointerType charPtr = lowerText.getCharPointer();
+    juce::String::CharPointerType wordStart = charPtr;
+    int wordLength = 0;
+    for (;;)
+    {
+        const juce::juce_wchar character = *charPtr;
+        if (juce::CharacterFunctions::isLetterOrDigit(character))
+        {
+            if (wordLength == 0)
+            {
+                wordStart = charPtr;
+            }
+            wordLength++;
+        }
+        else if (wordLength > 0)
+        {
+            words.add(juce::String(wordStart, charPtr));
+            wordLength = 0;
+        }
+        if (character == 0)
+        {
+            break;
+        }
+        ++charPtr;
+    }
+}
+
+
+// Adds an indexed word to an entry, or updates its weight if the word was
+// already indexed with a lower weight.
+void DesktopEntry::SearchIndex::indexWord(const juce::String& entryID,
+        const juce::String& word, const int weight)
+{
+    int& savedWeight = wordEntries[word][entryID];
+    if (savedWeight == 0)
+    {
+        entryWords[entryID].add(word);
+    }
+    savedWeight = std::max(savedWeight, weight);
+}
+
+
+// Finds the best scores each indexed entry earns for a single query word.
+void DesktopEntry::SearchIndex::scoreQueryWord(const juce::String& queryWord,
+        std::map<juce::String, int>& scores) const
+{
+    using juce::String;
+    // Updates an entry's score if the new score is higher:
+    const auto addScores = [&scores]
+        (const std::map<String, int>& matchingEntries, const int multiplier)
+    {
+        for (const auto& entryIter : matchingEntries)
+        {
+            int& score = scores[entryIter.first];
+            score = std::max(score, entryIter.second * multiplier);
+        }
+    };
+
+    // Indexed words are sorted, so all words with the query word as a prefix
+    // directly follow the query word's position in the index:
+    for (auto wordIter = wordEntries.lower_bound(queryWord);
+            wordIter != wordEntries.end()
+            && wordIter->first.startsWith(queryWord); wordIter++)
+    {
+        addScores(wordIter->second, (wordIter->first == queryWord)
+                ? exactMatchMultiplier : prefixMatchMultiplier);
+    }
+
+    // Check for typos only if the query word is long enough:
+    juce::juce_wchar queryChars[maxTypoWordLength];
+    const int queryLength = copyWordChars(queryWord, queryChars);
+    if (queryLength < minSingleTypoLength)
+    {
+        return;
+    }
+    const int maxEdits = (queryLength >= minDoubleTypoLength) ? 2 : 1;
+    juce::juce_wchar wordChars[maxTypoWordLength];
+    for (const auto& wordIter : wordEntries)
+    {
+        const int wordLength = copyWordChars(wordIter.first, wordChars);
+        if (wordLength < 0)
+        {
+            continue;
+        }
+        const int comparedLength = std::min(wordLength,
+                queryLength + maxEdits);
+        if (matchesPrefixWithTypos(queryChars, queryLength, wordChars,
+                    comparedLength, maxEdits))
+        {
+            addScores(wordIter.second, typoMatchMultiplier);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef DESKTOP_ENTRY_IMPLEMENTATION
+    #error File included directly outside of DesktopEntry implementation.
+#endif
+#pragma once
+/**
+ * @file  DesktopEntry_SearchIndex.h
+ *
+ * @brief  Indexes desktop entry text so that entries can be quickly found by
+ *         search queries.
+ */
+
+#include "DesktopEntry_EntryFile.h"
+#include <map>
+
+namespace DesktopEntry { class SearchIndex; }
+
+/**
+ * @brief  Maps words found in desktop entry data to the desktop file IDs of
+ *         the entries that contain them, and ranks entries that match search
+ *         queries.
+ *
+ *  Each entry's name, generic name, keywords, categories, and launch command
+ * executable name are split into lowercase words. Each word is stored with the
+ * weight of the most important entry field where it was found, so that entries
+ * matching a query by name rank above entries matching by keyword or category.
+ *
+ *  Query words may match indexed words exactly, as a prefix of an indexed
+ * word, or with a small number of typos. Entries must match every query word
+ * to be included in search results, and results are sorted by their combined
+ * match scores.
+ *
+ *  The LoadingThread updates its SearchIndex whenever entries are added,
+ * changed, or removed. SearchIndex objects are not thread-safe, so they should
+ * only be accessed while holding the LoadingThread's resource lock.
+ */
+class DesktopEntry::SearchIndex
+{
+public:
+    SearchIndex() { }
+
+    virtual ~SearchIndex() { }
+
+    /**
+     * @brief  Adds an entry to the index, replacing any indexed data
+     *         previously added using the same desktop file ID.
+     *
+     * @param entryID  The entry's desktop file ID.
+     *
+     * @param entry    The desktop entry to index.
+     */
+    void addEntry(const juce::String& entryID, const EntryFile& entry);
+
+    /**
+     * @brief  Removes an entry from the index.
+     *
+     * @param entryID  The desktop file ID of an indexed entry.
+     */
+    void removeEntry(const juce::String& entryID);
+
+    /**
+     * @brief  Removes all entries from the index.
+     */
+    void clear();
+
+    /**
+     * @brief  Finds all indexed entries that match a search query.
+     *
+     * @param query       Search text containing one or more words.
+     *
+     * @param maxResults  The maximum number of entry IDs to return.
+     *
+     * @return            The desktop file IDs of matching entries, sorted from
+     *                    the best match to the worst match.
+     */
+    juce::StringArray findEntries(const juce::String& query,
+            const int maxResults) const;
+
+private:
+    /**
+     * @brief  Splits text into lowercase words, ignoring all characters that
+     *         aren't letters or digits.
+     *
+     * @param text   Any text string.
+     *
+     * @param words  An array where all words will be added.
+     */
+    static void splitWords(const juce::String& text, juce::StringArray& words);
+
+    /**
+     * @brief  Adds an indexed word to an entry, or updates its weight if the
+     *         word was already indexed with a lower weight.
+     *
+     * @param entryID  The desktop file ID of the entry being indexed.
+     *
+     * @param word     A lowercase word found in the entry's data.
+     *
+     * @param weight   The weight of the entry field where the word was found.
+     */
+    void indexWord(const juce::String& entryID, const juce::String& word,
+            const int weight);
+
+    /**
+     * @brief  Finds the best scores each indexed entry earns for a single
+     *         query word.
+     *
+     * @param queryWord  A lowercase word from the search query.
+     *
+     * @param scores     A map where each matching entry's desktop file ID will
+     *                   be mapped to its best score for the query word.
+     */
+    void scoreQueryWord(const juce::String& queryWord,
+            std::map<juce::String, int>& scores) const;
+
+    // Maps each indexed word to the desktop file IDs of all entries containing
+    // that word, and the weight the word has within each entry:
+    std::map<juce::String, std::map<juce::String, int>> wordEntries;
+
+    // Maps each indexed desktop file ID to all words indexed for that entry:
+    std::map<juce::String, juce::StringArray> entryWords;
+
+    // Maps each indexed desktop file ID to the entry's lowercase name, used
+    // to sort entries with equal scores:
+    std::map<juce::String, juce::String> entryNames;
+};
@@ -0,0 +1,42 @@
+#pragma once
+/**
+ * @file  DesktopEntry_DataKey.h
+ *
+ * @brief  Defines the DataKey type used to identify standard desktop entry
+ *         data keys.
+ */
+
+namespace DesktopEntry
+{
+    /**
+     * @brief  Lists all data keys defined in the desktop entry specifications.
+     */
+    enum class DataKey
+    {
+        type,
+        version,
+        name,
+        genericName,
+        noDisplay,
+        comment,
+        icon,
+        hidden,
+        onlyShowIn,
+        notShowIn,
+        dBusActivatable,
+        tryExec,
+        exec,
+        path,
+        terminal,
+        actions,
+        mimeType,
+        categories,
+        implements,
+        keywords,
+        startupNotify,
+        startupWMClass,
+        url,
+        // Marks keys not defined in the desktop entry specifications:
+        unknown
+    };
+}
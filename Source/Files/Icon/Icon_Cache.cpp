@@ -1,6 +1,10 @@
 #include "Icon_Cache.h"
 #include <fcntl.h>
 #include <unistd.h>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 #ifdef JUCE_DEBUG
 // Print the full class name before all debug output:
@@ -38,8 +42,8 @@ Icon::Cache::Cache(const juce::String& themePath)
         return;
     }
 
-    fileLen = cacheFile.getSize();
-    if (fileLen <= 0)
+    const juce::int64 cacheFileLen = cacheFile.getSize();
+    if (cacheFileLen <= 0)
     {
         DBG(dbgPrefix << __func__ << ": Cache file is empty, path = "
                 << cachePath);
@@ -62,14 +66,17 @@ Icon::Cache::Cache(const juce::String& themePath)
                 << cachePath);
         return;
     }
-    fileMap = mmap(nullptr, fileLen, PROT_READ, MAP_PRIVATE | MAP_POPULATE,
-            fd, 0);
+    fileMap = mmap(nullptr, cacheFileLen, PROT_READ,
+            MAP_PRIVATE | MAP_POPULATE, fd, 0);
     if (fileMap == MAP_FAILED)
     {
         DBG(dbgPrefix << __func__ << ": Failed to map cache file, path = "
                 << cachePath);
         return;
     }
+    // Only set the file length once the file is mapped, so that read
+    // functions only need to check the file length to ensure reads are valid:
+    fileLen = cacheFileLen;
 
     // Quick method for determining local byte order from
     // https://stackoverflow.com/a/1001330
@@ -110,6 +117,7 @@ Icon::Cache::~Cache()
         int rc = munmap(fileMap, fileLen);
         jassert(rc == 0);
         fileMap = MAP_FAILED;
+        fileLen = 0;
     }
     if (fd > 0)
     {
@@ -129,54 +137,173 @@ bool Icon::Cache::isValidCache() const
 
 
 // Looks up an icon's data in the icon cache.
-std::map<juce::String, juce::String> Icon::Cache::lookupIcon
-(const juce::String& iconName) const
+Icon::Cache::Matches Icon::Cache::lookupIcon(const char* iconName) const
 {
-    using juce::String;
     using juce::uint32;
-    std::map<String, String>  matches;
-    if (!isValidCache())
+    Matches matches;
+    if (!isValidCache() || iconName == nullptr || *iconName == '\0')
     {
         return matches;
     }
-    uint32 hashVal = hashValue(iconName.toRawUTF8());
-    for (uint32 offset = hashOffsets[hashVal];
+    const uint32 hashVal = hashValue(iconName);
+    for (uint32 offset = hashOffsets.getUnchecked((int) hashVal);
         offset > 0 && offset < fileLen;
         offset = read32(offset))
     {
-        String name = readString(read32(offset + 4));
-        if (iconName == name)
+        if (nameMatches(read32(offset + 4), iconName))
         {
-            uint32 imageOffset = read32(offset + 8);
-            uint32 numImg = read32(imageOffset);
-            imageOffset += 4;
-            for (uint32 img = imageOffset;
-                img < (imageOffset + numImg * 8);
-                img += 8)
+            readMatches(read32(offset + 8), iconName, matches);
+            break;
+        }
+    }
+    return matches;
+}
+
+
+// Looks up a set of icons in the icon cache, reading each hash bucket's chain
+// of icon entries only once.
+void Icon::Cache::lookupIcons
+(const juce::StringArray& iconNames, juce::Array<Matches>& results) const
+{
+    using juce::uint32;
+    results.clearQuick();
+    results.insertMultiple(0, Matches(), iconNames.size());
+    if (!isValidCache())
+    {
+        return;
+    }
+    // Pair each icon name's index with its hash bucket, sorted by bucket so
+    // that names sharing a bucket are grouped together:
+    std::vector<std::pair<uint32, int>> bucketNames;
+    bucketNames.reserve(iconNames.size());
+    for (int i = 0; i < iconNames.size(); i++)
+    {
+        if (iconNames[i].isNotEmpty())
+        {
+            bucketNames.push_back(std::make_pair(
+                    hashValue(iconNames[i].toRawUTF8()), i));
+        }
+    }
+    std::sort(bucketNames.begin(), bucketNames.end());
+
+    size_t groupStart = 0;
+    while (groupStart < bucketNames.size())
+    {
+        const uint32 bucket = bucketNames[groupStart].first;
+        size_t groupEnd = groupStart + 1;
+        while (groupEnd < bucketNames.size()
+                && bucketNames[groupEnd].first == bucket)
+        {
+            groupEnd++;
+        }
+        // Walk the bucket's chain once, checking each entry against every
+        // unmatched name in the group. Matched names have their index set to
+        // -1 so they aren't compared again:
+        size_t unmatchedCount = groupEnd - groupStart;
+        for (uint32 offset = hashOffsets.getUnchecked((int) bucket);
+            offset > 0 && offset < fileLen && unmatchedCount > 0;
+            offset = read32(offset))
+        {
+            const uint32 nameOffset = read32(offset + 4);
+            for (size_t i = groupStart; i < groupEnd; i++)
             {
-                juce::uint16 iconFlags = read16(img + 2);
-                String extension;
-                if ((iconFlags & pngExtensionFlag) == pngExtensionFlag)
+                const int nameIndex = bucketNames[i].second;
+                if (nameIndex < 0)
                 {
-                    extension = ".png";
+                    continue;
                 }
-                else if ((iconFlags & xpmExtensionFlag) == xpmExtensionFlag)
+                const char* iconName = iconNames[nameIndex].toRawUTF8();
+                if (nameMatches(nameOffset, iconName))
                 {
-                    extension = ".xpm";
-                }
-                else if ((iconFlags & svgExtensionFlag) == svgExtensionFlag)
-                {
-                    extension = ".svg";
-                }
-                if (extension.isNotEmpty())
-                {
-                    matches[directories[read16(img)]] = extension;
+                    readMatches(read32(offset + 8), iconName,
+                            results.getReference(nameIndex));
+                    bucketNames[i].second = -1;
+                    unmatchedCount--;
                 }
             }
-            break;
         }
+        groupStart = groupEnd;
+    }
+}
+
+
+// Gets all icon theme subdirectories listed in the cache.
+const juce::StringArray& Icon::Cache::getDirectories() const
+{
+    return directories;
+}
+
+
+// Gets the preferred file extension for an icon with a given set of extension
+// flags.
+const char* Icon::Cache::getExtension(const juce::uint16 flags)
+{
+    if ((flags & pngExtensionFlag) == pngExtensionFlag)
+    {
+        return ".png";
+    }
+    if ((flags & xpmExtensionFlag) == xpmExtensionFlag)
+    {
+        return ".xpm";
+    }
+    if ((flags & svgExtensionFlag) == svgExtensionFlag)
+    {
+        return ".svg";
+    }
+    return nullptr;
+}
+
+
+// Checks if the null-terminated string at an offset in the cache file matches
+// an icon name.
+bool Icon::Cache::nameMatches
+(const juce::uint32 nameOffset, const char* iconName) const
+{
+    // Compare names directly within the cache file, checking that the cached
+    // name and its terminator are within the file bounds:
+    const char* fileData = static_cast<const char*>(fileMap);
+    const juce::int64 nameLength = (juce::int64) strlen(iconName);
+    return (nameOffset + nameLength) < fileLen
+            && memcmp(fileData + nameOffset, iconName, nameLength) == 0
+            && fileData[nameOffset + nameLength] == '\0';
+}
+
+
+// Reads the list of directories and extensions stored for a matching icon.
+void Icon::Cache::readMatches(juce::uint32 imageListOffset,
+        const char* iconName, Matches& matches) const
+{
+    using juce::uint32;
+    const uint32 numImg = read32(imageListOffset);
+    const uint32 imageOffset = imageListOffset + 4;
+    int skippedCount = 0;
+    for (uint32 img = imageOffset;
+        img < (imageOffset + numImg * 8) && img < fileLen;
+        img += 8)
+    {
+        const juce::uint16 iconFlags = read16(img + 2);
+        const juce::uint16 dirIndex = read16(img);
+        if (getExtension(iconFlags) == nullptr
+                || dirIndex >= directories.size())
+        {
+            continue;
+        }
+        if (matches.count == Matches::maxMatches)
+        {
+            skippedCount++;
+            continue;
+        }
+        matches.directories[matches.count] = dirIndex;
+        matches.flags[matches.count] = iconFlags;
+        matches.count++;
+    }
+    if (skippedCount > 0)
+    {
+        DBG(dbgPrefix << __func__ << ": Icon " << iconName << " is in "
+                << (matches.count + skippedCount) << " directories, only the "
+                << "first " << Matches::maxMatches << " were recorded.");
+        jassertfalse;
     }
-    return matches;
 }
 
 
@@ -198,12 +325,11 @@ juce::uint32 Icon::Cache::hashValue(const char* icon) const
 
 
 // Reads a two-byte unsigned integer from an arbitrary offset in the cache file,
-// after ensuring that the cache file is valid and the offset is within the file
-// bounds.
+// after ensuring that the offset is within the file bounds.
 juce::uint16 Icon::Cache::read16(juce::uint32 offset) const
 {
     using juce::uint16;
-    if (fileMap == MAP_FAILED || (offset + sizeof(uint16)) > fileLen
+    if ((offset + sizeof(uint16)) > fileLen
         || (offset + sizeof(uint16)) < offset)
     {
         jassertfalse;
@@ -216,12 +342,11 @@ juce::uint16 Icon::Cache::read16(juce::uint32 offset) const
 
 
 // Reads a four-byte unsigned integer from an arbitrary offset in the cache
-// file, after ensuring that the cache file is valid and the offset is within
-// the file bounds.
+// file, after ensuring that the offset is within the file bounds.
 juce::uint32 Icon::Cache::read32(juce::uint32 offset) const
 {
     using juce::uint32;
-    if (fileMap == MAP_FAILED || (offset + sizeof(uint32)) > fileLen
+    if ((offset + sizeof(uint32)) > fileLen
         || (offset + sizeof(uint32)) < offset)
     {
         jassertfalse;
@@ -7,7 +7,6 @@
 
 #include <sys/mman.h>
 #include <arpa/inet.h>
-#include <map>
 #include "JuceHeader.h"
 
 namespace Icon { class Cache; }
@@ -47,18 +46,78 @@ public:
      */
     bool isValidCache() const;
 
+    /**
+     * @brief  Holds the results of an icon cache lookup in a compact,
+     *         fixed-size structure.
+     *
+     *  Each match stores the index of an icon theme subdirectory containing
+     * the icon, and flags describing the file extensions available for the
+     * icon within that directory.
+     */
+    struct Matches
+    {
+        // Maximum number of directories that may be matched for one icon. This
+        // is far more than the number of size directories any icon theme
+        // defines for one icon context. Lookups that find more matches than
+        // this record the first matches, and fail a debug assertion.
+        static const constexpr int maxMatches = 64;
+        // Number of directories matched:
+        int count = 0;
+        // Indices of matching directories, as returned by getDirectories:
+        juce::uint16 directories[maxMatches];
+        // Extension flags for each matching directory:
+        juce::uint16 flags[maxMatches];
+    };
+
     /**
      * @brief  Looks up an icon's data in the icon cache.
      *
+     *  Icon names are compared directly against the mapped cache file data, so
+     * this does not allocate any memory.
+     *
      * @param iconName  The name of a requested icon file, without the file
-     *                  extensions.
+     *                  extensions, as a null-terminated UTF-8 string.
      *
      * @return          All icon theme subdirectories containing this icon,
-     *                  mapped to the first available file extension for the
-     *                  icon within the directory.
+     *                  along with the icon extensions available in each
+     *                  directory.
+     */
+    Matches lookupIcon(const char* iconName) const;
+
+    /**
+     * @brief  Looks up a set of icons in the icon cache in a single pass.
+     *
+     *  Icon names are grouped by hash bucket, and each bucket's chain of icon
+     * entries is read only once, no matter how many requested names share it.
+     *
+     * @param iconNames  The names of all requested icon files, without file
+     *                   extensions.
+     *
+     * @param results    An array where lookup results will be stored, in the
+     *                   same order as the iconNames array. Any existing array
+     *                   contents will be replaced.
+     */
+    void lookupIcons(const juce::StringArray& iconNames,
+            juce::Array<Matches>& results) const;
+
+    /**
+     * @brief  Gets all icon theme subdirectories listed in the cache.
+     *
+     * @return  All directory paths, relative to the theme directory. Directory
+     *          indices stored in Matches objects are indices in this array.
+     */
+    const juce::StringArray& getDirectories() const;
+
+    /**
+     * @brief  Gets the preferred file extension for an icon with a given set
+     *         of extension flags.
+     *
+     * @param flags  Extension flags from a Matches object.
+     *
+     * @return       The preferred file extension, or nullptr if the flags
+     *               don't include a valid image file extension.
      */
-    std::map<juce::String, juce::String> lookupIcon
-    (const juce::String& iconName) const;
+    static const char* getExtension(const juce::uint16 flags);
 
 private:
     /**
@@ -71,10 +130,39 @@ private:
      */
     juce::uint32 hashValue(const char* icon) const;
 
+    /**
+     * @brief  Checks if the null-terminated string at an offset in the cache
+     *         file matches an icon name, without copying the cached string.
+     *
+     * @param nameOffset  The offset in bytes of a cached icon name.
+     *
+     * @param iconName    A null-terminated icon name to compare.
+     *
+     * @return            Whether the cached name is within the file bounds and
+     *                    matches iconName.
+     */
+    bool nameMatches(const juce::uint32 nameOffset, const char* iconName)
+        const;
+
+    /**
+     * @brief  Reads the list of directories and extensions stored for a
+     *         matching icon.
+     *
+     * @param imageListOffset  The offset in bytes of the icon's image list.
+     *
+     * @param iconName         The matching icon's name, used for debug output.
+     *
+     * @param matches          The object where directory indices and extension
+     *                         flags will be stored.
+     */
+    void readMatches(juce::uint32 imageListOffset, const char* iconName,
+            Matches& matches) const;
+
     /**
      * @brief  Reads a two-byte unsigned integer from an arbitrary offset in
-     *         the cache file, after ensuring that the cache file is valid and
-     *         the offset is within the file bounds.
+     *         the cache file, after ensuring that the offset is within the file
+     *         bounds. The file length is always zero if the cache file isn't
+     *         mapped, so this also prevents reads from invalid caches.
      *
      * @param offset  The offset in bytes from the beginning of the cache file.
      *
@@ -86,8 +174,9 @@ private:
 
     /**
      * @brief  Reads a four-byte unsigned integer from an arbitrary offset in
-     *         the cache file, after ensuring that the cache file is valid and
-     *         the offset is within the file bounds.
+     *         the cache file, after ensuring that the offset is within the file
+     *         bounds. The file length is always zero if the cache file isn't
+     *         mapped, so this also prevents reads from invalid caches.
      *
      * @param offset  The offset in bytes from the beginning of the cache file.
      *
@@ -117,14 +206,14 @@ private:
     // Pointer to the memory-mapped cache file data:
     void* fileMap = MAP_FAILED;
 
-    // Length of the cache file in bytes:
+    // Length of the cache file in bytes, or zero if no file is mapped:
     juce::int64 fileLen = 0;
 
     // Number of hash buckets used to store hashed icon data in the file:
     juce::uint32 hashBuckets = 0;
 
     // All icon directory sub-paths within the icon theme directory:
-    juce::Array<juce::String> directories;
+    juce::StringArray directories;
 
     // The index of each hash bucket within the cache file:
     juce::Array<juce::uint32> hashOffsets;
@@ -0,0 +1,147 @@
+#include "Icon_ImageCache.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Icon::ImageCache::";
+#endif
+
+// Creates an empty image cache.
+Icon::ImageCache::ImageCache(const juce::int64 byteLimit)
+{
+    stats.byteLimit = byteLimit;
+}
+
+
+Icon::ImageCache::~ImageCache()
+{
+    DBG(dbgPrefix << __func__ << ": " << stats.hits << " hits, "
+            << stats.misses << " misses, " << stats.evictions
+            << " evictions, " << stats.imageCount << " images using "
+            << stats.byteSize << "/" << stats.byteLimit << " bytes.");
+    clear();
+}
+
+
+// Gets a cached icon image, marking it as the most recently used image.
+juce::Image Icon::ImageCache::getImage
+(const juce::String& iconName, const int size)
+{
+    auto mapIter = entryMap.find({ iconName, size });
+    if (mapIter == entryMap.end())
+    {
+        stats.misses++;
+        return juce::Image();
+    }
+    stats.hits++;
+    entries.splice(entries.begin(), entries, mapIter->second);
+    return mapIter->second->image;
+}
+
+
+// Adds an icon image to the cache, removing least recently used images if the
+// cache's byte limit is exceeded.
+void Icon::ImageCache::addImage
+(const juce::String& iconName, const int size, const juce::Image image)
+{
+    if (image.isNull())
+    {
+        return;
+    }
+    const CacheKey key = { iconName, size };
+    const juce::int64 imageBytes = getImageBytes(image);
+    auto mapIter = entryMap.find(key);
+    if (mapIter != entryMap.end())
+    {
+        stats.byteSize -= mapIter->second->byteSize;
+        entries.erase(mapIter->second);
+        entryMap.erase(mapIter);
+    }
+    if (imageBytes > stats.byteLimit)
+    {
+        // Never cache images that can't fit within the cache:
+        stats.imageCount = (int) entries.size();
+        return;
+    }
+    entries.push_front({ key, image, imageBytes });
+    entryMap[key] = entries.begin();
+    stats.byteSize += imageBytes;
+    stats.imageCount = (int) entries.size();
+    evictImages();
+}
+
+
+// Removes all cached images with a given icon name or path.
+void Icon::ImageCache::removeImages(const juce::String& iconName)
+{
+    auto mapIter = entryMap.lower_bound({ iconName, 0 });
+    while (mapIter != entryMap.end() && mapIter->first.iconName == iconName)
+    {
+        stats.byteSize -= mapIter->second->byteSize;
+        entries.erase(mapIter->second);
+        mapIter = entryMap.erase(mapIter);
+    }
+    stats.imageCount = (int) entries.size();
+}
+
+
+// Removes all images from the cache.
+void Icon::ImageCache::clear()
+{
+    entryMap.clear();
+    entries.clear();
+    stats.byteSize = 0;
+    stats.imageCount = 0;
+}
+
+
+// Changes the maximum number of bytes of image data the cache may store,
+// removing least recently used images if necessary.
+void Icon::ImageCache::setByteLimit(const juce::int64 newLimit)
+{
+    stats.byteLimit = newLimit;
+    evictImages();
+}
+
+
+// Gets the current cache statistics.
+Icon::ImageCache::Statistics Icon::ImageCache::getStatistics() const
+{
+    return stats;
+}
+
+
+// Sorts cache keys by icon name, then by size.
+bool Icon::ImageCache::CacheKey::operator<(const CacheKey& rhs) const
+{
+    const int nameComparison = iconName.compare(rhs.iconName);
+    if (nameComparison != 0)
+    {
+        return nameComparison < 0;
+    }
+    return size < rhs.size;
+}
+
+
+// Removes least recently used images until the cached image size is within the
+// cache byte limit.
+void Icon::ImageCache::evictImages()
+{
+    while (stats.byteSize > stats.byteLimit && !entries.empty())
+    {
+        const CacheEntry& oldest = entries.back();
+        stats.byteSize -= oldest.byteSize;
+        entryMap.erase(oldest.key);
+        entries.pop_back();
+        stats.evictions++;
+    }
+    stats.imageCount = (int) entries.size();
+}
+
+
+// Estimates the amount of memory used by an image's pixel data.
+juce::int64 Icon::ImageCache::getImageBytes(const juce::Image& image)
+{
+    const juce::int64 bytesPerPixel = image.isARGB() ? 4
+            : (image.isRGB() ? 3 : 1);
+    return (juce::int64) image.getWidth() * image.getHeight() * bytesPerPixel;
+}
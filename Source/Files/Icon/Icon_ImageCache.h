@@ -0,0 +1,162 @@
+#pragma once
+/**
+ * @file  Icon_ImageCache.h
+ *
+ * @brief  Stores loaded icon images within a limited memory budget.
+ */
+
+#include "JuceHeader.h"
+#include <list>
+#include <map>
+
+namespace Icon { class ImageCache; }
+
+/**
+ * @brief  Holds recently loaded icon images, mapped by icon name and
+ *         requested size.
+ *
+ *  Images are only shared between requests for the exact same icon size, so a
+ * cached image is never returned to a request that would need to scale it up.
+ * When the total size of all cached image data exceeds the cache's byte limit,
+ * the least recently used images are removed from the cache.
+ *
+ *  ImageCache objects are not thread-safe. Icon::ThreadResource only accesses
+ * its cache while its resource lock is held for writing.
+ */
+class Icon::ImageCache
+{
+public:
+    /**
+     * @brief  Creates an empty image cache.
+     *
+     * @param byteLimit  The maximum number of bytes of image data to store
+     *                   within the cache.
+     */
+    ImageCache(const juce::int64 byteLimit);
+
+    virtual ~ImageCache();
+
+    /**
+     * @brief  Gets a cached icon image, marking it as the most recently used
+     *         image.
+     *
+     * @param iconName  The name or path of a requested icon.
+     *
+     * @param size      The width and height the icon will be drawn at, in
+     *                  physical pixels. This is the requested icon size
+     *                  multiplied by the requested scale factor.
+     *
+     * @return          The cached image, or a null Image if no matching image
+     *                  is cached.
+     */
+    juce::Image getImage(const juce::String& iconName, const int size);
+
+    /**
+     * @brief  Adds an icon image to the cache, removing least recently used
+     *         images if the cache's byte limit is exceeded.
+     *
+     * @param iconName  The name or path of the loaded icon.
+     *
+     * @param size      The width and height the icon was rendered at, in
+     *                  physical pixels. This is the requested icon size
+     *                  multiplied by the requested scale factor.
+     *
+     * @param image     The loaded icon image.
+     */
+    void addImage(const juce::String& iconName, const int size,
+            const juce::Image image);
+
+    /**
+     * @brief  Removes all cached images with a given icon name or path.
+     *
+     * @param iconName  The name or path of a cached icon.
+     */
+    void removeImages(const juce::String& iconName);
+
+    /**
+     * @brief  Removes all images from the cache.
+     */
+    void clear();
+
+    /**
+     * @brief  Changes the maximum number of bytes of image data the cache may
+     *         store, removing least recently used images if necessary.
+     *
+     * @param newLimit  The new cache size limit, in bytes.
+     */
+    void setByteLimit(const juce::int64 newLimit);
+
+    /**
+     * @brief  Describes the current cache state and cache usage since the
+     *         cache was created.
+     */
+    struct Statistics
+    {
+        // Number of getImage calls that found a cached image:
+        juce::int64 hits = 0;
+        // Number of getImage calls that didn't find a cached image:
+        juce::int64 misses = 0;
+        // Number of images removed to stay within the byte limit:
+        juce::int64 evictions = 0;
+        // Number of images currently cached:
+        int imageCount = 0;
+        // Total bytes of image data currently cached:
+        juce::int64 byteSize = 0;
+        // Maximum bytes of image data that may be cached:
+        juce::int64 byteLimit = 0;
+    };
+
+    /**
+     * @brief  Gets the current cache statistics.
+     *
+     * @return  The cache's size, limit, and usage counters.
+     */
+    Statistics getStatistics() const;
+
+private:
+    /**
+     * @brief  Identifies a cached image by icon name and rendered size, in
+     *         physical pixels.
+     */
+    struct CacheKey
+    {
+        juce::String iconName;
+        int size;
+
+        bool operator<(const CacheKey& rhs) const;
+    };
+
+    /**
+     * @brief  Holds a cached image and the key used to find it.
+     */
+    struct CacheEntry
+    {
+        CacheKey key;
+        juce::Image image;
+        juce::int64 byteSize;
+    };
+
+    /**
+     * @brief  Removes least recently used images until the cached image size
+     *         is within the cache byte limit.
+     */
+    void evictImages();
+
+    /**
+     * @brief  Estimates the amount of memory used by an image's pixel data.
+     *
+     * @param image  A loaded icon image.
+     *
+     * @return       The approximate image size, in bytes.
+     */
+    static juce::int64 getImageBytes(const juce::Image& image);
+
+    // Cached images, ordered from most to least recently used:
+    std::list<CacheEntry> entries;
+
+    // Maps cache keys to their positions in the entry list:
+    std::map<CacheKey, std::list<CacheEntry>::iterator> entryMap;
+
+    // Cache size, limit, and usage counters:
+    Statistics stats;
+};
@@ -10,7 +10,8 @@ Icon::RequestID Icon::Loader::loadIcon(
         const int size,
         const std::function<void(juce::Image)> assignImage,
         const Context context,
-        const int scale)
+        const int scale,
+        const Priority priority)
 {
     SharedResource::LockedPtr<ThreadResource> iconThread
             = getWriteLockedResource();
@@ -20,12 +21,40 @@ Icon::RequestID Icon::Loader::loadIcon(
         size,
         scale,
         context,
-        assignImage
+        assignImage,
+        priority
     };
     return iconThread->addRequest(newJob);
 }
 
 
+// Loads an icon into the shared icon image cache before it is needed.
+Icon::RequestID Icon::Loader::prefetchIcon(
+        const juce::String icon,
+        const int size,
+        const Context context,
+        const int scale)
+{
+    if (icon.isEmpty() || size <= 0)
+    {
+        return 0;
+    }
+    // The loaded image only needs to be cached, so the callback does nothing:
+    return loadIcon(icon, size, [](juce::Image iconImage) { }, context, scale,
+            Priority::background);
+}
+
+
+// Changes the priority of a pending image assignment.
+void Icon::Loader::setRequestPriority
+(const RequestID requestID, const Priority newPriority)
+{
+    SharedResource::LockedPtr<ThreadResource> iconThread
+            = getWriteLockedResource();
+    iconThread->setRequestPriority(requestID, newPriority);
+}
+
+
 // Cancels a pending image assignment.
 void Icon::Loader::cancelImageRequest(const RequestID toCancel)
 {
@@ -35,3 +64,10 @@ void Icon::Loader::cancelImageRequest(const RequestID toCancel)
 }
 
 
+// Gets the size, limit, and usage statistics of the shared icon image cache.
+Icon::ImageCache::Statistics Icon::Loader::getCacheStatistics() const
+{
+    SharedResource::LockedPtr<const ThreadResource> iconThread
+            = getReadLockedResource();
+    return iconThread->getCacheStatistics();
+}
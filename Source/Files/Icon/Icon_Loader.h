@@ -8,6 +8,8 @@
 #include "SharedResource_Handler.h"
 #include "Icon_RequestID.h"
 #include "Icon_Context.h"
+#include "Icon_Priority.h"
+#include "Icon_ImageCache.h"
 
 namespace Icon { class Loader; }
 namespace Icon { class ThreadResource; }
@@ -53,6 +55,9 @@ public:
      *                       object. This value is typically only relevant on
      *                       extra high resolution displays.
      *
+     * @param priority       Sets how urgently the icon is needed. Pending
+     *                       requests are handled in order of priority.
+     *
      * @return               A CallbackID value that can be used to cancel the
      *                       image assignment
      */
@@ -61,12 +66,62 @@ public:
             const int size,
             const std::function<void(juce::Image)> assignImage,
             const Context context = Context::unknown,
+            const int scale = 1,
+            const Priority priority = Priority::visible);
+
+    /**
+     * @brief  Loads an icon into the shared icon image cache before it is
+     *         needed, so that later requests for the icon can be fulfilled
+     *         immediately.
+     *
+     *  Prefetch requests use the background priority, so they are only handled
+     * once no other icon requests are pending. Prefetching an icon that is
+     * already cached has no effect. Like all other requests, prefetched icons
+     * are found and loaded on the icon thread, including icons requested by
+     * absolute path.
+     *
+     * @param icon     The full path or name of an icon file.
+     *
+     * @param size     The width and height, in pixels, that the icon will be
+     *                 requested at when it is needed.
+     *
+     * @param context  The context that will be used when the icon is requested.
+     *
+     * @param scale    The scale factor that will be used when the icon is
+     *                 requested.
+     *
+     * @return         An ID that may be passed to cancelImageRequest if the
+     *                 icon is no longer likely to be needed, or zero if the
+     *                 icon was already cached or couldn't be requested.
+     */
+    RequestID prefetchIcon(
+            const juce::String icon,
+            const int size,
+            const Context context = Context::unknown,
             const int scale = 1);
 
+    /**
+     * @brief  Changes the priority of a pending image assignment.
+     *
+     * @param requestID    The ID of a pending icon request.
+     *
+     * @param newPriority  The new priority to apply to the request.
+     */
+    void setRequestPriority(const RequestID requestID,
+            const Priority newPriority);
+
     /**
      * @brief  Cancels a pending image assignment.
      *
      * @param toCancel  The callback ID of the assignment function to cancel.
      */
     void cancelImageRequest(const RequestID toCancel);
+
+    /**
+     * @brief  Gets the size, limit, and usage statistics of the shared icon
+     *         image cache.
+     *
+     * @return  The current image cache statistics.
+     */
+    ImageCache::Statistics getCacheStatistics() const;
 };
@@ -0,0 +1,311 @@
+#include "Icon_LookupIndex.h"
+#include "Assets_XDGDirectories.h"
+#include <map>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Icon::LookupIndex::";
+#endif
+
+// Directory within the user's cache directory where index files are saved:
+static const constexpr char* indexDirectory = "/pocket-home/icon-index/";
+
+// Extension used for all index files:
+static const constexpr char* indexExtension = ".index";
+
+// Marks the start of every valid index file:
+static const constexpr int indexMagic = 0x50484949; // "PHII"
+
+// Index file format version. Increment this whenever the index file format
+// changes, so that old index files are rebuilt instead of misread.
+static const constexpr int indexVersion = 1;
+
+// Icon file extension flags. These match the flag values used by Icon::Cache
+// objects reading GTK icon cache files:
+static const constexpr juce::uint16 xpmExtensionFlag = 1;
+static const constexpr juce::uint16 svgExtensionFlag = 2;
+static const constexpr juce::uint16 pngExtensionFlag = 4;
+
+/**
+ * @brief  Gets the current modification time of a theme directory.
+ *
+ * @param themePath  The path to an icon theme directory.
+ *
+ * @return           The directory's modification time in milliseconds since
+ *                   the Unix epoch, or 0 if the directory doesn't exist.
+ */
+static juce::int64 getThemeModTime(const juce::String& themePath)
+{
+    const juce::File themeDir(themePath);
+    if (!themeDir.isDirectory())
+    {
+        return 0;
+    }
+    return themeDir.getLastModificationTime().toMilliseconds();
+}
+
+
+// Creates an index object for an icon theme directory without loading or
+// building index data.
+Icon::LookupIndex::LookupIndex(const juce::String& themePath) :
+themePath(themePath) { }
+
+
+// Checks if this object holds index data.
+bool Icon::LookupIndex::isValidIndex() const
+{
+    return indexedModTime != 0;
+}
+
+
+// Ensures that the index is loaded and up to date, loading the saved index file
+// or rebuilding and saving it if necessary.
+void Icon::LookupIndex::update
+(const juce::StringArray& themeDirectories, const bool forceRebuild)
+{
+    const juce::int64 modTime = getThemeModTime(themePath);
+    if (modTime == 0 || (modTime == indexedModTime && !forceRebuild))
+    {
+        return;
+    }
+    if (!forceRebuild && readIndexFile(modTime))
+    {
+        DBG(dbgPrefix << __func__ << ": Loaded " << iconOffsets.size()
+                << " indexed icons for theme " << themePath);
+        return;
+    }
+    buildIndex(themeDirectories, modTime);
+    DBG(dbgPrefix << __func__ << ": Indexed " << iconOffsets.size()
+            << " icons for theme " << themePath);
+    if (!writeIndexFile())
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to save index file "
+                << getIndexFile().getFullPathName());
+    }
+}
+
+
+// Looks up an icon's data in the index.
+Icon::Cache::Matches Icon::LookupIndex::lookupIcon
+(const juce::String& iconName) const
+{
+    Cache::Matches matches;
+    if (!isValidIndex() || !iconOffsets.contains(iconName))
+    {
+        return matches;
+    }
+    const int listOffset = iconOffsets[iconName];
+    const int matchCount = std::min<int>(matchData[listOffset],
+            Cache::Matches::maxMatches);
+    if (matchCount < (int) matchData[listOffset])
+    {
+        DBG(dbgPrefix << __func__ << ": Icon " << iconName << " is in "
+                << (int) matchData[listOffset] << " directories, only the "
+                << "first " << matchCount << " were recorded.");
+        jassertfalse;
+    }
+    for (int i = 0; i < matchCount; i++)
+    {
+        const juce::uint32 match = matchData[listOffset + 1 + i];
+        matches.directories[i] = (juce::uint16) (match >> 16);
+        matches.flags[i] = (juce::uint16) (match & 0xffff);
+    }
+    matches.count = matchCount;
+    return matches;
+}
+
+
+// Gets all icon theme subdirectories listed in the index.
+const juce::StringArray& Icon::LookupIndex::getDirectories() const
+{
+    return directories;
+}
+
+
+// Gets the file where this theme's index data is saved.
+juce::File Icon::LookupIndex::getIndexFile() const
+{
+    return juce::File(Assets::XDGDirectories::getUserCachePath()
+            + indexDirectory
+            + juce::String::toHexString(themePath.hashCode64())
+            + indexExtension);
+}
+
+
+// Loads index data from the saved index file, if it exists and matches the
+// current theme directory modification time.
+bool Icon::LookupIndex::readIndexFile(const juce::int64 modTime)
+{
+    using juce::String;
+    const juce::File indexFile = getIndexFile();
+    juce::MemoryBlock fileData;
+    if (!indexFile.existsAsFile() || !indexFile.loadFileAsData(fileData))
+    {
+        return false;
+    }
+    juce::MemoryInputStream input(fileData, false);
+    if (input.readInt() != indexMagic || input.readInt() != indexVersion
+            || input.readString() != themePath
+            || input.readInt64() != modTime)
+    {
+        DBG(dbgPrefix << __func__ << ": Index file for theme " << themePath
+                << " is outdated or invalid.");
+        return false;
+    }
+
+    juce::StringArray indexedDirs;
+    juce::HashMap<String, int> indexedOffsets;
+    juce::Array<juce::uint32> indexedMatches;
+
+    const int dirCount = input.readInt();
+    for (int i = 0; i < dirCount && !input.isExhausted(); i++)
+    {
+        indexedDirs.add(input.readString());
+    }
+    const int iconCount = input.readInt();
+    for (int i = 0; i < iconCount && !input.isExhausted(); i++)
+    {
+        const String iconName = input.readString();
+        const int matchCount = input.readInt();
+        if (matchCount <= 0 || matchCount > dirCount)
+        {
+            return false;
+        }
+        indexedOffsets.set(iconName, indexedMatches.size());
+        indexedMatches.add((juce::uint32) matchCount);
+        for (int m = 0; m < matchCount; m++)
+        {
+            const juce::uint32 match = (juce::uint32) input.readInt();
+            if ((int) (match >> 16) >= dirCount)
+            {
+                return false;
+            }
+            indexedMatches.add(match);
+        }
+    }
+    if (indexedOffsets.size() != iconCount)
+    {
+        DBG(dbgPrefix << __func__ << ": Index file for theme " << themePath
+                << " is incomplete.");
+        return false;
+    }
+
+    directories.swapWith(indexedDirs);
+    iconOffsets.swapWith(indexedOffsets);
+    matchData.swapWith(indexedMatches);
+    indexedModTime = modTime;
+    return true;
+}
+
+
+// Scans all theme directories for icon files, replacing any existing index
+// data.
+void Icon::LookupIndex::buildIndex
+(const juce::StringArray& themeDirectories, const juce::int64 modTime)
+{
+    using juce::String;
+    using juce::File;
+    using juce::uint32;
+    static const std::map<String, juce::uint16> extensionFlags =
+    {
+        {".png", pngExtensionFlag},
+        {".svg", svgExtensionFlag},
+        {".xpm", xpmExtensionFlag}
+    };
+
+    // Collect each icon's matches, grouped by icon name:
+    std::map<String, juce::Array<uint32>> iconMatches;
+    directories.clearQuick();
+    for (const String& dirPath : themeDirectories)
+    {
+        const File iconDir(themePath + "/" + dirPath);
+        if (!iconDir.isDirectory())
+        {
+            continue;
+        }
+        // Holds extension flags for each icon in this directory:
+        std::map<String, juce::uint16> dirIcons;
+        for (juce::DirectoryIterator iter(iconDir, false, "*",
+                    File::findFiles); iter.next();)
+        {
+            const File iconFile = iter.getFile();
+            auto flagIter = extensionFlags.find(iconFile.getFileExtension());
+            if (flagIter != extensionFlags.end())
+            {
+                dirIcons[iconFile.getFileNameWithoutExtension()]
+                        |= flagIter->second;
+            }
+        }
+        if (dirIcons.empty())
+        {
+            continue;
+        }
+        const uint32 dirIndex = (uint32) directories.size();
+        directories.add(dirPath);
+        for (const auto& iconEntry : dirIcons)
+        {
+            iconMatches[iconEntry.first].add((dirIndex << 16)
+                    | iconEntry.second);
+        }
+    }
+
+    // Flatten match lists into the matchData array:
+    iconOffsets.clear();
+    matchData.clearQuick();
+    for (const auto& iconEntry : iconMatches)
+    {
+        iconOffsets.set(iconEntry.first, matchData.size());
+        matchData.add((uint32) iconEntry.second.size());
+        matchData.addArray(iconEntry.second);
+    }
+    indexedModTime = modTime;
+}
+
+
+// Saves all index data to the index file.
+bool Icon::LookupIndex::writeIndexFile() const
+{
+    const juce::File indexFile = getIndexFile();
+    if (!indexFile.getParentDirectory().createDirectory())
+    {
+        return false;
+    }
+    // Write to a temporary file first, so that partially written index files
+    // are never read:
+    juce::TemporaryFile tempFile(indexFile);
+    {
+        juce::FileOutputStream output(tempFile.getFile());
+        if (output.failedToOpen())
+        {
+            return false;
+        }
+        output.writeInt(indexMagic);
+        output.writeInt(indexVersion);
+        output.writeString(themePath);
+        output.writeInt64(indexedModTime);
+        output.writeInt(directories.size());
+        for (const juce::String& dir : directories)
+        {
+            output.writeString(dir);
+        }
+        output.writeInt(iconOffsets.size());
+        for (juce::HashMap<juce::String, int>::Iterator iter(iconOffsets);
+                iter.next();)
+        {
+            const int listOffset = iter.getValue();
+            const int matchCount = (int) matchData[listOffset];
+            output.writeString(iter.getKey());
+            output.writeInt(matchCount);
+            for (int i = listOffset + 1; i <= listOffset + matchCount; i++)
+            {
+                output.writeInt((int) matchData[i]);
+            }
+        }
+        output.flush();
+        if (output.getStatus().failed())
+        {
+            return false;
+        }
+    }
+    return tempFile.overwriteTargetFileWithTemporary();
+}
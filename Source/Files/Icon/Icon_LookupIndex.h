@@ -0,0 +1,153 @@
+#pragma once
+/**
+ * @file  Icon_LookupIndex.h
+ *
+ * @brief  Builds and stores pocket-home's own icon lookup index for icon themes
+ *         that lack a valid GTK icon cache file.
+ */
+
+#include "Icon_Cache.h"
+#include "JuceHeader.h"
+
+namespace Icon { class LookupIndex; }
+
+/**
+ * @brief  Maps icon names to the icon theme directories and file extensions
+ *         where those icons can be found.
+ *
+ *  LookupIndex objects serve as a replacement for GTK's icon-theme.cache files
+ * when a theme's cache file is missing or out of date. Without an index, every
+ * icon search would need to check for each possible icon file in each theme
+ * directory. The LookupIndex instead scans each theme directory once, and saves
+ * the results as a binary index file within the user's XDG cache directory.
+ *
+ *  Saved index files store the modification time of the theme directory they
+ * describe. When the theme directory modification time changes, the index is
+ * considered outdated and should be rebuilt.
+ */
+class Icon::LookupIndex
+{
+public:
+    /**
+     * @brief  Creates an index object for an icon theme directory without
+     *         loading or building index data.
+     *
+     * @param themePath  The absolute path of an icon theme directory.
+     */
+    LookupIndex(const juce::String& themePath);
+
+    /**
+     * @brief  Creates an empty, invalid index object.
+     */
+    LookupIndex() { }
+
+    virtual ~LookupIndex() { }
+
+    /**
+     * @brief  Checks if this object holds index data.
+     *
+     *  This does not check whether the theme directory has changed since the
+     * index data was created. The update function should be used to ensure
+     * that index data is current.
+     *
+     * @return  Whether index data was loaded or built.
+     */
+    bool isValidIndex() const;
+
+    /**
+     * @brief  Ensures that the index is loaded and up to date, loading the
+     *         saved index file or rebuilding and saving it if necessary.
+     *
+     *  This may need to scan every listed theme directory, so it should not be
+     * called on the message thread.
+     *
+     * @param themeDirectories  All icon subdirectory paths defined in the
+     *                          theme's index.theme file, relative to the
+     *                          theme directory.
+     *
+     * @param forceRebuild      Whether the index should be rebuilt even if the
+     *                          theme directory's modification time hasn't
+     *                          changed. This should be used when files change
+     *                          within theme subdirectories.
+     */
+    void update(const juce::StringArray& themeDirectories,
+            const bool forceRebuild = false);
+
+    /**
+     * @brief  Looks up an icon's data in the index.
+     *
+     * @param iconName  The name of a requested icon file, without the file
+     *                  extension.
+     *
+     * @return          All icon theme subdirectories containing this icon,
+     *                  along with the icon extensions available in each
+     *                  directory, using the same format as Icon::Cache lookup
+     *                  results.
+     */
+    Cache::Matches lookupIcon(const juce::String& iconName) const;
+
+    /**
+     * @brief  Gets all icon theme subdirectories listed in the index.
+     *
+     * @return  All directory paths, relative to the theme directory. Directory
+     *          indices stored in lookup results are indices in this array.
+     */
+    const juce::StringArray& getDirectories() const;
+
+private:
+    /**
+     * @brief  Gets the file where this theme's index data is saved.
+     *
+     * @return  The index file within the user's cache directory.
+     */
+    juce::File getIndexFile() const;
+
+    /**
+     * @brief  Loads index data from the saved index file, if it exists and
+     *         matches the current theme directory modification time.
+     *
+     * @param modTime  The current theme directory modification time, in
+     *                 milliseconds since the Unix epoch.
+     *
+     * @return         Whether valid index data was loaded.
+     */
+    bool readIndexFile(const juce::int64 modTime);
+
+    /**
+     * @brief  Scans all theme directories for icon files, replacing any
+     *         existing index data.
+     *
+     * @param themeDirectories  All icon subdirectory paths defined by the
+     *                          theme.
+     *
+     * @param modTime           The current theme directory modification time.
+     */
+    void buildIndex(const juce::StringArray& themeDirectories,
+            const juce::int64 modTime);
+
+    /**
+     * @brief  Saves all index data to the index file.
+     *
+     * @return  Whether the index file was successfully written.
+     */
+    bool writeIndexFile() const;
+
+    // The path to the theme's base directory:
+    juce::String themePath;
+
+    // The theme directory modification time when the index was created, or 0
+    // if no index data has been loaded:
+    juce::int64 indexedModTime = 0;
+
+    // All indexed theme subdirectory paths, relative to the theme directory:
+    juce::StringArray directories;
+
+    // Maps each icon name to the position of its match list within the
+    // matchData array.
+    juce::HashMap<juce::String, int> iconOffsets;
+
+    // Holds all icon match lists. Each list starts with its match count,
+    // followed by one value per match, holding a directory index in its upper
+    // 16 bits and extension flags in its lower 16 bits.
+    juce::Array<juce::uint32> matchData;
+};
@@ -0,0 +1,373 @@
+#include "Icon_RasterCache.h"
+#include "Assets_XDGDirectories.h"
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Icon::RasterCache::";
+#endif
+
+// Directory within the user's cache directory where images are saved:
+static const constexpr char* rasterDirectory = "/pocket-home/icon-images/";
+
+// Name of the file within the cache directory that stores image use times:
+static const constexpr char* usageIndexName = "usage.index";
+
+// Extension used for all cached image files:
+static const constexpr char* rasterExtension = ".argb";
+
+// Marks the start of every valid cached image file:
+static const constexpr juce::uint32 rasterMagic = 0x50484952; // "PHIR"
+
+// Cached image file format version:
+static const constexpr juce::uint32 rasterVersion = 1;
+
+// Number of bytes used to store each image pixel:
+static const constexpr int bytesPerPixel = 4;
+
+// Maximum total size of all cached image files, in bytes:
+static const constexpr juce::int64 maxCacheBytes = 16 * 1024 * 1024;
+
+/**
+ * @brief  The header placed at the start of each cached image file. The source
+ *         path string follows the header, followed by the image's premultiplied
+ *         ARGB pixel data in rows from top to bottom.
+ *
+ *  Cached files are only read on the system that writes them, so header values
+ * are stored in native byte order.
+ */
+struct RasterHeader
+{
+    juce::uint32 magic;
+    juce::uint32 version;
+    juce::int32 width;
+    juce::int32 height;
+    juce::int64 sourceModTime;
+    juce::uint32 pathLength;
+};
+
+Icon::RasterCache::RasterCache() :
+cacheDirectory(Assets::XDGDirectories::getUserCachePath() + rasterDirectory)
+{ }
+
+
+// Saves all recorded image use times to the usage index file.
+Icon::RasterCache::~RasterCache()
+{
+    saveUsageIndex();
+}
+
+
+// Loads a cached icon image.
+juce::Image Icon::RasterCache::loadImage
+(const juce::String& sourcePath, const int size)
+{
+    using juce::Image;
+    const juce::File sourceFile(sourcePath);
+    const juce::int64 modTime
+            = sourceFile.getLastModificationTime().toMilliseconds();
+    const juce::File cacheFile = getCacheFile(sourcePath, modTime, size);
+    const juce::int64 fileLen = cacheFile.getSize();
+    if (fileLen < (juce::int64) sizeof(RasterHeader))
+    {
+        return Image();
+    }
+
+    const int fd = open(cacheFile.getFullPathName().toRawUTF8(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return Image();
+    }
+    void* fileMap = mmap(nullptr, fileLen, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (fileMap == MAP_FAILED)
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to map cached image "
+                << cacheFile.getFullPathName());
+        return Image();
+    }
+
+    Image image;
+    const char* fileData = static_cast<const char*>(fileMap);
+    RasterHeader header;
+    memcpy(&header, fileData, sizeof(RasterHeader));
+    const juce::int64 pixelOffset = sizeof(RasterHeader) + header.pathLength;
+    const juce::int64 pixelBytes = (juce::int64) header.width * header.height
+            * bytesPerPixel;
+    const bool headerValid = header.magic == rasterMagic
+            && header.version == rasterVersion
+            && header.sourceModTime == modTime
+            && header.width > 0 && header.height > 0
+            && (pixelOffset + pixelBytes) == fileLen
+            && juce::String::fromUTF8(fileData + sizeof(RasterHeader),
+                    (int) header.pathLength) == sourcePath;
+    if (headerValid)
+    {
+        // Record that the file was used, so pruning keeps it:
+        {
+            const juce::ScopedLock usageLock(usageGuard);
+            unsavedUseTimes[cacheFile.getFileName()]
+                    = juce::Time::currentTimeMillis();
+        }
+        image = Image(Image::ARGB, header.width, header.height, false,
+                juce::SoftwareImageType());
+        Image::BitmapData bitmap(image, Image::BitmapData::writeOnly);
+        const char* pixelRow = fileData + pixelOffset;
+        const size_t rowBytes = (size_t) header.width * bytesPerPixel;
+        for (int y = 0; y < header.height; y++)
+        {
+            memcpy(bitmap.getLinePointer(y), pixelRow, rowBytes);
+            pixelRow += rowBytes;
+        }
+    }
+    else
+    {
+        DBG(dbgPrefix << __func__ << ": Ignoring invalid cached image "
+                << cacheFile.getFullPathName());
+    }
+    munmap(fileMap, fileLen);
+    return image;
+}
+
+
+// Saves an icon image to the cache, replacing any existing cached image with
+// the same source path and size.
+bool Icon::RasterCache::saveImage
+(const juce::String& sourcePath, const int size, const juce::Image& image)
+        const
+{
+    using juce::Image;
+    if (image.isNull())
+    {
+        return false;
+    }
+    const juce::File sourceFile(sourcePath);
+    const juce::int64 modTime
+            = sourceFile.getLastModificationTime().toMilliseconds();
+    const juce::File cacheFile = getCacheFile(sourcePath, modTime, size);
+    if (!cacheFile.getParentDirectory().createDirectory())
+    {
+        return false;
+    }
+
+    const Image argbImage = image.convertedToFormat(Image::ARGB);
+    const Image::BitmapData bitmap(argbImage, Image::BitmapData::readOnly);
+    if (bitmap.pixelStride != bytesPerPixel)
+    {
+        return false;
+    }
+    const char* pathData = sourcePath.toRawUTF8();
+    const RasterHeader header =
+    {
+        rasterMagic,
+        rasterVersion,
+        argbImage.getWidth(),
+        argbImage.getHeight(),
+        modTime,
+        (juce::uint32) sourcePath.getNumBytesAsUTF8()
+    };
+
+    // Write to a temporary file first, so that partially written images are
+    // never read:
+    juce::TemporaryFile tempFile(cacheFile);
+    {
+        juce::FileOutputStream output(tempFile.getFile());
+        if (output.failedToOpen())
+        {
+            return false;
+        }
+        output.write(&header, sizeof(RasterHeader));
+        output.write(pathData, header.pathLength);
+        const size_t rowBytes = (size_t) header.width * bytesPerPixel;
+        for (int y = 0; y < header.height; y++)
+        {
+            output.write(bitmap.getLinePointer(y), rowBytes);
+        }
+        output.flush();
+        if (output.getStatus().failed())
+        {
+            return false;
+        }
+    }
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+
+// Deletes outdated cached images, then deletes the least recently used cached
+// images until the cache fits within its size limit.
+void Icon::RasterCache::pruneCache()
+{
+    using juce::File;
+    juce::Array<File> cacheFiles;
+    File(cacheDirectory).findChildFiles(cacheFiles, File::findFiles, false,
+            juce::String("*") + rasterExtension);
+
+    std::map<juce::String, juce::int64> useTimes = readUsageIndex();
+    {
+        const juce::ScopedLock usageLock(usageGuard);
+        for (const auto& useTime : unsavedUseTimes)
+        {
+            useTimes[useTime.first] = useTime.second;
+        }
+        unsavedUseTimes.clear();
+    }
+
+    // Pair each valid file with its last use time. Files that were never used
+    // are dated by when they were saved:
+    std::vector<std::pair<juce::int64, File>> validFiles;
+    juce::int64 totalSize = 0;
+    int outdatedCount = 0;
+    for (const File& cacheFile : cacheFiles)
+    {
+        if (isOutdated(cacheFile))
+        {
+            cacheFile.deleteFile();
+            outdatedCount++;
+            continue;
+        }
+        totalSize += cacheFile.getSize();
+        const auto useTime = useTimes.find(cacheFile.getFileName());
+        validFiles.push_back(std::make_pair(useTime != useTimes.end()
+                    ? useTime->second
+                    : cacheFile.getLastModificationTime().toMilliseconds(),
+                    cacheFile));
+    }
+
+    size_t evictedCount = 0;
+    if (totalSize > maxCacheBytes)
+    {
+        std::sort(validFiles.begin(), validFiles.end(),
+                [](const std::pair<juce::int64, File>& first,
+                    const std::pair<juce::int64, File>& second)
+                {
+                    return first.first < second.first;
+                });
+        while (evictedCount < validFiles.size() && totalSize > maxCacheBytes)
+        {
+            const File& evictedFile = validFiles[evictedCount].second;
+            totalSize -= evictedFile.getSize();
+            evictedFile.deleteFile();
+            evictedCount++;
+        }
+    }
+
+    // Only keep use times for images that remain cached:
+    std::map<juce::String, juce::int64> remainingUseTimes;
+    for (size_t i = evictedCount; i < validFiles.size(); i++)
+    {
+        remainingUseTimes[validFiles[i].second.getFileName()]
+                = validFiles[i].first;
+    }
+    writeUsageIndex(remainingUseTimes);
+    DBG(dbgPrefix << __func__ << ": Removed " << outdatedCount
+            << " outdated and " << (int) evictedCount
+            << " unused cached images, "
+            << totalSize << " bytes remain cached.");
+}
+
+
+// Checks if a cached image file no longer matches its icon file.
+bool Icon::RasterCache::isOutdated(const juce::File& cacheFile) const
+{
+    juce::FileInputStream input(cacheFile);
+    RasterHeader header;
+    if (input.failedToOpen()
+            || input.read(&header, sizeof(RasterHeader))
+                != (int) sizeof(RasterHeader)
+            || header.magic != rasterMagic
+            || header.version != rasterVersion
+            || header.pathLength > (juce::uint32) input.getNumBytesRemaining())
+    {
+        return true;
+    }
+    juce::MemoryBlock pathData;
+    input.readIntoMemoryBlock(pathData, header.pathLength);
+    const juce::File sourceFile(juce::String::fromUTF8(
+                static_cast<const char*>(pathData.getData()),
+                (int) pathData.getSize()));
+    return !sourceFile.existsAsFile()
+            || sourceFile.getLastModificationTime().toMilliseconds()
+                != header.sourceModTime;
+}
+
+
+// Gets the file where a cached icon image is stored.
+juce::File Icon::RasterCache::getCacheFile(const juce::String& sourcePath,
+        const juce::int64 modTime, const int size) const
+{
+    const juce::String cacheKey = sourcePath + ":" + juce::String(modTime)
+            + ":" + juce::String(size);
+    return juce::File(cacheDirectory
+            + juce::String::toHexString(cacheKey.hashCode64())
+            + rasterExtension);
+}
+
+
+// Saves all image use times recorded since the usage index file was last
+// saved.
+void Icon::RasterCache::saveUsageIndex()
+{
+    std::map<juce::String, juce::int64> newUseTimes;
+    {
+        const juce::ScopedLock usageLock(usageGuard);
+        newUseTimes.swap(unsavedUseTimes);
+    }
+    if (newUseTimes.empty())
+    {
+        return;
+    }
+    std::map<juce::String, juce::int64> useTimes = readUsageIndex();
+    for (const auto& useTime : newUseTimes)
+    {
+        useTimes[useTime.first] = useTime.second;
+    }
+    writeUsageIndex(useTimes);
+}
+
+
+// Reads image use times from the usage index file.
+std::map<juce::String, juce::int64> Icon::RasterCache::readUsageIndex() const
+{
+    std::map<juce::String, juce::int64> useTimes;
+    juce::StringArray indexLines;
+    juce::File(cacheDirectory + usageIndexName).readLines(indexLines);
+    for (const juce::String& line : indexLines)
+    {
+        const int separator = line.indexOfChar(' ');
+        if (separator > 0)
+        {
+            useTimes[line.substring(0, separator)]
+                    = line.substring(separator + 1).getLargeIntValue();
+        }
+    }
+    return useTimes;
+}
+
+
+// Replaces the contents of the usage index file.
+void Icon::RasterCache::writeUsageIndex
+(const std::map<juce::String, juce::int64>& useTimes) const
+{
+    const juce::File indexFile(cacheDirectory + usageIndexName);
+    if (!indexFile.getParentDirectory().createDirectory())
+    {
+        return;
+    }
+    juce::String indexText;
+    for (const auto& useTime : useTimes)
+    {
+        indexText << useTime.first << " " << useTime.second << "\n";
+    }
+    juce::TemporaryFile tempFile(indexFile);
+    if (!tempFile.getFile().replaceWithText(indexText)
+            || !tempFile.overwriteTargetFileWithTemporary())
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to save usage index "
+                << indexFile.getFullPathName());
+    }
+}
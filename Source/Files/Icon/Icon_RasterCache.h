@@ -0,0 +1,144 @@
+#pragma once
+/**
+ * @file  Icon_RasterCache.h
+ *
+ * @brief  Saves loaded and scaled icon images to the user's cache directory,
+ *         so that they can be reloaded without decoding image files.
+ */
+
+#include "JuceHeader.h"
+#include <map>
+
+namespace Icon { class RasterCache; }
+
+/**
+ * @brief  Stores pre-scaled icon images as raw ARGB pixel data files within
+ *         the user's XDG cache directory.
+ *
+ *  Each cached image file is identified by the path of the icon file it was
+ * loaded from, the modification time of that icon file, and the size the icon
+ * was scaled to. When an icon file changes, its old cached images are ignored,
+ * as they will no longer match the icon file's modification time.
+ *
+ *  Cached image files are mapped to memory when read, and their pixel data is
+ * copied directly into new Image objects, skipping all image decoding and
+ * scaling. RasterCache objects may be used from multiple threads at once.
+ *
+ *  Each time a cached image is loaded, its use time is recorded in memory.
+ * Recorded use times are only written to disk in a single usage index file,
+ * when the cache is pruned or the RasterCache is destroyed. Calling
+ * pruneCache deletes cached images whose icon files changed or were removed,
+ * then deletes the least recently used images until the cache directory fits
+ * within a fixed size limit.
+ */
+class Icon::RasterCache
+{
+public:
+    RasterCache();
+
+    /**
+     * @brief  Saves all recorded image use times to the usage index file.
+     */
+    virtual ~RasterCache();
+
+    /**
+     * @brief  Loads a cached icon image.
+     *
+     * @param sourcePath  The full path of the icon file the image was loaded
+     *                    from.
+     *
+     * @param size        The width and height the icon was scaled to fit, in
+     *                    pixels.
+     *
+     * @return            The cached image, or a null Image if no valid cached
+     *                    image exists.
+     */
+    juce::Image loadImage(const juce::String& sourcePath, const int size);
+
+    /**
+     * @brief  Saves an icon image to the cache, replacing any existing cached
+     *         image with the same source path and size.
+     *
+     * @param sourcePath  The full path of the icon file the image was loaded
+     *                    from.
+     *
+     * @param size        The width and height the icon was scaled to fit, in
+     *                    pixels.
+     *
+     * @param image       The loaded and scaled icon image.
+     *
+     * @return            Whether the image was successfully saved.
+     */
+    bool saveImage(const juce::String& sourcePath, const int size,
+            const juce::Image& image) const;
+
+    /**
+     * @brief  Deletes outdated cached images, then deletes the least recently
+     *         used cached images until the cache fits within its size limit.
+     *
+     *  This reads the header of every cached image file, so it should only be
+     * called occasionally, and never on the message thread. Use times of all
+     * remaining images are saved to the usage index file.
+     */
+    void pruneCache();
+
+    /**
+     * @brief  Saves all image use times recorded since the usage index file
+     *         was last saved.
+     */
+    void saveUsageIndex();
+
+private:
+    /**
+     * @brief  Checks if a cached image file no longer matches its icon file.
+     *
+     * @param cacheFile  A cached image file.
+     *
+     * @return           Whether the cached file is invalid, or its icon file
+     *                   was removed or changed since the image was cached.
+     */
+    bool isOutdated(const juce::File& cacheFile) const;
+
+    /**
+     * @brief  Gets the file where a cached icon image is stored.
+     *
+     * @param sourcePath  The full path of an icon file.
+     *
+     * @param modTime     The icon file's modification time, in milliseconds
+     *                    since the Unix epoch.
+     *
+     * @param size        The cached image's scaled size, in pixels.
+     *
+     * @return            The cached image file.
+     */
+    juce::File getCacheFile(const juce::String& sourcePath,
+            const juce::int64 modTime, const int size) const;
+
+    /**
+     * @brief  Reads image use times from the usage index file.
+     *
+     * @return  The last time each cached image was used, in milliseconds
+     *          since the Unix epoch, mapped by cached image file name.
+     */
+    std::map<juce::String, juce::int64> readUsageIndex() const;
+
+    /**
+     * @brief  Replaces the contents of the usage index file.
+     *
+     * @param useTimes  The last time each cached image was used, in
+     *                  milliseconds since the Unix epoch, mapped by cached
+     *                  image file name.
+     */
+    void writeUsageIndex(const std::map<juce::String, juce::int64>& useTimes)
+        const;
+
+    // The directory where cached images are saved:
+    const juce::String cacheDirectory;
+
+    // Guards access to recorded image use times:
+    juce::CriticalSection usageGuard;
+
+    // Times cached images were loaded since the usage index was last saved, in
+    // milliseconds since the Unix epoch, mapped by cached image file name:
+    std::map<juce::String, juce::int64> unsavedUseTimes;
+};
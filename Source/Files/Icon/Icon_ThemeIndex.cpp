@@ -12,7 +12,8 @@ static const constexpr char* indexFileName = "/index.theme";
 // Creates a new ThemeIndex for a single icon theme directory.
 Icon::ThemeIndex::ThemeIndex(juce::File themeDir) :
 path(themeDir.getFullPathName()),
-cacheFile(themeDir.getFullPathName())
+cacheFile(themeDir.getFullPathName()),
+lookupIndex(themeDir.getFullPathName())
 {
     using juce::String;
     using juce::StringArray;
@@ -203,6 +204,38 @@ bool Icon::ThemeIndex::isValidTheme() const
 }
 
 
+// If the theme has no valid GTK icon cache file, ensures that the theme's
+// LookupIndex is loaded and up to date.
+void Icon::ThemeIndex::updateLookupIndex(const bool forceRebuild)
+{
+    if (!isValidTheme() || cacheFile.isValidCache())
+    {
+        return;
+    }
+    lookupIndex.update(getSubdirectories(), forceRebuild);
+}
+
+
+// Gets the path of the icon theme's base directory.
+juce::String Icon::ThemeIndex::getPath() const
+{
+    return path;
+}
+
+
+// Gets all icon directories defined by the theme.
+juce::StringArray Icon::ThemeIndex::getSubdirectories() const
+{
+    juce::StringArray dirPaths;
+    for (auto dirIter = directories.begin(); dirIter != directories.end();
+            dirIter++)
+    {
+        dirPaths.add(dirIter->first);
+    }
+    return dirPaths;
+}
+
+
 // Finds the path of an icon within the theme, matching an icon name, size,
 // scale factor, and context.
 juce::String Icon::ThemeIndex::lookupIcon
@@ -216,40 +249,61 @@ juce::String Icon::ThemeIndex::lookupIcon
 
     juce::Array<IconDirectory> searchDirs;
 
-    std::map<String, String> cacheMatches;
-    cacheMatches = cacheFile.lookupIcon(icon);
-    if (!cacheMatches.empty())
+    // Prefer the theme's GTK icon cache, falling back to the LookupIndex if
+    // the cache is missing or invalid:
+    Cache::Matches cacheMatches;
+    const juce::StringArray* matchedDirs = nullptr;
+    if (cacheFile.isValidCache())
+    {
+        cacheMatches = cacheFile.lookupIcon(icon.toRawUTF8());
+        matchedDirs = &cacheFile.getDirectories();
+    }
+    else if (lookupIndex.isValidIndex())
+    {
+        cacheMatches = lookupIndex.lookupIcon(icon);
+        matchedDirs = &lookupIndex.getDirectories();
+    }
+
+    if (cacheMatches.count > 0)
     {
-        for (auto it = cacheMatches.begin(); it != cacheMatches.end(); it++)
+        for (int i = 0; i < cacheMatches.count; i++)
         {
-            try
+            const String& dirPath = (*matchedDirs)[cacheMatches.directories[i]];
+            const char* extension = Cache::getExtension(cacheMatches.flags[i]);
+            auto dirIter = directories.find(dirPath);
+            if (dirIter != directories.end())
             {
-                searchDirs.add(directories.at(it->first));
+                IconDirectory matchedDir = dirIter->second;
+                matchedDir.extension = extension;
+                searchDirs.add(matchedDir);
             }
-            catch(std::out_of_range e)
+            else
             {
                 // A directory referenced in the theme's icon cache file wasn't
                 // defined in the theme's index file, add it as an undefined
                 // IconDirectory.
                 DBG(dbgPrefix << __func__ << ": Cached directory \""
-                        << it->first << "\" is not present in the \""
+                        << dirPath << "\" is not present in the \""
                         << getName() << "\" theme index file, "
                         << "adding it as an undefined IconDirectory.");
                 IconDirectory undefinedDir;
-                undefinedDir.path = it->first;
+                undefinedDir.path = dirPath;
                 undefinedDir.undefined = true;
+                undefinedDir.extension = extension;
                 searchDirs.add(undefinedDir);
             }
         }
     }
-    else if (cacheFile.isValidCache())
+    else if (matchedDirs != nullptr)
     {
-        // Cache is valid and doesn't contain the icon, so stop looking.
+        // Cache or index is valid and doesn't contain the icon, so stop
+        // looking.
         return String();
     }
     else
     {
-        // Cache is invalid, so we'll need to search all possible directories.
+        // No valid cache or index exists, so we'll need to search all possible
+        // directories.
         for (auto dirIter = directories.begin(); dirIter != directories.end();
             dirIter++)
         {
@@ -267,24 +321,17 @@ juce::String Icon::ThemeIndex::lookupIcon
     for (const IconDirectory& dir : searchDirs)
     {
         String filePath = path + "/" + dir.path + "/" + icon;
-        try
+        if (dir.extension != nullptr)
         {
-            String extension = cacheMatches.at(dir.path);
-            if (juce::File(filePath + extension).existsAsFile())
+            if (juce::File(filePath + dir.extension).existsAsFile())
             {
-                return filePath + extension;
+                return filePath + dir.extension;
             }
-            else
-            {
-                DBG(dbgPrefix << __func__ << ": Cached file is missing: "
-                        << filePath << extension);
-            }
-        }
-        catch(std::out_of_range e)
-        {
-            // File extensions not found, continue on to check all possible
-            // extensions:
+            DBG(dbgPrefix << __func__ << ": Cached file is missing: "
+                    << filePath << dir.extension);
         }
+        // File extensions not found, continue on to check all possible
+        // extensions:
         static const juce::StringArray extensions = {".png", ".svg", ".xpm"};
         for (const String& ext : extensions)
         {
@@ -6,6 +6,7 @@
  */
 
 #include "Icon_Cache.h"
+#include "Icon_LookupIndex.h"
 #include "Icon_Context.h"
 #include "JuceHeader.h"
 #include <map>
@@ -43,6 +44,18 @@ public:
      */
     bool isValidTheme() const;
 
+    /**
+     * @brief  If the theme has no valid GTK icon cache file, ensures that the
+     *         theme's LookupIndex is loaded and up to date.
+     *
+     *  If the index needs to be rebuilt, this will scan all theme directories,
+     * so it should only be called from the icon thread.
+     *
+     * @param forceRebuild  Whether the index should be rebuilt even if the
+     *                      theme directory hasn't been modified.
+     */
+    void updateLookupIndex(const bool forceRebuild = false);
+
     /**
      * @brief  Defines the different size types for icon directories.
      */
@@ -80,6 +93,21 @@ public:
     juce::String lookupIcon(juce::String icon, int size,
             Context context = Context::unknown, int scale = 1) const;
 
+    /**
+     * @brief  Gets the path of the icon theme's base directory.
+     *
+     * @return  The theme directory path, or the empty string if the theme is
+     *          invalid.
+     */
+    juce::String getPath() const;
+
+    /**
+     * @brief  Gets all icon directories defined by the theme.
+     *
+     * @return  All icon directory paths, relative to the theme directory.
+     */
+    juce::StringArray getSubdirectories() const;
+
     /**
      * @brief  Gets the name of the icon theme.
      *
@@ -140,6 +168,10 @@ private:
         // found in the theme's index file. IconDirectories listed in the index
         // file will always be preferred over undefined directories.
         bool undefined = false;
+
+        // The preferred file extension of a requested icon within this
+        // directory, if known from the icon cache or lookup index:
+        const char* extension = nullptr;
     };
 
     /**
@@ -221,6 +253,8 @@ private:
     juce::String example;
     // Accesses the theme's cache file, if one exists:
     Cache cacheFile;
+    // Replaces the cache file if it is missing or invalid:
+    LookupIndex lookupIndex;
     // All icon sub-directories in the theme, indexed by relative path name:
     std::map<juce::String, IconDirectory> directories;
 };
@@ -1,5 +1,6 @@
 #include "Icon_ThreadResource.h"
 #include "Theme_Image_ConfigFile.h"
+#include "Config_MainFile.h"
 #include "Assets_XDGDirectories.h"
 #include "Assets.h"
 
@@ -44,8 +45,36 @@ static const constexpr char* fallbackTheme = "hicolor";
 static const constexpr char* pocketHomeIconPath
         = "/usr/share/pocket-home/icons";
 
+// Maximum number of worker threads used to load icons:
+static const constexpr int maxWorkerThreads = 4;
+
+// Maximum number of icon requests to load at once:
+static const constexpr int maxLoadingJobs = 16;
+
+// Milliseconds to wait for loading jobs before checking if the icon thread
+// should exit:
+static const constexpr int jobWaitMilliseconds = 100;
+
+// Number of bytes in each kilobyte of the configurable image cache size:
+static const constexpr juce::int64 bytesPerKB = 1024;
+
+/**
+ * @brief  Gets the path of the file where the icon theme is stored.
+ *
+ * @return  The full path to the iconThemeFile in the user's home directory.
+ */
+static juce::String getGtkSettingPath()
+{
+    return juce::String(getenv("HOME")) + "/" + iconThemeFile;
+}
+
 Icon::ThreadResource::ThreadResource() :
-SharedResource::Thread::Resource(resourceKey, ::threadName)
+// The icon thread blocks while waiting for icon file changes, so it can't
+// share the thread resource pool:
+SharedResource::Thread::Resource(resourceKey, ::threadName, false),
+loadingPool(juce::jlimit(1, maxWorkerThreads,
+            juce::SystemStats::getNumCpus())),
+loadedImageCache(bytesPerKB * Config::MainFile().getIconCacheSize())
 {
     using juce::StringArray;
     using juce::String;
@@ -70,80 +99,12 @@ SharedResource::Thread::Resource(resourceKey, ::threadName)
     iconDirectories.addArray(dataDirs);
     iconDirectories.add(pixmapIconPath);
     iconDirectories.add(pocketHomeIconPath);
-
-    // Find the icon themes to use and store them sorted from highest to lowest
-    // priority:
-    StringArray themeNames;
-    StringArray themeSettings;
-    String gtkSettingPath(homePath + "/" + iconThemeFile);
-    File(gtkSettingPath).readLines(themeSettings);
-    for (const String& line : themeSettings)
-    {
-        int divider = line.indexOfChar('=');
-        if (divider != -1)
-        {
-            String key = line.substring(0, divider);
-            if (key == iconThemeKey || key == backupThemeKey)
-            {
-                themeNames.add(line.substring(divider + 1).unquoted());
-                if (themeNames.size() > 1)
-                {
-                    break;
-                }
-            }
-        }
-    }
-    themeNames.add(fallbackTheme);
-
-    // Create theme index objects for the user's icon theme and all inherited
-    // or fallback themes:
-    for (int i = 0; i < themeNames.size(); i++)
-    {
-        for (const String& dir : iconDirectories)
-        {
-            File themeDir(dir + (dir.endsWithChar('/') ? "" : "/")
-                    + themeNames[i]);
-            if (themeDir.isDirectory())
-            {
-                iconThemes.add(new ThemeIndex(themeDir));
-                if (iconThemes.getLast()->isValidTheme())
-                {
-                    StringArray inherited = iconThemes.getLast()
-                            ->getInheritedThemes();
-                    int insertParentIdx = i + 1;
-                    for (const String& parent : inherited)
-                    {
-                        if (!themeNames.contains(parent))
-                        {
-                            themeNames.insert(insertParentIdx, parent);
-                            insertParentIdx++;
-                        }
-                    }
-                    break;
-                }
-                else
-                {
-                    iconThemes.removeLast();
-                }
-            }
-        }
-    }
-    #ifdef JUCE_DEBUG
-    String dbgThemeNames;
-    for (ThemeIndex* theme : iconThemes)
-    {
-        if (dbgThemeNames.isNotEmpty())
-        {
-            dbgThemeNames += ", ";
-        }
-        dbgThemeNames += theme->getName();
-    }
-    DBG(dbgPrefix << __func__ << ": Loaded icon themes: " << dbgThemeNames);
-    #endif
 }
 
 Icon::ThreadResource::~ThreadResource()
 {
+    loadingPool.removeAllJobs();
+    activeJobs.clear();
     loadedImageCache.clear();
 }
 
@@ -155,6 +116,18 @@ void Icon::ThreadResource::cancelRequest(const RequestID requestID)
 }
 
 
+// Changes the priority of a pending icon request.
+void Icon::ThreadResource::setRequestPriority
+(const RequestID requestID, const Priority newPriority)
+{
+    auto requestIter = requestMap.find(requestID);
+    if (requestIter != requestMap.end())
+    {
+        requestIter->second.priority = newPriority;
+    }
+}
+
+
 // Adds an icon loading request to the queue.
 Icon::RequestID Icon::ThreadResource::addRequest(IconRequest request)
 {
@@ -166,13 +139,14 @@ Icon::RequestID Icon::ThreadResource::addRequest(IconRequest request)
     {
         return 0;
     }
-    // First, attempt to load the icon from the loaded image cache or assets.
-    Image preLoadedIcon;
-    if (request.icon[0] == '/')
-    {
-        preLoadedIcon = Assets::loadImageAsset(request.icon);
-    }
-    if (preLoadedIcon.isNull())
+    // Cached images are stored by the size they're rendered at, so requests
+    // with different scale factors never share images:
+    const int pixelSize = request.size * request.scale;
+    // First, attempt to load the icon from the loaded image cache. Icon files
+    // given by absolute path are loaded on the icon thread like any other
+    // icon, so they're never decoded on the message thread.
+    Image preLoadedIcon = loadedImageCache.getImage(request.icon, pixelSize);
+    if (preLoadedIcon.isNull() && request.icon[0] != '/')
     {
         //if icon is a partial path, trim it
         if (request.icon.contains("/"))
@@ -180,11 +154,7 @@ Icon::RequestID Icon::ThreadResource::addRequest(IconRequest request)
             request.icon = request.icon.substring
                 (1 + request.icon.lastIndexOf("/"));
         }
-        if (loadedImageCache.contains(request.icon))
-        {
-            preLoadedIcon = loadedImageCache[request.icon];
-            jassert(preLoadedIcon.isValid());
-        }
+        preLoadedIcon = loadedImageCache.getImage(request.icon, pixelSize);
     }
     if (preLoadedIcon.isValid()) // Icon already found, apply now.
     {
@@ -214,9 +184,12 @@ Icon::RequestID Icon::ThreadResource::addRequest(IconRequest request)
 
         // Send the request to the icon loading thread, unless it has tried and
         // failed to find this icon in the past:
-        if (missingIcons.contains(request.icon))
         {
-            return 0;
+            const juce::ScopedLock missingLock(missingIconGuard);
+            if (missingIcons.contains(request.icon))
+            {
+                return 0;
+            }
         }
 
         static RequestID newID = 0;
@@ -232,109 +205,283 @@ Icon::RequestID Icon::ThreadResource::addRequest(IconRequest request)
         else //Ensure thread isn't sleeping
         {
             notify();
+            loadingEvent.signal();
+            fileWatcher.wake();
         }
         return newID;
     }
 }
 
 
+// Loads all icon themes and starts watching icon directories the first time
+// the thread starts.
+void Icon::ThreadResource::init(SharedResource::Thread::Lock& lock)
+{
+    // The theme list is only accessed from the icon thread, so no locking is
+    // needed here.
+    if (iconThemes == nullptr)
+    {
+        iconThemes = loadIconThemes();
+        watchIconDirectories();
+    }
+    if (!rasterCachePruned)
+    {
+        rasterCache.pruneCache();
+        rasterCachePruned = true;
+    }
+}
+
+
+// Gets the size, limit, and usage statistics of the loaded icon image cache.
+Icon::ImageCache::Statistics Icon::ThreadResource::getCacheStatistics() const
+{
+    return loadedImageCache.getStatistics();
+}
+
+
 // Asynchronously handles queued icon requests.
 void Icon::ThreadResource::runLoop(SharedResource::Thread::Lock& lock)
 {
     using juce::Image;
     using juce::String;
-    using std::function;
-    lock.enterRead();
-    RequestID requestID = requestMap.begin()->first;
-    IconRequest firstRequest = requestMap[requestID];
-    lock.exitRead();
 
-    String icon = firstRequest.icon;
-    String iconPath = getIconPath(firstRequest);
-    if (iconPath.isNotEmpty())
+    // Start loading pending requests in order of priority until the loading
+    // pool is full. Requests for an icon that is already loading are added to
+    // its job, and requests for icons loaded since they were added are
+    // resolved from the image cache.
+    // Apply icon file changes first, so that requests are never handled using
+    // outdated images or themes:
+    checkFileChanges(lock);
+    reloadChangedThemes(lock);
+
+    juce::OwnedArray<LoadingJob> loadingJobs;
+    lock.enterWrite();
+    for (int priority = (int) Priority::visible;
+            priority <= (int) Priority::background; priority++)
     {
-        // Loading svg files into drawable components requires the message
-        // thread to be locked.
-        Image iconImg;
+        for (auto requestIter = requestMap.begin();
+                requestIter != requestMap.end(); requestIter++)
         {
-            const juce::MessageManagerLock mmLock((juce::Thread*) this);
-            if (!mmLock.lockWasGained())
+            const IconRequest& request = requestIter->second;
+            if ((int) request.priority != priority
+                    || isLoading(requestIter->first))
+            {
+                continue;
+            }
+            LoadingJob* matchingJob = findMatchingJob(request, activeJobs);
+            if (matchingJob == nullptr)
+            {
+                matchingJob = findMatchingJob(request, loadingJobs);
+            }
+            if (matchingJob == nullptr)
             {
-                DBG(dbgPrefix << __func__
-                        << ":: Exiting, stop instead of loading icon \""
-                        << icon << "\"");
-                return;
+                const Image cachedImage = loadedImageCache.getImage(
+                        request.icon, request.size * request.scale);
+                if (cachedImage.isValid())
+                {
+                    matchingJob = loadingJobs.add(new LoadingJob(*this,
+                                request));
+                    matchingJob->setCachedImage(cachedImage);
+                }
+                else if (activeJobs.size() < maxLoadingJobs)
+                {
+                    matchingJob = activeJobs.add(new LoadingJob(*this,
+                                request));
+                    loadingPool.addJob(matchingJob);
+                }
             }
-            iconImg = Assets::loadImageAsset(iconPath);
-            if (iconImg.isNull())
+            if (matchingJob != nullptr)
             {
-                DBG(dbgPrefix << __func__ << ": Unable to load icon " << icon);
-                return;
+                matchingJob->addRequestID(requestIter->first);
             }
         }
+    }
+    lock.exitWrite();
+
+    // With no requests to handle, sleep until an icon file changes or a new
+    // request is added:
+    if (loadingJobs.isEmpty() && activeJobs.isEmpty())
+    {
+        if (fileWatcher.isValid())
+        {
+            fileWatcher.waitForChanges();
+        }
+        return;
+    }
 
-        lock.enterWrite();
-        loadedImageCache.set(icon, iconImg);
-        lock.exitWrite();
+    // Unless cached images are ready, wait until a job finishes or a new
+    // request is added:
+    while (loadingJobs.isEmpty() && !activeJobs.isEmpty()
+            && !loadingEvent.wait(jobWaitMilliseconds))
+    {
+        if (threadShouldExit())
+        {
+            DBG(dbgPrefix << __func__
+                    << ": Exiting, cancelling icon loading jobs.");
+            loadingPool.removeAllJobs();
+            activeJobs.clear();
+            return;
+        }
+    }
 
-        // If callback wasn't removed, lock the message thread, check again
-        // that it's still there, run the callback, and remove it from the map.
+    // Handle every job that finished, leaving the rest running:
+    for (int i = 0; i < activeJobs.size();)
+    {
+        if (activeJobs[i]->isFinished())
+        {
+            // The pool may still hold the job for a moment after it finishes:
+            loadingPool.waitForJobToFinish(activeJobs[i], -1);
+            loadingJobs.add(activeJobs.removeAndReturn(i));
+        }
+        else
+        {
+            i++;
+        }
+    }
+    if (loadingJobs.isEmpty())
+    {
+        return;
+    }
+
+    // Cache all loaded images, and stop searching for missing icons. Results
+    // from jobs that used replaced icon themes may be outdated, so they aren't
+    // saved:
+    lock.enterWrite();
+    for (LoadingJob* job : loadingJobs)
+    {
+        if (job->loadedFromCache() || !job->usesThemes(iconThemes))
+        {
+            continue;
+        }
+        if (job->getImage().isValid())
+        {
+            const IconRequest& request = job->getRequest();
+            loadedImageCache.addImage(request.icon,
+                    request.size * request.scale, job->getImage());
+        }
+        else
+        {
+            DBG(dbgPrefix << __func__ << ": Unable to load icon "
+                    << job->getRequest().icon);
+            const juce::ScopedLock missingLock(missingIconGuard);
+            missingIcons.addIfNotAlreadyThere(job->getRequest().icon);
+        }
+    }
+    lock.exitWrite();
+
+    // Lock the message thread once to run all finished callbacks that weren't
+    // cancelled while their icons were loading:
+    {
         const juce::MessageManagerLock mmLock((juce::Thread*) this);
         if (!mmLock.lockWasGained())
         {
             DBG(dbgPrefix << __func__
-                    << ":: Exiting, skipping callback for icon \"" << icon
-                    << "\"");
+                    << ": Exiting, skipping icon loading callbacks.");
             return;
         }
-
         lock.enterRead();
-        const bool requestPresent = (requestMap.count(requestID) != 0);
-        if (requestPresent)
+        for (LoadingJob* job : loadingJobs)
         {
-            firstRequest.loadingCallback(iconImg);
+            if (job->getImage().isNull())
+            {
+                continue;
+            }
+            if (!job->loadedFromCache())
+            {
+                DBG(dbgPrefix << __func__ << ": Loaded icon "
+                        << job->getRequest().icon << " in "
+                        << juce::String(job->getLoadingTime(), 1) << "ms");
+            }
+            for (const RequestID& requestID : job->getRequestIDs())
+            {
+                auto requestIter = requestMap.find(requestID);
+                if (requestIter != requestMap.end())
+                {
+                    requestIter->second.loadingCallback(job->getImage());
+                }
+            }
         }
         lock.exitRead();
+    }
 
-        if (requestPresent)
+    // Remove all handled requests:
+    lock.enterWrite();
+    for (LoadingJob* job : loadingJobs)
+    {
+        for (const RequestID& requestID : job->getRequestIDs())
         {
-            lock.enterWrite();
             requestMap.erase(requestID);
-            lock.exitWrite();
         }
     }
-    else
+    lock.exitWrite();
+}
+
+
+// Keeps the thread dormant when all icon requests have been processed and icon
+// files can't be watched.
+bool Icon::ThreadResource::threadShouldWait()
+{
+    return !fileWatcher.isValid() && requestMap.empty()
+            && activeJobs.isEmpty();
+}
+
+
+// Wakes the thread if it is waiting for icon file changes before stopping the
+// thread normally.
+void Icon::ThreadResource::stopResourceThread()
+{
+    SharedResource::Thread::Resource::stopResourceThread();
+    fileWatcher.wake();
+}
+
+
+// Checks if a loading job was already started for a request.
+bool Icon::ThreadResource::isLoading(const RequestID requestID) const
+{
+    for (const LoadingJob* job : activeJobs)
     {
-        // Couldn't find the icon, remove the request
-        lock.enterWrite();
-        missingIcons.add(firstRequest.icon);
-        requestMap.erase(requestID);
-        lock.exitWrite();
+        if (job->getRequestIDs().contains(requestID))
+        {
+            return true;
+        }
     }
+    return false;
 }
 
 
-// Keeps the thread dormant when all icon requests have been processed.
-bool Icon::ThreadResource::threadShouldWait()
+// Finds a loading job that will load the image needed by an icon request.
+Icon::ThreadResource::LoadingJob* Icon::ThreadResource::findMatchingJob
+(const IconRequest& request, const juce::OwnedArray<LoadingJob>& jobs)
 {
-    return requestMap.empty();
+    for (LoadingJob* job : jobs)
+    {
+        if (job->matchesRequest(request))
+        {
+            return job;
+        }
+    }
+    return nullptr;
 }
 
 
 // Search icon theme directories for an icon matching a given request.
-juce::String Icon::ThreadResource::getIconPath(const IconRequest& request)
+juce::String Icon::ThreadResource::getIconPath
+(const IconRequest& request, const ThemeList& themes)
 {
     using juce::String;
     using juce::File;
 
     // Don't waste time searching for icons that weren't found before:
-    if (missingIcons.contains(request.icon))
     {
-        return String();
+        const juce::ScopedLock missingLock(missingIconGuard);
+        if (missingIcons.contains(request.icon))
+        {
+            return String();
+        }
     }
 
     // First, search themes in order to find a matching icon:
-    for (const ThemeIndex* themeIndex : iconThemes)
+    for (const auto& themeIndex : themes)
     {
         String iconPath = themeIndex->lookupIcon(request.icon, request.size,
                 request.context, request.scale);
@@ -352,7 +499,7 @@ juce::String Icon::ThreadResource::getIconPath(const IconRequest& request)
         IconRequest subRequest = request;
         subRequest.icon = subRequest.icon.upToLastOccurrenceOf("-", false,
                 false);
-        String iconPath = getIconPath(subRequest);
+        String iconPath = getIconPath(subRequest, themes);
         if (iconPath.isNotEmpty())
         {
             return iconPath;
@@ -447,3 +594,421 @@ juce::String Icon::ThreadResource::getUnindexedIconPath
     }
     return String();
 }
+
+
+// Finds the user's selected icon theme and all inherited and fallback themes,
+// ensuring that each theme's lookup index is up to date.
+std::shared_ptr<const Icon::ThreadResource::ThemeList>
+Icon::ThreadResource::loadIconThemes() const
+{
+    using juce::StringArray;
+    using juce::String;
+    using juce::File;
+    std::shared_ptr<ThemeList> themes = std::make_shared<ThemeList>();
+
+    // Find the icon themes to use and store them sorted from highest to lowest
+    // priority:
+    StringArray themeNames;
+    StringArray themeSettings;
+    File(getGtkSettingPath()).readLines(themeSettings);
+    for (const String& line : themeSettings)
+    {
+        int divider = line.indexOfChar('=');
+        if (divider != -1)
+        {
+            String key = line.substring(0, divider);
+            if (key == iconThemeKey || key == backupThemeKey)
+            {
+                themeNames.add(line.substring(divider + 1).unquoted());
+                if (themeNames.size() > 1)
+                {
+                    break;
+                }
+            }
+        }
+    }
+    themeNames.add(fallbackTheme);
+
+    // Create theme index objects for the user's icon theme and all inherited
+    // or fallback themes:
+    for (int i = 0; i < themeNames.size(); i++)
+    {
+        for (const String& dir : iconDirectories)
+        {
+            File themeDir(dir + (dir.endsWithChar('/') ? "" : "/")
+                    + themeNames[i]);
+            if (themeDir.isDirectory())
+            {
+                std::shared_ptr<ThemeIndex> theme
+                        = std::make_shared<ThemeIndex>(themeDir);
+                if (theme->isValidTheme())
+                {
+                    StringArray inherited = theme->getInheritedThemes();
+                    int insertParentIdx = i + 1;
+                    for (const String& parent : inherited)
+                    {
+                        if (!themeNames.contains(parent))
+                        {
+                            themeNames.insert(insertParentIdx, parent);
+                            insertParentIdx++;
+                        }
+                    }
+                    theme->updateLookupIndex();
+                    themes->add(theme);
+                    break;
+                }
+            }
+        }
+    }
+    #ifdef JUCE_DEBUG
+    String dbgThemeNames;
+    for (const auto& theme : *themes)
+    {
+        if (dbgThemeNames.isNotEmpty())
+        {
+            dbgThemeNames += ", ";
+        }
+        dbgThemeNames += theme->getName();
+    }
+    DBG(dbgPrefix << __func__ << ": Loaded icon themes: " << dbgThemeNames);
+    #endif
+    return themes;
+}
+
+
+// Watches the home directory, all icon directories, and all loaded icon theme
+// directories for changes, replacing any previously watched directories.
+void Icon::ThreadResource::watchIconDirectories()
+{
+    using juce::String;
+    fileWatcher.removeAllDirectories();
+    // The home directory is watched to detect changes to the iconThemeFile and
+    // creation of the home icon directory:
+    fileWatcher.addDirectory(getenv("HOME"));
+    for (const String& iconDir : iconDirectories)
+    {
+        fileWatcher.addDirectory(iconDir);
+    }
+    for (const auto& theme : *iconThemes)
+    {
+        const String themePath = theme->getPath();
+        fileWatcher.addDirectory(themePath);
+        for (const String& subdir : theme->getSubdirectories())
+        {
+            fileWatcher.addDirectory(themePath + "/" + subdir);
+        }
+    }
+}
+
+
+// Reads all changes within watched directories, discarding all affected cached
+// images and missing icon records, and marking affected icon themes to be
+// reloaded.
+void Icon::ThreadResource::checkFileChanges
+(SharedResource::Thread::Lock& lock)
+{
+    using juce::String;
+    using juce::File;
+    juce::StringArray changedPaths;
+    if (!fileWatcher.readChanges(changedPaths))
+    {
+        // Changes were lost, so everything needs to be reloaded:
+        themeListChanged = true;
+    }
+    if (changedPaths.isEmpty())
+    {
+        return;
+    }
+    const String homePath = getenv("HOME");
+    const String gtkSettingPath = getGtkSettingPath();
+    juce::Array<File> changedIconFiles;
+    for (const String& changedPath : changedPaths)
+    {
+        const File changedFile(changedPath);
+        const String parentPath
+                = changedFile.getParentDirectory().getFullPathName();
+        if (changedPath == gtkSettingPath
+                || iconDirectories.contains(changedPath)
+                || (iconDirectories.contains(parentPath)
+                    && changedFile.isDirectory()))
+        {
+            // The selected theme changed, an icon directory was created or
+            // removed, or a new theme may have been installed:
+            themeListChanged = true;
+            continue;
+        }
+        if (parentPath == homePath)
+        {
+            // Ignore all other changes within the home directory:
+            continue;
+        }
+        for (const auto& theme : *iconThemes)
+        {
+            const String themePath = theme->getPath();
+            if (changedPath == themePath
+                    || (parentPath == themePath
+                        && changedFile.getFileName() == indexFileName))
+            {
+                // A loaded theme was removed, or its theme definition changed:
+                themeListChanged = true;
+                break;
+            }
+            if (changedPath.startsWith(themePath + "/"))
+            {
+                changedThemes.addIfNotAlreadyThere(themePath);
+                if (parentPath == themePath)
+                {
+                    // The theme's icon cache file may have changed, so any
+                    // icon may now be found within the theme:
+                    const juce::ScopedLock missingLock(missingIconGuard);
+                    missingIcons.clear();
+                }
+                break;
+            }
+        }
+        changedIconFiles.add(changedFile);
+    }
+
+    // Only hold the lock while discarding cached images:
+    lock.enterWrite();
+    for (const File& iconFile : changedIconFiles)
+    {
+        invalidateIcon(iconFile);
+    }
+    lock.exitWrite();
+}
+
+
+// Reloads all icon themes affected by file changes.
+void Icon::ThreadResource::reloadChangedThemes
+(SharedResource::Thread::Lock& lock)
+{
+    // Build the new theme list without holding the lock, as loading themes and
+    // rebuilding lookup indexes may scan entire theme directories:
+    std::shared_ptr<const ThemeList> newThemes;
+    if (themeListChanged)
+    {
+        DBG(dbgPrefix << __func__ << ": Reloading all icon themes.");
+        newThemes = loadIconThemes();
+    }
+    else if (!changedThemes.isEmpty())
+    {
+        std::shared_ptr<ThemeList> updatedThemes
+                = std::make_shared<ThemeList>(*iconThemes);
+        for (int i = 0; i < updatedThemes->size(); i++)
+        {
+            const juce::String themePath
+                    = updatedThemes->getReference(i)->getPath();
+            if (changedThemes.contains(themePath))
+            {
+                DBG(dbgPrefix << __func__ << ": Reloading icon theme "
+                        << themePath);
+                std::shared_ptr<ThemeIndex> theme
+                        = std::make_shared<ThemeIndex>(juce::File(themePath));
+                theme->updateLookupIndex(true);
+                updatedThemes->set(i, theme);
+            }
+        }
+        newThemes = updatedThemes;
+    }
+    else
+    {
+        return;
+    }
+
+    // Replace the themes while briefly holding the lock. If all themes were
+    // reloaded, all cached images and missing icon records are discarded at
+    // the same time:
+    lock.enterWrite();
+    iconThemes = newThemes;
+    if (themeListChanged)
+    {
+        loadedImageCache.clear();
+        const juce::ScopedLock missingLock(missingIconGuard);
+        missingIcons.clear();
+    }
+    lock.exitWrite();
+    themeListChanged = false;
+    changedThemes.clear();
+    watchIconDirectories();
+}
+
+
+// Discards all cached images and missing icon records that could be affected
+// by a changed icon file.
+void Icon::ThreadResource::invalidateIcon(const juce::File& iconFile)
+{
+    using juce::String;
+    const String iconName = iconFile.getFileNameWithoutExtension();
+    loadedImageCache.removeImages(iconFile.getFullPathName());
+    loadedImageCache.removeImages(iconName);
+
+    // Hyphenated icon names may fall back to less specific icons, so also
+    // search for missing icons that could fall back to the changed icon:
+    const String fallbackPrefix = iconName + "-";
+    const juce::ScopedLock missingLock(missingIconGuard);
+    for (int i = missingIcons.size() - 1; i >= 0; i--)
+    {
+        if (missingIcons[i] == iconName
+                || missingIcons[i].startsWith(fallbackPrefix))
+        {
+            missingIcons.remove(i);
+        }
+    }
+}
+
+
+// Creates a job that will find and load a single requested icon using the
+// ThreadResource's current icon themes.
+Icon::ThreadResource::LoadingJob::LoadingJob
+(ThreadResource& iconThread, const IconRequest& request) :
+juce::ThreadPoolJob(request.icon),
+iconThread(iconThread),
+request(request),
+themes(iconThread.iconThemes),
+finished(false),
+creationTime(juce::Time::getMillisecondCounterHiRes()) { }
+
+
+// Finds the requested icon file, and loads it as an image.
+juce::ThreadPoolJob::JobStatus Icon::ThreadResource::LoadingJob::runJob()
+{
+    image = loadIcon();
+    finished.store(true);
+    iconThread.loadingEvent.signal();
+    return jobHasFinished;
+}
+
+
+// Checks if another icon request may be fulfilled by this job's image.
+bool Icon::ThreadResource::LoadingJob::matchesRequest
+(const IconRequest& otherRequest) const
+{
+    return request.icon == otherRequest.icon
+            && request.size == otherRequest.size
+            && request.scale == otherRequest.scale
+            && request.context == otherRequest.context;
+}
+
+
+// Adds the ID of a request that will be fulfilled by this job's image.
+void Icon::ThreadResource::LoadingJob::addRequestID(const RequestID requestID)
+{
+    requestIDs.add(requestID);
+}
+
+
+// Gets the IDs of all requests fulfilled by this job.
+const juce::Array<Icon::RequestID>&
+Icon::ThreadResource::LoadingJob::getRequestIDs() const
+{
+    return requestIDs;
+}
+
+
+// Gets the icon request that defines the image this job loads.
+const Icon::ThreadResource::IconRequest&
+Icon::ThreadResource::LoadingJob::getRequest() const
+{
+    return request;
+}
+
+
+// Provides an image found in the icon cache, so that the job doesn't need to
+// run.
+void Icon::ThreadResource::LoadingJob::setCachedImage
+(const juce::Image cachedImage)
+{
+    if (cachedImage.isValid())
+    {
+        image = cachedImage;
+        cached = true;
+    }
+}
+
+
+// Checks if the job's image was found in the icon cache.
+bool Icon::ThreadResource::LoadingJob::loadedFromCache() const
+{
+    return cached;
+}
+
+
+// Gets the loaded icon image.
+juce::Image Icon::ThreadResource::LoadingJob::getImage() const
+{
+    return image;
+}
+
+
+// Checks if the job has finished loading its icon.
+bool Icon::ThreadResource::LoadingJob::isFinished() const
+{
+    return finished.load();
+}
+
+
+// Gets the time the job has spent loading its icon.
+double Icon::ThreadResource::LoadingJob::getLoadingTime() const
+{
+    return juce::Time::getMillisecondCounterHiRes() - creationTime;
+}
+
+
+// Checks if the job searched for its icon using a specific list of icon
+// themes.
+bool Icon::ThreadResource::LoadingJob::usesThemes
+(const std::shared_ptr<const ThemeList>& themeList) const
+{
+    return themes == themeList;
+}
+
+
+// Finds the requested icon file, and loads it as an image.
+juce::Image Icon::ThreadResource::LoadingJob::loadIcon()
+{
+    using juce::Image;
+    using juce::String;
+    String iconPath;
+    if (request.icon[0] == '/' && juce::File(request.icon).existsAsFile())
+    {
+        iconPath = request.icon;
+    }
+    else
+    {
+        // Search themes using only the icon name if the icon path is missing:
+        IconRequest nameRequest = request;
+        nameRequest.icon = request.icon.fromLastOccurrenceOf("/", false,
+                false);
+        iconPath = iconThread.getIconPath(nameRequest, *themes);
+    }
+    if (iconPath.isEmpty() || shouldExit())
+    {
+        return Image();
+    }
+    const int targetSize = request.size * request.scale;
+    Image iconImage = iconThread.rasterCache.loadImage(iconPath, targetSize);
+    if (iconImage.isValid())
+    {
+        return iconImage;
+    }
+
+    // Scalable icons are rendered directly at the size they'll be drawn at:
+    iconImage = Assets::loadImageAsset(iconPath, true, targetSize);
+    if (iconImage.isNull() || shouldExit())
+    {
+        return iconImage;
+    }
+    // Scale down images that are larger than needed before caching them:
+    const int largestSide = std::max(iconImage.getWidth(),
+            iconImage.getHeight());
+    if (targetSize > 0 && largestSide > targetSize)
+    {
+        iconImage = iconImage.rescaled(
+                std::max(1, iconImage.getWidth() * targetSize / largestSide),
+                std::max(1, iconImage.getHeight() * targetSize / largestSide),
+                juce::Graphics::highResamplingQuality);
+    }
+    iconThread.rasterCache.saveImage(iconPath, targetSize, iconImage);
+    return iconImage;
+}
@@ -7,10 +7,17 @@
  */
 
 #include "SharedResource_Thread_Resource.h"
+#include "SharedResource_Thread_JobPool.h"
 #include "Icon_ThemeIndex.h"
+#include "Icon_ImageCache.h"
+#include "Icon_RasterCache.h"
 #include "Icon_RequestID.h"
+#include "Icon_Priority.h"
+#include "Util_FileWatcher.h"
 #include "JuceHeader.h"
+#include <atomic>
 #include <map>
+#include <memory>
 
 namespace Icon { class ThreadResource; }
 
@@ -20,12 +27,25 @@ namespace Icon { class ThreadResource; }
  *
  *  The ThreadResource handles these requests asynchronously, searching the
  * user's selected icon theme directories for the closest icon matching the
- * request.
+ * request. Icon searches and image loading are spread across a small pool of
+ * worker threads, and each request's callback runs as soon as its icon is
+ * loaded. The icon thread itself always runs on a dedicated thread, as it
+ * blocks while waiting for icon file changes. When thread resources share the
+ * SharedResource::Thread::Pool, loading jobs run within that pool.
  *
  *  This process uses the XDG Base Directory Specification, the user's .gtkrc
  * config file, and the icon themes' index.theme files to determine which
  * directories are prioritized. GTK's icon-theme.cache files are used to
- * quickly locate image files within icon theme directories.
+ * quickly locate image files within icon theme directories. Themes without
+ * valid icon cache files use pocket-home's own LookupIndex files instead.
+ *
+ *  Icon directories and the .gtkrc file are watched for changes from the icon
+ * thread, which sleeps until files change whenever it has no requests to
+ * handle. When icon files change, matching cached images and missing icon
+ * records are discarded, and the themes containing those icon files are
+ * reloaded. Reloaded themes are built without holding the resource lock, and
+ * replace the old theme list only once they are ready. Loading jobs keep their
+ * own reference to the theme list that was current when they were created.
  */
 class Icon::ThreadResource : public SharedResource::Thread::Resource
 {
@@ -62,6 +82,8 @@ public:
         Context context;
         // Function used to apply the requested icon
         std::function<void(juce::Image)> loadingCallback;
+        // Determines the order in which pending requests are handled
+        Priority priority;
     };
 
     /**
@@ -73,31 +95,247 @@ public:
      */
     RequestID addRequest(IconRequest request);
 
+    /**
+     * @brief  Changes the priority of a pending icon request.
+     *
+     * @param requestID    The ID of a pending icon request.
+     *
+     * @param newPriority  The new request priority to apply.
+     */
+    void setRequestPriority(const RequestID requestID,
+            const Priority newPriority);
+
+    /**
+     * @brief  Gets the size, limit, and usage statistics of the loaded icon
+     *         image cache.
+     *
+     * @return  The current image cache statistics.
+     */
+    ImageCache::Statistics getCacheStatistics() const;
+
 private:
+    // Icon theme indexes used to load icons, in order of priority. Listed
+    // themes are never changed, so they may be shared by multiple lists:
+    typedef juce::Array<std::shared_ptr<const ThemeIndex>> ThemeList;
+
+    /**
+     * @brief  Finds and loads a single requested icon within the icon loading
+     *         thread pool, providing the image to all matching requests.
+     */
+    class LoadingJob : public juce::ThreadPoolJob
+    {
+    public:
+        /**
+         * @brief  Creates a job that will find and load a single requested
+         *         icon using the ThreadResource's current icon themes.
+         *
+         * @param iconThread  The ThreadResource used to find icon paths. This
+         *                    should only be called on the icon thread.
+         *
+         * @param request     The icon request defining the image to load.
+         */
+        LoadingJob(ThreadResource& iconThread, const IconRequest& request);
+
+        virtual ~LoadingJob() { }
+
+        /**
+         * @brief  Finds the requested icon file, and loads it as an image.
+         *
+         * @return  The jobHasFinished status, as loading jobs only run once.
+         */
+        virtual JobStatus runJob() override;
+
+        /**
+         * @brief  Checks if another icon request may be fulfilled by this
+         *         job's image.
+         *
+         * @param otherRequest  Another pending icon request.
+         *
+         * @return              Whether both requests have the same icon, size,
+         *                      scale, and context.
+         */
+        bool matchesRequest(const IconRequest& otherRequest) const;
+
+        /**
+         * @brief  Adds the ID of a request that will be fulfilled by this
+         *         job's image.
+         *
+         * @param requestID  The ID of a matching pending request.
+         */
+        void addRequestID(const RequestID requestID);
+
+        /**
+         * @brief  Gets the IDs of all requests fulfilled by this job.
+         *
+         * @return  All request IDs added to the job.
+         */
+        const juce::Array<RequestID>& getRequestIDs() const;
+
+        /**
+         * @brief  Gets the icon request that defines the image this job loads.
+         *
+         * @return  The job's icon request.
+         */
+        const IconRequest& getRequest() const;
+
+        /**
+         * @brief  Provides an image found in the icon cache, so that the job
+         *         doesn't need to run.
+         *
+         * @param cachedImage  A cached image, or a null image if the requested
+         *                     icon wasn't cached.
+         */
+        void setCachedImage(const juce::Image cachedImage);
+
+        /**
+         * @brief  Checks if the job's image was found in the icon cache.
+         *
+         * @return  Whether a valid cached image was provided to the job.
+         */
+        bool loadedFromCache() const;
+
+        /**
+         * @brief  Gets the loaded icon image.
+         *
+         * @return  The requested icon, or a null image if the job hasn't
+         *          finished or the icon couldn't be loaded.
+         */
+        juce::Image getImage() const;
+
+        /**
+         * @brief  Checks if the job has finished loading its icon.
+         *
+         * @return  Whether the job finished running.
+         */
+        bool isFinished() const;
+
+        /**
+         * @brief  Gets the time the job has spent loading its icon.
+         *
+         * @return  The number of milliseconds between the job's creation and
+         *          the current time.
+         */
+        double getLoadingTime() const;
+
+        /**
+         * @brief  Checks if the job searched for its icon using a specific
+         *         list of icon themes.
+         *
+         * @param themeList  A list of icon themes.
+         *
+         * @return           Whether the job used that theme list.
+         */
+        bool usesThemes(const std::shared_ptr<const ThemeList>& themeList)
+            const;
+
+    private:
+        /**
+         * @brief  Finds the requested icon file, and loads it as an image.
+         *
+         *  Icons requested by absolute path are loaded from that path if the
+         * file exists, and searched for by name otherwise. Images are loaded
+         * from the RasterCache if possible. Otherwise, the icon file is
+         * decoded, SVG icons are rasterized at the requested icon size and
+         * scale, and oversized images are scaled down before being saved to
+         * the RasterCache.
+         *
+         * @return  The loaded icon image, or a null image if the icon couldn't
+         *          be found or loaded.
+         */
+        juce::Image loadIcon();
+
+        ThreadResource& iconThread;
+        const IconRequest request;
+        const std::shared_ptr<const ThemeList> themes;
+        juce::Array<RequestID> requestIDs;
+        juce::Image image;
+        bool cached = false;
+        std::atomic<bool> finished;
+        const double creationTime;
+    };
+
+    /**
+     * @brief  Loads all icon themes and starts watching icon directories the
+     *         first time the thread starts.
+     *
+     *  Themes are loaded on the icon thread instead of when the ThreadResource
+     * is created, as themes without valid icon cache files may need their
+     * lookup indexes rebuilt. The first time the thread starts, this also
+     * removes outdated and unused images from the raster cache.
+     *
+     * @param lock  The thread's resource lock.
+     */
+    virtual void init(SharedResource::Thread::Lock& lock) override;
+
     /**
      * @brief  Asynchronously handles queued icon requests.
+     *
+     *  Each loop iteration first handles changes to watched icon files, then
+     * starts loading jobs for the highest priority pending requests until the
+     * loading thread pool is full, merging requests for identical icons, and
+     * then waits for at least one job to finish. The callbacks of all finished
+     * jobs run right away, so a slow icon never delays the callbacks of icons
+     * that finished before it. If there are no requests to handle, the loop
+     * waits until an icon file changes or a request is added.
+     *
+     * @param lock  The thread's resource lock.
      */
     virtual void runLoop(SharedResource::Thread::Lock& lock) override;
 
     /**
      * @brief  Keeps the thread dormant when all icon requests have been
-     *         processed.
+     *         processed and icon files can't be watched.
+     *
+     *  When icon files are watched, the thread instead sleeps within runLoop
+     * until a file changes or a request is added.
      *
-     * @return  True if there are pending requests, false if all requests were
-     *          completed.
+     * @return  True if there are no pending requests and icon files aren't
+     *          being watched, false otherwise.
      */
     virtual bool threadShouldWait() override;
 
+    /**
+     * @brief  Wakes the thread if it is waiting for icon file changes before
+     *         stopping the thread normally.
+     */
+    virtual void stopResourceThread() override;
+
+    /**
+     * @brief  Checks if a loading job was already started for a request.
+     *
+     * @param requestID  The ID of a pending icon request.
+     *
+     * @return           Whether an active loading job handles that request.
+     */
+    bool isLoading(const RequestID requestID) const;
+
+    /**
+     * @brief  Finds a loading job that will load the image needed by an icon
+     *         request.
+     *
+     * @param request  A pending icon request.
+     *
+     * @param jobs     The loading jobs to search.
+     *
+     * @return         The first job with a matching request, or nullptr if no
+     *                 job matches.
+     */
+    static LoadingJob* findMatchingJob(const IconRequest& request,
+            const juce::OwnedArray<LoadingJob>& jobs);
+
     /**
      * @brief  Searches icon theme directories for an icon matching a given
      *         request.
      *
      * @param request  Defines the name and size of the requested icon.
      *
+     * @param themes   The icon themes to search, in order of priority.
+     *
      * @return         The full path of the best matching icon file, or the
      *                 empty string if no match is found.
      */
-    juce::String getIconPath(const IconRequest& request);
+    juce::String getIconPath(const IconRequest& request,
+            const ThemeList& themes);
 
     /**
      * @brief  Searches icon directories for icon files not indexed by icon
@@ -110,23 +348,107 @@ private:
      */
     juce::String getUnindexedIconPath(const IconRequest& request);
 
+    /**
+     * @brief  Finds the user's selected icon theme and all inherited and
+     *         fallback themes, ensuring that each theme's lookup index is up
+     *         to date.
+     *
+     *  This doesn't access any data protected by the resource lock, so it
+     * may run without holding the lock.
+     *
+     * @return  A new list of all icon themes, in order of priority.
+     */
+    std::shared_ptr<const ThemeList> loadIconThemes() const;
+
+    /**
+     * @brief  Watches the home directory, all icon directories, and all
+     *         loaded icon theme directories for changes, replacing any
+     *         previously watched directories.
+     */
+    void watchIconDirectories();
+
+    /**
+     * @brief  Reads all changes within watched directories, discarding all
+     *         affected cached images and missing icon records, and marking
+     *         affected icon themes to be reloaded.
+     *
+     *  This should only be called on the icon thread. The resource lock is
+     * only held for writing while cached images are discarded.
+     *
+     * @param lock  The thread's resource lock.
+     */
+    void checkFileChanges(SharedResource::Thread::Lock& lock);
+
+    /**
+     * @brief  Reloads all icon themes affected by file changes.
+     *
+     *  This should only be called on the icon thread. New themes are loaded
+     * without holding the resource lock, and then replace the current theme
+     * list while the lock is briefly held for writing.
+     *
+     * @param lock  The thread's resource lock.
+     */
+    void reloadChangedThemes(SharedResource::Thread::Lock& lock);
+
+    /**
+     * @brief  Discards all cached images and missing icon records that could
+     *         be affected by a changed icon file.
+     *
+     * @param iconFile  An icon file that was created, removed, or modified.
+     */
+    void invalidateIcon(const juce::File& iconFile);
+
     // All pending icon requests, mapped by ID so they can be cancelled.
     std::map<RequestID, IconRequest> requestMap;
 
-    // Icon theme indexes used to load icons, in order of priority
-    juce::OwnedArray<ThemeIndex> iconThemes;
+    // Runs the jobs used to find and load requested icons:
+    SharedResource::Thread::JobPool loadingPool;
+
+    // Loading jobs queued or running in the loading pool. These are only
+    // accessed by the icon thread.
+    juce::OwnedArray<LoadingJob> activeJobs;
+
+    // Signalled when a loading job finishes, or when a new request is added:
+    juce::WaitableEvent loadingEvent;
+
+    // Icon theme indexes used to load icons, in order of priority. This is
+    // only accessed on the icon thread, and is replaced instead of changed,
+    // as loading jobs may still be using the old list:
+    std::shared_ptr<const ThemeList> iconThemes;
 
     // Directories to search, in order, for icon themes and unthemed icons.
     juce::StringArray iconDirectories;
 
-    // Stores loaded icon names mapped to image objects to avoid having to
+    // Stores recently loaded icon images by name and size to avoid having to
     // repeatedly load icons:
-    juce::HashMap<juce::String, juce::Image> loadedImageCache;
+    ImageCache loadedImageCache;
+
+    // Stores scaled icon images on disk, so they don't need to be decoded again
+    // after restarting:
+    RasterCache rasterCache;
+
+    // Whether outdated and unused images were removed from the raster cache
+    // since the ThreadResource was created:
+    bool rasterCachePruned = false;
 
     // Store the names of icons that couldn't be found, to avoid wasting time
     // searching for them more than once:
     juce::StringArray missingIcons;
 
+    // Protects the missing icon list, as it is read within loading jobs:
+    juce::CriticalSection missingIconGuard;
+
+    // Tracks changes to icon directories and the .gtkrc file. Only the wake
+    // function is used outside of the icon thread:
+    Util::FileWatcher fileWatcher;
+
+    // Paths of loaded icon themes that need to be reloaded:
+    juce::StringArray changedThemes;
+
+    // Whether the selected icon themes may have changed, requiring all themes
+    // to be reloaded:
+    bool themeListChanged = false;
+
     // Default icon
     juce::Image defaultIcon;
 };
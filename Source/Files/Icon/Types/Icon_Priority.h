@@ -0,0 +1,24 @@
+#pragma once
+/**
+ * @file  Icon_Priority.h
+ *
+ * @brief  Describes how urgently a requested icon is needed.
+ */
+
+namespace Icon { enum class Priority; }
+
+/**
+ * @brief  Describes how urgently a requested icon is needed. Pending icon
+ *         requests are handled in order of priority, from visible to
+ *         background.
+ */
+enum class Icon::Priority
+{
+    // Icons that are currently shown on screen:
+    visible,
+    // Icons that are likely to be shown soon, such as icons on an adjacent
+    // menu page:
+    adjacent,
+    // Icons that are not expected to be shown soon:
+    background
+};
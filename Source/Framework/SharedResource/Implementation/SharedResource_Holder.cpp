@@ -1,85 +1,173 @@
 #define SHARED_RESOURCE_IMPLEMENTATION
 #include "SharedResource_Holder.h"
+#include <cstdlib>
 
 #ifdef JUCE_DEBUG
 // Print the full class name before all debug output:
 static const constexpr char* dbgPrefix = "SharedResource::Holder::";
 #endif
 
-// Holds the unique SharedResource::Holder instance
-static std::unique_ptr<SharedResource::Holder> holderInstance;
+/**
+ * @brief  Locks a resource lock, blocking the calling thread if necessary.
+ *
+ * @param lock      The resource lock.
+ *
+ * @param lockType  The type of lock to acquire.
+ */
+static void enterLock(const juce::ReadWriteLock& lock,
+        const SharedResource::LockType lockType)
+{
+    if (lockType == SharedResource::LockType::read)
+    {
+        lock.enterRead();
+    }
+    else
+    {
+        lock.enterWrite();
+    }
+}
 
-// Prevents concurrent access to the containers holding resource data.
-juce::CriticalSection SharedResource::Holder::holderLock;
 
-SharedResource::Holder::Holder()
+/**
+ * @brief  Attempts to lock a resource lock without blocking.
+ *
+ * @param lock      The resource lock.
+ *
+ * @param lockType  The type of lock to acquire.
+ *
+ * @return          Whether the lock was acquired.
+ */
+static bool tryEnterLock(const juce::ReadWriteLock& lock,
+        const SharedResource::LockType lockType)
 {
-    DBG(dbgPrefix << __func__ << ": Creating SharedResource instance Holder ");
+    if (lockType == SharedResource::LockType::read)
+    {
+        return lock.tryEnterRead();
+    }
+    return lock.tryEnterWrite();
 }
 
 
-// Clears all resource locks.
+// Blocks the calling thread until it can lock the resource.
+void SharedResource::ResourceSlot::enter(const LockType lockType)
+{
+#ifdef SHARED_RESOURCE_LOCK_STATS
+    // Only measure wait times when the lock isn't immediately available, so
+    // uncontended locks aren't slowed down by timing:
+    if (tryEnterLock(lock, lockType))
+    {
+        lockRecord.recordAcquisition(lockType, false, 0);
+        return;
+    }
+    const juce::int64 waitStart = juce::Time::getHighResolutionTicks();
+    enterLock(lock, lockType);
+    lockRecord.recordAcquisition(lockType, true,
+            juce::Time::getHighResolutionTicks() - waitStart);
+#else
+    enterLock(lock, lockType);
+#endif
+}
+
+
+// Attempts to lock the resource without blocking.
+bool SharedResource::ResourceSlot::tryEnter(const LockType lockType)
+{
+    const bool locked = tryEnterLock(lock, lockType);
+#ifdef SHARED_RESOURCE_LOCK_STATS
+    if (locked)
+    {
+        lockRecord.recordAcquisition(lockType, false, 0);
+    }
+#endif
+    return locked;
+}
+
+
+// Releases a lock previously acquired on this thread.
+void SharedResource::ResourceSlot::exit(const LockType lockType)
+{
+#ifdef SHARED_RESOURCE_LOCK_STATS
+    const juce::uint64 holdMicroseconds = lockRecord.recordRelease();
+#endif
+    if (lockType == LockType::read)
+    {
+        lock.exitRead();
+    }
+    else
+    {
+        lock.exitWrite();
+    }
+#ifdef SHARED_RESOURCE_LOCK_STATS
+    // Stack traces are slow to collect, so only save the lock holder's call
+    // site after the lock is released:
+    lockRecord.recordHoldSite(holdMicroseconds);
+#endif
+}
+
+
+// Checks that all resources were destroyed before the program exits.
 SharedResource::Holder::~Holder()
 {
-    const juce::ScopedLock cleanupLock(holderLock);
     DBG(dbgPrefix << __func__ << ": Destroying resource Instance Holder ");
 #ifdef JUCE_DEBUG
     // Test that all resources were properly destroyed. Claim all resource
     // locks for writing in case a resource is still being deleted.
-    for (int i = 0; i < resourceList.size(); i++)
+    for (ResourceSlot& slot : slots)
     {
-        const juce::ScopedWriteLock resourceLock(*resourceLocks[i]);
-        if (resourceList[i] != nullptr)
+        if (slot.keyAddress.load(std::memory_order_acquire) == nullptr)
         {
-            juce::String resourceName = "[Missing ID!]";
-            for (auto iter : resourceIndices)
-            {
-                if (iter.second == i)
-                {
-                    resourceName = iter.first.toString();
-                    break;
-                }
-            }
-            DBG(dbgPrefix << __func__ << ": Resource " << resourceName
-                    << " was not destroyed!");
+            continue;
+        }
+        const juce::ScopedWriteLock resourceLock(slot.lock);
+        if (slot.instance.load(std::memory_order_acquire) != nullptr)
+        {
+            DBG(dbgPrefix << __func__ << ": Resource "
+                    << slot.resourceKey.toString() << " was not destroyed!");
             jassertfalse;
         }
     }
-    jassert(resourceIndices.size() == resourceList.size()
-            && resourceList.size() == resourceLocks.size());
 #endif
-    resourceIndices.clear();
-    resourceList.clear();
-    resourceLocks.clear();
-}
-
-
-// Gets the program's sole SharedResource::Holder instance.
-SharedResource::Holder* SharedResource::Holder::getHolderInstance()
-{
-    const juce::ScopedLock initLock(holderLock);
-    if (holderInstance == nullptr)
-    {
-        holderInstance.reset(new Holder());
-    }
-    return holderInstance.get();
 }
 
 
-// Deletes the holder instance if it is holding no valid Instance pointers.
-void SharedResource::Holder::clearIfEmpty()
+// Finds the slot assigned to a resource key, assigning the key a new slot if
+// necessary.
+SharedResource::ResourceSlot& SharedResource::Holder::getResourceSlot
+(const juce::Identifier& resourceKey)
 {
-    if (holderInstance != nullptr)
+    // Identifiers with the same name always share the same pooled string, so
+    // the string's address identifies the resource key:
+    const char* const keyAddress = resourceKey.getCharPointer().getAddress();
+    Holder& holder = getHolderInstance();
+    const int startIndex = (int) (((juce::pointer_sized_uint) keyAddress >> 4)
+            & (maxResources - 1));
+    for (int i = 0; i < maxResources; i++)
     {
-        for (Instance* resourceInstance : holderInstance->resourceList)
+        ResourceSlot& slot = holder.slots[(startIndex + i)
+                & (maxResources - 1)];
+        const char* slotKey = slot.keyAddress.load(std::memory_order_acquire);
+        if (slotKey == nullptr)
         {
-            if (resourceInstance != nullptr)
+            // Try to claim the empty slot. If another thread claimed it first,
+            // slotKey will be updated to that thread's key.
+            if (slot.keyAddress.compare_exchange_strong(slotKey, keyAddress,
+                        std::memory_order_acq_rel))
             {
-                return;
+                slot.resourceKey = resourceKey;
+                return slot;
             }
         }
-        holderInstance.reset(nullptr);
+        if (slotKey == keyAddress)
+        {
+            return slot;
+        }
     }
+    // Returning another resource's slot would make two resource types share
+    // one Instance pointer, so fail immediately instead:
+    DBG(dbgPrefix << __func__ << ": No free slots for resource "
+            << resourceKey.toString() << ", increase maxResources!");
+    jassertfalse;
+    std::abort();
 }
 
 
@@ -87,9 +175,8 @@ void SharedResource::Holder::clearIfEmpty()
 SharedResource::Instance* SharedResource::Holder::getResource
 (const juce::Identifier& resourceKey)
 {
-    const juce::ScopedLock resourceLock(holderLock);
-    const int resourceIndex = getResourceIndex(resourceKey);
-    return holderInstance->resourceList.getUnchecked(resourceIndex);
+    return getResourceSlot(resourceKey).instance.load
+        (std::memory_order_acquire);
 }
 
 
@@ -97,30 +184,27 @@ SharedResource::Instance* SharedResource::Holder::getResource
 void SharedResource::Holder::setResource(const juce::Identifier& resourceKey,
         Instance* resource)
 {
-    const juce::ScopedLock resourceLock(holderLock);
-    const int resourceIndex = getResourceIndex(resourceKey);
-    Holder* const holder = getHolderInstance();
-
+    ResourceSlot& slot = getResourceSlot(resourceKey);
 #ifdef JUCE_DEBUG
     // Make sure either a null resource is becoming non-null, or a
     // non-null resource is becoming null.
-    if (resource == nullptr
-            && holder->resourceList.getUnchecked(resourceIndex) == nullptr)
+    Instance* const oldResource = slot.instance.load
+        (std::memory_order_acquire);
+    if (resource == nullptr && oldResource == nullptr)
     {
         DBG(dbgPrefix << __func__ << ": Error, setting resource "
                 << resourceKey.toString()
                 << " to null when it is already null!");
         jassertfalse;
     }
-    else if (resource != nullptr
-            && holder->resourceList.getUnchecked(resourceIndex) != nullptr)
+    else if (resource != nullptr && oldResource != nullptr)
     {
         DBG(dbgPrefix << __func__ << ": Error, setting new resource "
                 << resourceKey.toString() << " when it already exists!");
         jassertfalse;
     }
 #endif
-    holder->resourceList.set(resourceIndex, resource);
+    slot.instance.store(resource, std::memory_order_release);
 }
 
 
@@ -128,32 +212,32 @@ void SharedResource::Holder::setResource(const juce::Identifier& resourceKey,
 const juce::ReadWriteLock&
 SharedResource::Holder::getResourceLock(const juce::Identifier& resourceKey)
 {
-    const juce::ScopedLock resourceLock(holderLock);
-    const int resourceIndex = getResourceIndex(resourceKey);
-    return *getHolderInstance()->resourceLocks[resourceIndex];
+    return getResourceSlot(resourceKey).lock;
 }
 
 
-// Gets the index where a resource and its lock are stored in the resourceList
-// and resourceLocks arrays.
-int SharedResource::Holder::getResourceIndex
-(const juce::Identifier& resourceKey)
+// Gets all slots that have been assigned to a resource key.
+juce::Array<SharedResource::ResourceSlot*>
+SharedResource::Holder::getAssignedSlots()
 {
-    if (getHolderInstance()->resourceIndices.count(resourceKey) == 0)
+    juce::Array<ResourceSlot*> assignedSlots;
+    for (ResourceSlot& slot : getHolderInstance().slots)
     {
-        initResource(resourceKey);
+        if (slot.keyAddress.load(std::memory_order_acquire) != nullptr)
+        {
+            assignedSlots.add(&slot);
+        }
     }
-    return getHolderInstance()->resourceIndices.at(resourceKey);
+    return assignedSlots;
 }
 
 
-// Initializes a resource container, assigning it an index, creating its lock,
-// and setting the initial resource instance address as nullptr.
-void SharedResource::Holder::initResource(const juce::Identifier& resourceKey)
+// Gets the program's sole SharedResource::Holder instance, creating it on first
+// use.
+SharedResource::Holder& SharedResource::Holder::getHolderInstance()
 {
-    Holder* const holder = getHolderInstance();
-    jassert(holder->resourceList.size() == holder->resourceLocks.size());
-    holder->resourceIndices[resourceKey] = holder->resourceList.size();
-    holder->resourceList.add(nullptr);
-    holder->resourceLocks.add(new juce::ReadWriteLock());
+    // Function-local static initialization is threadsafe, and only checks an
+    // initialization flag once the Holder exists.
+    static Holder holderInstance;
+    return holderInstance;
 }
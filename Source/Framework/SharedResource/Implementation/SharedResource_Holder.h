@@ -8,44 +8,150 @@
  * @brief  Holds all resource Instance objects and resource locks.
  */
 
-#include <map>
 #include "JuceHeader.h"
+#include "SharedResource_LockType.h"
+#ifdef SHARED_RESOURCE_LOCK_STATS
+#include "SharedResource_LockRecord.h"
+#endif
+#include <atomic>
 
 namespace SharedResource { class Holder; }
 namespace SharedResource { class Instance; }
+namespace SharedResource { struct ResourceSlot; }
+namespace SharedResource { class ScopedSlotLock; }
+
+/**
+ * @brief  Stores a single resource Instance pointer, along with the lock used
+ *         to control access to that Instance.
+ *
+ *  Each resource key is assigned one ResourceSlot the first time it is used.
+ * Slots are never reassigned or destroyed while the program is running, so
+ * Reference and LockedInstancePtr objects may save their slot's address, and
+ * access the resource Instance and lock without searching for them again.
+ */
+struct SharedResource::ResourceSlot
+{
+    // The address of the resource key's pooled string, or nullptr if the slot
+    // has not been assigned to a resource key:
+    std::atomic<const char*> keyAddress { nullptr };
+
+    // The resource key assigned to this slot, only used for debug output:
+    juce::Identifier resourceKey;
+
+    // The resource's Instance pointer, or nullptr if the resource does not
+    // currently exist:
+    std::atomic<Instance*> instance { nullptr };
+
+    // The lock used to control access to the resource:
+    juce::ReadWriteLock lock;
+
+#ifdef SHARED_RESOURCE_LOCK_STATS
+    // Records how the resource lock is used:
+    LockRecord lockRecord;
+#endif
+
+    /**
+     * @brief  Blocks the calling thread until it can lock the resource.
+     *
+     *  When SHARED_RESOURCE_LOCK_STATS is defined, this also records the lock
+     * acquisition and the time spent waiting for the lock.
+     *
+     * @param lockType  The type of lock to acquire.
+     */
+    void enter(const LockType lockType);
+
+    /**
+     * @brief  Attempts to lock the resource without blocking.
+     *
+     * @param lockType  The type of lock to acquire.
+     *
+     * @return          Whether the lock was acquired.
+     */
+    bool tryEnter(const LockType lockType);
+
+    /**
+     * @brief  Releases a lock previously acquired on this thread.
+     *
+     *  When SHARED_RESOURCE_LOCK_STATS is defined, this also records how long
+     * the lock was held.
+     *
+     * @param lockType  The type of lock to release.
+     */
+    void exit(const LockType lockType);
+};
+
+/**
+ * @brief  Locks a ResourceSlot for as long as the ScopedSlotLock exists.
+ */
+class SharedResource::ScopedSlotLock
+{
+public:
+    /**
+     * @brief  Locks the slot's resource.
+     *
+     * @param slot      The slot holding the resource lock.
+     *
+     * @param lockType  The type of lock to acquire.
+     */
+    ScopedSlotLock(ResourceSlot& slot, const LockType lockType) :
+    slot(slot), lockType(lockType)
+    {
+        slot.enter(lockType);
+    }
+
+    /**
+     * @brief  Unlocks the slot's resource.
+     */
+    ~ScopedSlotLock()
+    {
+        slot.exit(lockType);
+    }
+
+private:
+    ResourceSlot& slot;
+    const LockType lockType;
+
+    JUCE_DECLARE_NON_COPYABLE(ScopedSlotLock);
+};
 
 /**
  * @brief  Stores all resource Instance objects, creates their dedicated lock
  *         objects, and ensures resource initialization and destruction is
  *         threadsafe.
+ *
+ *  The Holder assigns each resource key a ResourceSlot from a fixed table,
+ * using the address of the key's pooled Identifier string to find the slot.
+ * Finding or assigning a slot never locks a mutex: unassigned slots are
+ * claimed with a single atomic compare-and-swap, so any number of threads may
+ * look up resources at once. Once a slot is found, accessing the resource
+ * Instance is a single atomic load.
  */
 class SharedResource::Holder
 {
 private:
-    Holder();
+    Holder() { }
 
 public:
     /**
-     * @brief  Clears all resource locks.
+     * @brief  Checks that all resources were destroyed before the program
+     *         exits.
      *
-     *  This should never run before all resources are cleared. In debug
-     * builds, this will verify that each Instance pointer is null.
+     *  In debug builds, this will verify that each Instance pointer is null.
      */
     ~Holder();
 
     /**
-     * @brief  Gets the program's sole SharedResource::Holder instance.
+     * @brief  Finds the slot assigned to a resource key, assigning the key a
+     *         new slot if necessary.
      *
-     * @return  The holder managing all Instance objects.
-     */
-    static Holder* getHolderInstance();
-
-    /**
-     * @brief  Deletes the holder instance if it is holding no valid Instance
-     *         pointers. This should be called after deleting each resource
-     *         Instance.
+     * @param resourceKey  A unique key identifying a Resource subclass.
+     *
+     * @return             The slot holding that resource's Instance pointer
+     *                     and lock. If all slots are assigned to other keys,
+     *                     the program is aborted instead of sharing a slot
+     *                     between resources.
      */
-    static void clearIfEmpty();
+    static ResourceSlot& getResourceSlot(const juce::Identifier& resourceKey);
 
     /**
      * @brief  Finds and gets an Instance pointer using its resource key.
@@ -63,7 +169,8 @@ public:
      *
      *  This should only be called when the existing resource Instance at the
      * given ID is null, or to set the pointer to null while destroying the
-     * resource.
+     * resource. The resource lock should be held for writing while this
+     * function runs.
      *
      * @param resourceKey  A unique key identifying a Resource subclass.
      *
@@ -83,40 +190,25 @@ public:
     static const juce::ReadWriteLock& getResourceLock
     (const juce::Identifier& resourceKey);
 
-private:
     /**
-     * @brief  Gets the index where a resource and its lock are stored in the
-     *         resourceList and resourceLocks arrays.
-     *
-     *  If necessary, this will initialize the resource container, creating a
-     * new lock and assigning an index.
+     * @brief  Gets all slots that have been assigned to a resource key.
      *
-     * @param resourceKey  A unique key identifying a Resource subclass.
-     *
-     * @return             The index needed to find the resource index and its
-     *                     lock.
+     * @return  Every assigned slot, in table order.
      */
-    static int getResourceIndex(const juce::Identifier& resourceKey);
+    static juce::Array<ResourceSlot*> getAssignedSlots();
 
+private:
     /**
-     * @brief  Initializes a resource container, assigning it an index,
-     *         creating its lock, and setting the initial resource instance
-     *         address as nullptr.
+     * @brief  Gets the program's sole SharedResource::Holder instance,
+     *         creating it on first use.
      *
-     * @param resourceKey  A unique key identifying a Resource subclass.
+     * @return  The holder managing all Instance objects.
      */
-    static void initResource(const juce::Identifier& resourceKey);
-
-    // Prevents concurrent access to the containers holding resource data.
-    static juce::CriticalSection holderLock;
-
-    // Maps each resource ID to the index where its Instance and lock
-    // are stored.
-    std::map<juce::Identifier, int> resourceIndices;
+    static Holder& getHolderInstance();
 
-    // Holds all resource instances.
-    juce::Array<Instance*> resourceList;
+    // Maximum number of distinct resource keys, which must be a power of two:
+    static const constexpr int maxResources = 128;
 
-    // Holds all resource locks.
-    juce::OwnedArray<juce::ReadWriteLock> resourceLocks;
+    // Holds all resource instances and locks:
+    ResourceSlot slots[maxResources];
 };
@@ -22,7 +22,7 @@ SharedResource::Instance::Instance
     // this, the reference list is created with an initial null reference,
     // which the creating Reference will replace.
     references.add(nullptr);
-    Holder::getHolderInstance()->setResource(resourceKey, this);
+    Holder::setResource(resourceKey, this);
 }
 
 
@@ -64,10 +64,8 @@ int SharedResource::Instance::getReferenceCount() const
 void SharedResource::Instance::foreachReference
 (std::function<void(ReferenceInterface*)> referenceAction)
 {
-    Holder* resourceHolder = Holder::getHolderInstance();
-    const juce::ReadWriteLock& resourceLock = resourceHolder->getResourceLock
-        (resourceKey);
-    const juce::ScopedReadLock referenceListLock(resourceLock);
+    ResourceSlot& resourceSlot = Holder::getResourceSlot(resourceKey);
+    const ScopedSlotLock referenceListLock(resourceSlot, LockType::read);
 
     juce::Array<ReferenceInterface*> handledReferences;
     int referencesHandled;
@@ -80,9 +78,9 @@ void SharedResource::Instance::foreachReference
             if (reference != nullptr && !handledReferences.contains(reference))
             {
                 const juce::ScopedLock referenceLock(reference->getLock());
-                resourceLock.exitRead();
+                resourceSlot.exit(LockType::read);
                 referenceAction(reference);
-                resourceLock.enterRead();
+                resourceSlot.enter(LockType::read);
                 handledReferences.add(reference);
                 referencesHandled++;
             }
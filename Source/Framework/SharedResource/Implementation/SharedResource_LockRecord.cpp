@@ -0,0 +1,181 @@
+#define SHARED_RESOURCE_IMPLEMENTATION
+#ifdef SHARED_RESOURCE_LOCK_STATS
+#include "SharedResource_LockRecord.h"
+#include <utility>
+#include <vector>
+
+// Locks held by the current thread, paired with the time each lock was
+// acquired:
+static thread_local std::vector<std::pair<const SharedResource::LockRecord*,
+        juce::int64>> heldLocks;
+
+/**
+ * @brief  Converts a duration in high resolution ticks to microseconds.
+ *
+ * @param ticks  A duration measured with juce::Time::getHighResolutionTicks.
+ *
+ * @return       The duration in whole microseconds.
+ */
+static juce::uint64 ticksToMicroseconds(const juce::int64 ticks)
+{
+    return (juce::uint64) (juce::Time::highResolutionTicksToSeconds(ticks)
+            * 1000000.0);
+}
+
+
+/**
+ * @brief  Finds the histogram bucket that counts a duration.
+ *
+ * @param microseconds  A duration in microseconds.
+ *
+ * @return              The index of the histogram bucket for that duration.
+ */
+static int getBucket(const juce::uint64 microseconds)
+{
+    int bucket = 0;
+    juce::uint64 bucketLimit = 1;
+    while (bucket < SharedResource::LockStats::histogramSize - 1
+            && microseconds >= bucketLimit)
+    {
+        bucket++;
+        bucketLimit *= 10;
+    }
+    return bucket;
+}
+
+
+/**
+ * @brief  Describes the current thread and its call stack.
+ *
+ * @return  The thread's name and stack trace.
+ */
+static juce::String getCallSite()
+{
+    juce::String threadName;
+    juce::Thread* currentThread = juce::Thread::getCurrentThread();
+    if (currentThread != nullptr)
+    {
+        threadName = currentThread->getThreadName();
+    }
+    else if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        threadName = "Message thread";
+    }
+    else
+    {
+        threadName = "Thread " + juce::String::toHexString(
+                (juce::pointer_sized_int) juce::Thread::getCurrentThreadId());
+    }
+    return threadName + "\n" + juce::SystemStats::getStackBacktrace();
+}
+
+
+// Initializes all lock statistics to zero.
+SharedResource::LockRecord::LockRecord()
+{
+    readLocks.store(0);
+    writeLocks.store(0);
+    contendedLocks.store(0);
+    for (int i = 0; i < LockStats::histogramSize; i++)
+    {
+        waitHistogram[i].store(0);
+        holdHistogram[i].store(0);
+    }
+    totalWaitMicroseconds.store(0);
+    totalHoldMicroseconds.store(0);
+    longestHoldMicroseconds.store(0);
+}
+
+
+// Records that the calling thread acquired the resource lock.
+void SharedResource::LockRecord::recordAcquisition(const LockType lockType,
+        const bool contended, const juce::int64 waitDuration)
+{
+    const juce::uint64 waitMicroseconds = ticksToMicroseconds(waitDuration);
+    if (lockType == LockType::read)
+    {
+        readLocks++;
+    }
+    else
+    {
+        writeLocks++;
+    }
+    if (contended)
+    {
+        contendedLocks++;
+    }
+    waitHistogram[getBucket(waitMicroseconds)]++;
+    totalWaitMicroseconds += waitMicroseconds;
+    heldLocks.push_back(std::make_pair(this,
+                juce::Time::getHighResolutionTicks()));
+}
+
+
+// Records that the calling thread is releasing the resource lock.
+juce::uint64 SharedResource::LockRecord::recordRelease()
+{
+    // Locks are usually released in reverse order, so search from the end of
+    // the list:
+    for (auto heldLock = heldLocks.rbegin(); heldLock != heldLocks.rend();
+            heldLock++)
+    {
+        if (heldLock->first != this)
+        {
+            continue;
+        }
+        const juce::uint64 holdMicroseconds = ticksToMicroseconds(
+                juce::Time::getHighResolutionTicks() - heldLock->second);
+        heldLocks.erase(std::next(heldLock).base());
+        holdHistogram[getBucket(holdMicroseconds)]++;
+        totalHoldMicroseconds += holdMicroseconds;
+        return holdMicroseconds;
+    }
+    // Locks released on a different thread than the one that acquired them
+    // can't be timed.
+    return 0;
+}
+
+
+// Saves the calling thread's stack trace if it held the resource lock longer
+// than any previous lock holder.
+void SharedResource::LockRecord::recordHoldSite
+(const juce::uint64 holdMicroseconds)
+{
+    if (holdMicroseconds <= longestHoldMicroseconds.load())
+    {
+        return;
+    }
+    // Locks are released in the scope where they were acquired, so the
+    // releasing stack trace identifies the lock holder:
+    const juce::String callSite = getCallSite();
+    const juce::ScopedLock holdSiteLock(longestHoldGuard);
+    if (holdMicroseconds > longestHoldMicroseconds.load())
+    {
+        longestHoldMicroseconds.store(holdMicroseconds);
+        longestHoldSite = callSite;
+    }
+}
+
+
+// Copies all recorded statistics.
+SharedResource::LockStats::KeyStats SharedResource::LockRecord::getStats
+(const juce::Identifier& resourceKey) const
+{
+    LockStats::KeyStats stats;
+    stats.resourceKey = resourceKey;
+    stats.readLocks = readLocks.load();
+    stats.writeLocks = writeLocks.load();
+    stats.contendedLocks = contendedLocks.load();
+    for (int i = 0; i < LockStats::histogramSize; i++)
+    {
+        stats.waitHistogram[i] = waitHistogram[i].load();
+        stats.holdHistogram[i] = holdHistogram[i].load();
+    }
+    stats.totalWaitMilliseconds = totalWaitMicroseconds.load() / 1000.0;
+    stats.totalHoldMilliseconds = totalHoldMicroseconds.load() / 1000.0;
+    const juce::ScopedLock holdSiteLock(longestHoldGuard);
+    stats.longestHoldMilliseconds = longestHoldMicroseconds.load() / 1000.0;
+    stats.longestHoldSite = longestHoldSite;
+    return stats;
+}
+#endif
@@ -0,0 +1,99 @@
+#ifndef SHARED_RESOURCE_IMPLEMENTATION
+    #error File included directly outside of SharedResource implementation.
+#endif
+#pragma once
+/**
+ * @file  SharedResource_LockRecord.h
+ *
+ * @brief  Records lock statistics for a single resource lock.
+ */
+
+#include "JuceHeader.h"
+#include "SharedResource_LockType.h"
+#include "SharedResource_LockStats.h"
+#include <atomic>
+
+namespace SharedResource { class LockRecord; }
+
+/**
+ * @brief  Counts lock acquisitions, and measures lock wait and hold times for
+ *         a single ResourceSlot.
+ *
+ *  Counters are updated atomically, so recording never adds another lock
+ * shared between threads. Hold times are measured using a list of locks held
+ * by each thread, so read locks held by several threads at once are measured
+ * separately. The record of the longest hold is only locked when a new longest
+ * hold time is found, and its stack trace is collected after the resource lock
+ * is released.
+ */
+class SharedResource::LockRecord
+{
+public:
+    /**
+     * @brief  Initializes all lock statistics to zero.
+     */
+    LockRecord();
+
+    virtual ~LockRecord() { }
+
+    /**
+     * @brief  Records that the calling thread acquired the resource lock.
+     *
+     * @param lockType      The type of lock acquired.
+     *
+     * @param contended     Whether the thread had to wait for the lock.
+     *
+     * @param waitDuration  The time spent waiting, in high resolution ticks.
+     */
+    void recordAcquisition(const LockType lockType, const bool contended,
+            const juce::int64 waitDuration);
+
+    /**
+     * @brief  Records that the calling thread is releasing the resource lock.
+     *
+     *  This only measures the hold time. The caller should release the lock
+     * before passing the result to recordHoldSite, so collecting a stack trace
+     * never extends the time the lock is held.
+     *
+     * @return  The time the lock was held in microseconds, or zero if the lock
+     *          was not acquired on this thread.
+     */
+    juce::uint64 recordRelease();
+
+    /**
+     * @brief  Saves the calling thread's stack trace if it held the resource
+     *         lock longer than any previous lock holder.
+     *
+     * @param holdMicroseconds  The hold time returned by recordRelease.
+     */
+    void recordHoldSite(const juce::uint64 holdMicroseconds);
+
+    /**
+     * @brief  Copies all recorded statistics.
+     *
+     * @param resourceKey  The key of the resource using this record.
+     *
+     * @return             The current lock statistics.
+     */
+    LockStats::KeyStats getStats(const juce::Identifier& resourceKey) const;
+
+private:
+    std::atomic<juce::uint64> readLocks;
+    std::atomic<juce::uint64> writeLocks;
+    std::atomic<juce::uint64> contendedLocks;
+    std::atomic<juce::uint64> waitHistogram[LockStats::histogramSize];
+    std::atomic<juce::uint64> holdHistogram[LockStats::histogramSize];
+
+    // Total wait and hold times, in microseconds:
+    std::atomic<juce::uint64> totalWaitMicroseconds;
+    std::atomic<juce::uint64> totalHoldMicroseconds;
+
+    // Longest hold time, in microseconds:
+    std::atomic<juce::uint64> longestHoldMicroseconds;
+
+    // Guards access to the longest hold site:
+    juce::CriticalSection longestHoldGuard;
+    juce::String longestHoldSite;
+
+    JUCE_DECLARE_NON_COPYABLE(LockRecord);
+};
@@ -5,19 +5,10 @@
 // Initializes the resource pointer, locking the resource.
 SharedResource::LockedInstancePtr::LockedInstancePtr
 (const juce::Identifier& resourceKey, const LockType lockType) :
-resourceKey(resourceKey),
-lockType(lockType)
+lockType(lockType),
+resourceSlot(Holder::getResourceSlot(resourceKey))
 {
-    const juce::ReadWriteLock& resourceLock
-        = Holder::getHolderInstance()->getResourceLock(resourceKey);
-    if (lockType == LockType::read)
-    {
-        resourceLock.enterRead();
-    }
-    else
-    {
-        resourceLock.enterWrite();
-    }
+    resourceSlot.enter(lockType);
     locked = true;
 }
 
@@ -35,16 +26,7 @@ void SharedResource::LockedInstancePtr::unlock()
 {
     if (locked)
     {
-        const juce::ReadWriteLock& resourceLock
-            = Holder::getHolderInstance()->getResourceLock(resourceKey);
-        if (lockType == LockType::read)
-        {
-            resourceLock.exitRead();
-        }
-        else
-        {
-            resourceLock.exitWrite();
-        }
+        resourceSlot.exit(lockType);
         locked = false;
     }
 }
@@ -63,7 +45,7 @@ SharedResource::LockedInstancePtr::getInstance() const
 {
     if (locked)
     {
-        return Holder::getHolderInstance()->getResource(resourceKey);
+        return resourceSlot.instance.load(std::memory_order_acquire);
     }
     else
     {
@@ -13,6 +13,7 @@ namespace SharedResource
 {
     class LockedInstancePtr;
     class Instance;
+    struct ResourceSlot;
     template<class ResourceType> class LockedPtr;
     namespace Modular
     {
@@ -84,8 +85,9 @@ protected:
 private:
     // The type of resource lock the LockedInstancePtr maintains.
     const LockType lockType;
-    // Identifies the resource accessed by this LockedInstancePtr.
-    const juce::Identifier& resourceKey;
+    // Holds the Instance pointer and lock of the resource accessed by this
+    // LockedInstancePtr.
+    ResourceSlot& resourceSlot;
     // Stores if the resource is currently locked and may be accessed.
     bool locked = false;
 };
@@ -8,7 +8,7 @@
 SharedResource::Reference::~Reference()
 {
     {
-        const juce::ScopedWriteLock resourceLock(getResourceLock());
+        const ScopedSlotLock resourceLock(resourceSlot, LockType::write);
         const juce::ScopedLock referenceLock(getLock());
         Instance* resourceInstance = getResourceInstance();
         jassert(resourceInstance != nullptr);
@@ -20,7 +20,6 @@ SharedResource::Reference::~Reference()
             resourceInstance = nullptr;
         }
     }
-    Holder::clearIfEmpty();
 }
 
 
@@ -28,9 +27,10 @@ SharedResource::Reference::~Reference()
 // object if necessary.
 SharedResource::Reference::Reference(const juce::Identifier& resourceKey,
         const std::function<Instance*()> createResource) :
-resourceKey(resourceKey)
+resourceKey(resourceKey),
+resourceSlot(Holder::getResourceSlot(resourceKey))
 {
-    const juce::ScopedWriteLock initLock(getResourceLock());
+    const ScopedSlotLock initLock(resourceSlot, LockType::write);
     Instance* resourceInstance = getResourceInstance();
     if (resourceInstance == nullptr)
     {
@@ -46,10 +46,32 @@ resourceKey(resourceKey)
 }
 
 
+// Blocks the calling thread until it can lock the referenced resource.
+void SharedResource::Reference::enterResourceLock(const LockType lockType) const
+{
+    resourceSlot.enter(lockType);
+}
+
+
+// Attempts to lock the referenced resource without blocking.
+bool SharedResource::Reference::tryEnterResourceLock
+(const LockType lockType) const
+{
+    return resourceSlot.tryEnter(lockType);
+}
+
+
+// Releases a resource lock held by the calling thread.
+void SharedResource::Reference::exitResourceLock(const LockType lockType) const
+{
+    resourceSlot.exit(lockType);
+}
+
+
 // Gets the lock used to control access to the referenced resource.
 const juce::ReadWriteLock& SharedResource::Reference::getResourceLock() const
 {
-    return Holder::getResourceLock(resourceKey);
+    return resourceSlot.lock;
 }
 
 
@@ -57,5 +79,5 @@ const juce::ReadWriteLock& SharedResource::Reference::getResourceLock() const
 SharedResource::Instance*
 SharedResource::Reference::getResourceInstance() const
 {
-    return Holder::getResource(resourceKey);
+    return resourceSlot.instance.load(std::memory_order_acquire);
 }
@@ -9,11 +9,13 @@
 
 #include "JuceHeader.h"
 #include "SharedResource_ReferenceInterface.h"
+#include "SharedResource_LockType.h"
 
 namespace SharedResource
 {
     class Reference;
     class Instance;
+    struct ResourceSlot;
 }
 
 /**
@@ -45,6 +47,33 @@ public:
     template<class ResourceType> friend class Handler;
 
 protected:
+    /**
+     * @brief  Blocks the calling thread until it can lock the referenced
+     *         resource.
+     *
+     *  Unlike locking the lock returned by getResourceLock directly, this
+     * records lock statistics when SHARED_RESOURCE_LOCK_STATS is defined.
+     *
+     * @param lockType  The type of lock to acquire.
+     */
+    void enterResourceLock(const LockType lockType) const;
+
+    /**
+     * @brief  Attempts to lock the referenced resource without blocking.
+     *
+     * @param lockType  The type of lock to acquire.
+     *
+     * @return          Whether the lock was acquired.
+     */
+    bool tryEnterResourceLock(const LockType lockType) const;
+
+    /**
+     * @brief  Releases a resource lock held by the calling thread.
+     *
+     * @param lockType  The type of lock to release.
+     */
+    void exitResourceLock(const LockType lockType) const;
+
     /**
      * @brief  Gets the lock used to control access to the referenced resource.
      *
@@ -52,14 +81,22 @@ protected:
      */
     const juce::ReadWriteLock& getResourceLock() const;
 
-private:
     /**
      * @brief  Gets a pointer to this reference's resource object Instance.
      *
+     *  The Instance will exist for as long as this Reference exists, but it is
+     * not locked. Only data that is safe to access without the resource lock
+     * should be accessed through this pointer.
+     *
      * @return  The resource's unique object instance.
      */
     Instance* getResourceInstance() const;
 
+private:
+
     // The resource's unique key identifier.
     const juce::Identifier& resourceKey;
+
+    // Holds the resource's Instance pointer and lock:
+    ResourceSlot& resourceSlot;
 };
@@ -18,6 +18,29 @@ class SharedResource::ReferenceInterface
 public:
     virtual ~ReferenceInterface() { }
 
+    /**
+     * @brief  Checks if this Reference needs every queued update, instead of
+     *         only the most recent update with each update key.
+     *
+     *  By default, when a resource queues several updates with the same key
+     * before they are sent, only the last of those updates is sent. Override
+     * this to return true if the Reference must receive all of them.
+     *
+     * @return  Whether replaced updates should still be sent to this
+     *          Reference.
+     */
+    virtual bool needsEveryUpdate() const { return false; }
+
+    /**
+     * @brief  Called after this Reference receives all updates in a batch of
+     *         queued resource updates.
+     *
+     *  Override this to perform expensive work that depends on the updates,
+     * such as relayout or repainting, once per batch instead of once per
+     * update.
+     */
+    virtual void updateBatchFinished() { }
+
 protected:
     // Only the Reference and its Instance may access the lock.
     friend class Instance;
@@ -48,6 +48,28 @@ protected:
         parentResource.template foreachHandler<HandlerType>(notifyAction);
     }
 
+    /**
+     * @brief  Queues an update for each of this module's handler objects that
+     *         share a specific class, sending all queued updates together on
+     *         the message thread.
+     *
+     * @tparam HandlerType   The type of handler that should be acted on.
+     *
+     * @param updateKey      A key identifying the value the update describes,
+     *                       or the empty string if the update should never be
+     *                       replaced by a later update.
+     *
+     * @param handlerAction  A function to run on each valid module handler of
+     *                       type HandlerType.
+     */
+    template<class HandlerType>
+    void queueHandlerUpdate(const juce::String updateKey,
+            const std::function<void(HandlerType*)> handlerAction)
+    {
+        parentResource.template queueHandlerUpdate<HandlerType>(updateKey,
+                handlerAction);
+    }
+
     /**
      * @brief  Gets the Resource object that owns this module.
      *
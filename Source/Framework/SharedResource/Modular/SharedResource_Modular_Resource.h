@@ -80,4 +80,25 @@ private:
     {
         SharedResource::Resource::foreachHandler<HandlerType>(notifyAction);
     }
+
+    /**
+     * @brief  Queues an update for all of a module's Handlers that share a
+     *         specific type, sending all queued updates together on the
+     *         message thread.
+     *
+     * @tparam HandlerType   The Handler subclass that will be notified.
+     *
+     * @param updateKey      A key identifying the value the update describes,
+     *                       or the empty string if the update should never be
+     *                       replaced by a later update.
+     *
+     * @param notifyAction   The action to perform on each compatible handler.
+     */
+    template<class HandlerType>
+    void queueHandlerUpdate(const juce::String updateKey,
+            const std::function<void(HandlerType*)> notifyAction)
+    {
+        SharedResource::Resource::queueHandlerUpdate<HandlerType>(updateKey,
+                notifyAction);
+    }
 };
@@ -109,6 +109,27 @@ protected:
         return LockedPtr<LockedType>(resourceKey, LockType::write);
     }
 
+    /**
+     * @brief  Gets a pointer to the class resource without locking it.
+     *
+     *  Handlers may use this to read data that the Resource stores in a
+     * SharedResource::Snapshot, or any other Resource data that is safe to
+     * read without the resource lock. The Resource will exist for as long as
+     * the Handler exists.
+     *
+     * @tparam LockedType  Optionally specifies a different class pointer type
+     *                     that should be used to represent the resource. This
+     *                     type must be a valid class of the resource object
+     *                     instance.
+     *
+     * @return             An unlocked pointer to the class Resource instance.
+     */
+    template <class LockedType = ResourceType>
+    const LockedType* getSnapshotResource() const
+    {
+        return static_cast<const LockedType*>(getResourceInstance());
+    }
+
     /**
      * @brief  Gets the key that identifies this Handler object's resource.
      *
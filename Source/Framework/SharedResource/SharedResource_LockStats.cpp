@@ -0,0 +1,110 @@
+#define SHARED_RESOURCE_IMPLEMENTATION
+#include "SharedResource_LockStats.h"
+#include "SharedResource_Holder.h"
+#include <iostream>
+
+// Gets the range of times counted by a histogram bucket.
+juce::String SharedResource::LockStats::getBucketName(const int bucket)
+{
+    static const char* bucketNames[histogramSize] =
+    {
+        "<1us", "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s"
+    };
+    jassert(bucket >= 0 && bucket < histogramSize);
+    return bucketNames[bucket];
+}
+
+
+// Gets statistics for every resource that has been locked.
+juce::Array<SharedResource::LockStats::KeyStats>
+SharedResource::LockStats::getAllStats()
+{
+    juce::Array<KeyStats> allStats;
+#ifdef SHARED_RESOURCE_LOCK_STATS
+    for (ResourceSlot* slot : Holder::getAssignedSlots())
+    {
+        KeyStats slotStats = slot->lockRecord.getStats(slot->resourceKey);
+        if (slotStats.readLocks > 0 || slotStats.writeLocks > 0)
+        {
+            allStats.add(slotStats);
+        }
+    }
+#endif
+    return allStats;
+}
+
+
+// Gets statistics for a single resource.
+SharedResource::LockStats::KeyStats SharedResource::LockStats::getStats
+(const juce::Identifier& resourceKey)
+{
+    for (const KeyStats& keyStats : getAllStats())
+    {
+        if (keyStats.resourceKey == resourceKey)
+        {
+            return keyStats;
+        }
+    }
+    KeyStats emptyStats;
+    emptyStats.resourceKey = resourceKey;
+    return emptyStats;
+}
+
+
+/**
+ * @brief  Prints a single lock time histogram.
+ *
+ * @param title      The histogram's title.
+ *
+ * @param histogram  The number of times counted in each bucket.
+ */
+static void printHistogram(const char* title, const juce::uint64* histogram)
+{
+    using namespace SharedResource::LockStats;
+    std::cout << "    " << title << ":";
+    for (int i = 0; i < histogramSize; i++)
+    {
+        if (histogram[i] > 0)
+        {
+            std::cout << " " << getBucketName(i) << "=" << histogram[i];
+        }
+    }
+    std::cout << "\n";
+}
+
+
+// Prints statistics for all resources, ordered by total wait time.
+void SharedResource::LockStats::printStats()
+{
+    using std::cout;
+    juce::Array<KeyStats> allStats = getAllStats();
+    if (allStats.isEmpty())
+    {
+        return;
+    }
+    std::sort(allStats.begin(), allStats.end(),
+            [](const KeyStats& first, const KeyStats& second)
+            {
+                return first.totalWaitMilliseconds
+                        > second.totalWaitMilliseconds;
+            });
+    cout << "\nPrinting SharedResource lock statistics for "
+            << allStats.size() << " resources:\n";
+    for (const KeyStats& keyStats : allStats)
+    {
+        cout << "\n" << keyStats.resourceKey.toString() << ":\n";
+        cout << "    Read locks: " << keyStats.readLocks
+                << ", write locks: " << keyStats.writeLocks
+                << ", contended: " << keyStats.contendedLocks << "\n";
+        cout << "    Total wait: " << keyStats.totalWaitMilliseconds
+                << "ms, total hold: " << keyStats.totalHoldMilliseconds
+                << "ms, longest hold: " << keyStats.longestHoldMilliseconds
+                << "ms\n";
+        printHistogram("Wait times", keyStats.waitHistogram);
+        printHistogram("Hold times", keyStats.holdHistogram);
+        if (keyStats.longestHoldSite.isNotEmpty())
+        {
+            cout << "    Longest hold by " << keyStats.longestHoldSite << "\n";
+        }
+    }
+}
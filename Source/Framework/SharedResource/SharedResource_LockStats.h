@@ -0,0 +1,106 @@
+#pragma once
+/**
+ * @file  SharedResource_LockStats.h
+ *
+ * @brief  Reports how often each resource lock is used, and how long threads
+ *         wait for and hold each lock.
+ */
+
+#include "JuceHeader.h"
+
+/**
+ *  Lock statistics are only recorded when the application is built with
+ * SHARED_RESOURCE_LOCK_STATS defined. Every resource lock acquisition made
+ * through a LockedPtr, Modular::LockedPtr, Thread::Lock, or Thread scoped lock
+ * is counted, along with the time spent waiting for the lock and the time the
+ * lock was held. When a lock is held longer than any previous hold, the
+ * releasing thread's stack trace is saved to identify the slowest lock holder.
+ *
+ *  When lock statistics are disabled, getAllStats returns an empty list and
+ * printStats does nothing.
+ */
+namespace SharedResource
+{
+    namespace LockStats
+    {
+        // Whether lock statistics are being recorded:
+#ifdef SHARED_RESOURCE_LOCK_STATS
+        static const constexpr bool enabled = true;
+#else
+        static const constexpr bool enabled = false;
+#endif
+
+        // Number of wait time and hold time histogram buckets. Each bucket's
+        // upper limit is ten times larger than the previous bucket's, starting
+        // at one microsecond. The last bucket holds all longer times.
+        static const constexpr int histogramSize = 8;
+
+        /**
+         * @brief  All lock statistics recorded for a single resource.
+         */
+        struct KeyStats
+        {
+            // The resource's unique key:
+            juce::Identifier resourceKey;
+
+            // Number of times the resource was locked for reading:
+            juce::uint64 readLocks = 0;
+
+            // Number of times the resource was locked for writing:
+            juce::uint64 writeLocks = 0;
+
+            // Number of lock attempts that had to wait for another thread:
+            juce::uint64 contendedLocks = 0;
+
+            // Number of lock acquisitions in each wait time bucket:
+            juce::uint64 waitHistogram[histogramSize] = {};
+
+            // Number of lock releases in each hold time bucket:
+            juce::uint64 holdHistogram[histogramSize] = {};
+
+            // Total time spent waiting to lock the resource:
+            double totalWaitMilliseconds = 0;
+
+            // Total time the resource was held locked:
+            double totalHoldMilliseconds = 0;
+
+            // Longest time the resource was held locked:
+            double longestHoldMilliseconds = 0;
+
+            // The thread and stack trace that held the lock the longest:
+            juce::String longestHoldSite;
+        };
+
+        /**
+         * @brief  Gets the range of times counted by a histogram bucket.
+         *
+         * @param bucket  A histogram bucket index.
+         *
+         * @return        A short description of the bucket's time range.
+         */
+        juce::String getBucketName(const int bucket);
+
+        /**
+         * @brief  Gets statistics for every resource that has been locked.
+         *
+         * @return  Statistics for each resource key.
+         */
+        juce::Array<KeyStats> getAllStats();
+
+        /**
+         * @brief  Gets statistics for a single resource.
+         *
+         * @param resourceKey  The resource's unique key.
+         *
+         * @return             The resource's statistics, or empty statistics if
+         *                     the resource was never locked.
+         */
+        KeyStats getStats(const juce::Identifier& resourceKey);
+
+        /**
+         * @brief  Prints statistics for all resources, ordered by total wait
+         *         time.
+         */
+        void printStats();
+    }
+}
@@ -18,20 +18,10 @@ std::function<void()> SharedResource::Resource::buildAsyncFunction(
     const juce::Identifier& resKey = getResourceKey();
     return [this, lockType, resKey, action, ifDestroyed]()
     {
-        Holder* resourceHolder = Holder::getHolderInstance();
-        if (lockType == LockType::read)
+        ResourceSlot& resourceSlot = Holder::getResourceSlot(resKey);
         {
-            juce::ScopedReadLock(resourceHolder->getResourceLock(resKey));
-            if (this == resourceHolder->getResource(resKey))
-            {
-                action();
-                return;
-            }
-        }
-        else
-        {
-            juce::ScopedWriteLock(resourceHolder->getResourceLock(resKey));
-            if (this == resourceHolder->getResource(resKey))
+            const ScopedSlotLock resourceLock(resourceSlot, lockType);
+            if (this == resourceSlot.instance.load())
             {
                 action();
                 return;
@@ -42,3 +32,67 @@ std::function<void()> SharedResource::Resource::buildAsyncFunction(
         ifDestroyed();
     };
 }
+
+
+// Adds an update to the queue of updates waiting to be sent, scheduling the
+// queue to be sent if necessary.
+void SharedResource::Resource::addPendingUpdate(const juce::String updateKey,
+        const UpdateAction updateAction)
+{
+    const juce::ScopedLock updateLock(updateGuard);
+    if (updateKey.isNotEmpty())
+    {
+        for (PendingUpdate& pendingUpdate : pendingUpdates)
+        {
+            if (pendingUpdate.updateKey == updateKey)
+            {
+                pendingUpdate.replaced = true;
+            }
+        }
+    }
+    pendingUpdates.push_back({ updateKey, updateAction, {}, false });
+    if (!updateScheduled)
+    {
+        updateScheduled = true;
+        juce::MessageManager::callAsync(buildAsyncFunction(LockType::read,
+                [this]() { sendPendingUpdates(); }));
+    }
+}
+
+
+// Sends all queued updates to all Handlers, then clears the update queue.
+void SharedResource::Resource::sendPendingUpdates()
+{
+    std::vector<PendingUpdate> updates;
+    {
+        const juce::ScopedLock updateLock(updateGuard);
+        updates.swap(pendingUpdates);
+        updateScheduled = false;
+    }
+    juce::Array<void*> finishedObjects;
+    foreachReference([&updates, &finishedObjects]
+            (ReferenceInterface* reference)
+    {
+        const bool sendReplaced = reference->needsEveryUpdate();
+        bool receivedUpdate = false;
+        for (PendingUpdate& update : updates)
+        {
+            if (update.replaced && !sendReplaced)
+            {
+                continue;
+            }
+            if (update.updateAction(reference, update.updatedHandlers))
+            {
+                receivedUpdate = true;
+            }
+        }
+        // Objects connected through multiple Handler subclasses should still
+        // only finish each batch once:
+        void* const referenceObject = dynamic_cast<void*>(reference);
+        if (receivedUpdate && !finishedObjects.contains(referenceObject))
+        {
+            finishedObjects.add(referenceObject);
+            reference->updateBatchFinished();
+        }
+    });
+}
@@ -9,6 +9,7 @@
 #include "SharedResource_Instance.h"
 #include "SharedResource_ReferenceInterface.h"
 #include "SharedResource_LockType.h"
+#include <vector>
 
 namespace SharedResource { class Resource; }
 
@@ -22,6 +23,12 @@ namespace SharedResource { class Resource; }
  *  Each concrete Resource subclass must declare a unique, constant identifying
  * key, publicly available as a juce::Identifier named resourceKey. Resource
  * subclasses must also only use the default constructor.
+ *
+ *  Resources may notify their Handlers immediately with foreachHandler, or
+ * queue notifications with queueHandlerUpdate. Queued updates are sent
+ * together on the message thread once the current message loop turn ends, so
+ * many changes made in quick succession only require one pass through the
+ * resource's Handlers.
  */
 class SharedResource::Resource : public Instance
 {
@@ -89,6 +96,96 @@ protected:
         });
     }
 
+    /**
+     * @brief  Queues an update to run on each Handler object with type
+     *         HandlerType, sending all queued updates together on the message
+     *         thread.
+     *
+     *  All updates queued before the batch is sent are sent in the order they
+     * were queued. If an update with the same update key is already waiting,
+     * the earlier update is replaced, and will only be sent to Handlers that
+     * need every update. After a Handler receives all of its updates, its
+     * updateBatchFinished function is called once.
+     *
+     * @tparam HandlerType   The handlerAction will only run for Handlers that
+     *                       have this type.
+     *
+     * @param updateKey      A key identifying the value the update describes,
+     *                       or the empty string if the update should never be
+     *                       replaced by a later update.
+     *
+     * @param handlerAction  Some action that should run for every HandlerType
+     *                       connected to this SharedResource, passing in a
+     *                       pointer to the HandlerType as a parameter.
+     */
+    template<class HandlerType>
+    void queueHandlerUpdate(const juce::String updateKey,
+            const std::function<void(HandlerType*)> handlerAction)
+    {
+        addPendingUpdate(updateKey, [handlerAction]
+                (ReferenceInterface* reference, juce::Array<void*>& updated)
+        {
+            // As in foreachHandler, make sure objects connected through
+            // multiple Handler subclasses are only updated once.
+            HandlerType* handler = dynamic_cast<HandlerType*>(reference);
+            if (handler != nullptr && !updated.contains(handler))
+            {
+                handlerAction(handler);
+                updated.add(handler);
+                return true;
+            }
+            return false;
+        });
+    }
+
 private:
+    // Runs a queued update on a Reference if it has the update's Handler type,
+    // adding the handler to a list of updated handlers. This returns whether
+    // the update ran.
+    typedef std::function<bool(ReferenceInterface*, juce::Array<void*>&)>
+            UpdateAction;
+
+    /**
+     * @brief  Adds an update to the queue of updates waiting to be sent,
+     *         scheduling the queue to be sent if necessary.
+     *
+     * @param updateKey     The key identifying the update, or the empty
+     *                      string if the update should never be replaced.
+     *
+     * @param updateAction  The action to run on each Reference.
+     */
+    void addPendingUpdate(const juce::String updateKey,
+            const UpdateAction updateAction);
+
+    /**
+     * @brief  Sends all queued updates to all Handlers, then clears the update
+     *         queue.
+     */
+    void sendPendingUpdates();
+
+    /**
+     * @brief  An update waiting to be sent to the resource's Handlers.
+     */
+    struct PendingUpdate
+    {
+        // Identifies the value the update describes:
+        juce::String updateKey;
+        // Runs the update on a single Reference:
+        UpdateAction updateAction;
+        // Handlers that already received the update:
+        juce::Array<void*> updatedHandlers;
+        // Whether a later update with the same key was queued:
+        bool replaced;
+    };
+
+    // Guards access to the update queue:
+    juce::CriticalSection updateGuard;
+
+    // Updates waiting to be sent:
+    std::vector<PendingUpdate> pendingUpdates;
+
+    // Whether sending the update queue is already scheduled:
+    bool updateScheduled = false;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Resource)
 };
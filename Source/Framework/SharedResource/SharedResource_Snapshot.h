@@ -0,0 +1,143 @@
+#pragma once
+/**
+ * @file  SharedResource_Snapshot.h
+ *
+ * @brief  Stores resource data as a series of immutable snapshots that may be
+ *         read without locking the resource.
+ */
+
+#include "JuceHeader.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace SharedResource { template<class DataType> class Snapshot; }
+
+/**
+ * @brief  Holds read-mostly Resource data that Handlers may read without
+ *         locking their Resource.
+ *
+ *  Resources that are read constantly but rarely changed may store their data
+ * in a Snapshot. Writers never change published data. Instead, they publish a
+ * new immutable copy of the data, which replaces the previous copy for all
+ * later readers. Readers get a reference-counted pointer to the current copy
+ * using only a few atomic operations, and may keep using that copy for as long
+ * as they hold the pointer, even if newer data is published.
+ *
+ *  Before a replaced copy is released, publishing threads wait until every
+ * reader that could still be copying its pointer has finished. Readers are
+ * counted using two alternating counters, so readers that start after new data
+ * is published never delay the publishing thread.
+ *
+ *  Resources that use a Snapshot should still hold their resource lock for
+ * writing while publishing changes, so that changes are applied in the same
+ * order that Handlers see them. Handlers may read Snapshot data through
+ * Handler::getSnapshotResource without locking the resource.
+ *
+ * @tparam DataType  The type of data stored in the snapshot. This type must be
+ *                   copy-constructible.
+ */
+template<class DataType>
+class SharedResource::Snapshot
+{
+public:
+    // A reference-counted pointer to one immutable copy of the data:
+    typedef std::shared_ptr<const DataType> Ptr;
+
+    /**
+     * @brief  Creates the snapshot with an initial copy of its data.
+     *
+     * @param initialData  The initial data copy readers will access.
+     */
+    Snapshot(Ptr initialData = std::make_shared<const DataType>()) :
+    current(new Version { initialData })
+    {
+        readerCounts[0].store(0);
+        readerCounts[1].store(0);
+    }
+
+    virtual ~Snapshot()
+    {
+        delete current.load();
+    }
+
+    /**
+     * @brief  Gets the most recently published copy of the data without
+     *         locking.
+     *
+     * @return  A pointer to the current data, which will remain valid and
+     *          unchanged for as long as the pointer exists.
+     */
+    Ptr read() const
+    {
+        std::atomic<int>& readerCount = readerCounts[epoch.load() & 1];
+        readerCount++;
+        Ptr data = current.load()->data;
+        readerCount--;
+        return data;
+    }
+
+    /**
+     * @brief  Replaces the current data with a new copy.
+     *
+     *  This waits for all readers that may still be copying the previous data
+     * pointer to finish before returning.
+     *
+     * @param newData  The data copy all later readers will access.
+     */
+    void publish(Ptr newData)
+    {
+        const juce::ScopedLock publishLock(publishGuard);
+        Version* const oldVersion = current.exchange(new Version { newData });
+        // Each counter must reach zero once after the new version was
+        // published. New readers always use the counter not being checked, so
+        // each wait only depends on readers that were already running.
+        for (int i = 0; i < 2; i++)
+        {
+            const std::atomic<int>& readerCount = readerCounts[epoch++ & 1];
+            while (readerCount.load() > 0)
+            {
+                juce::Thread::yield();
+            }
+        }
+        delete oldVersion;
+    }
+
+    /**
+     * @brief  Copies the current data, changes the copy, and publishes it.
+     *
+     * @param editAction  A function that changes the copied data.
+     */
+    void edit(const std::function<void(DataType&)> editAction)
+    {
+        const juce::ScopedLock publishLock(publishGuard);
+        std::shared_ptr<DataType> newData
+                = std::make_shared<DataType>(*current.load()->data);
+        editAction(*newData);
+        publish(newData);
+    }
+
+private:
+    /**
+     * @brief  Holds one published data pointer, so that the pointer can be
+     *         replaced with a single atomic exchange.
+     */
+    struct Version
+    {
+        Ptr data;
+    };
+
+    // The most recently published data:
+    std::atomic<Version*> current;
+
+    // Selects which reader counter new readers increment:
+    std::atomic<unsigned int> epoch { 0 };
+
+    // Counts readers currently copying a data pointer:
+    mutable std::atomic<int> readerCounts[2];
+
+    // Ensures only one thread publishes data at a time:
+    juce::CriticalSection publishGuard;
+
+    JUCE_DECLARE_NON_COPYABLE(Snapshot);
+};
@@ -0,0 +1,145 @@
+#include "SharedResource_Thread_JobPool.h"
+#include <chrono>
+
+// Whether jobs run within the shared Thread::Pool instead of on private
+// threads:
+#ifdef SHARED_RESOURCE_THREAD_POOL
+static const constexpr bool useThreadPool = true;
+#else
+static const constexpr bool useThreadPool = false;
+#endif
+
+namespace ThreadResource = SharedResource::Thread;
+
+// Creates a JobPool that runs up to a specific number of jobs at once.
+ThreadResource::JobPool::JobPool(const int maxThreads) :
+pool(useThreadPool ? Pool::getSharedPool() : nullptr),
+threadPool(useThreadPool ? nullptr : new juce::ThreadPool(maxThreads)),
+maxThreads(maxThreads) { }
+
+
+// Cancels all jobs, waiting for running jobs to stop before destruction.
+ThreadResource::JobPool::~JobPool()
+{
+    removeAllJobs();
+}
+
+
+// Gets the number of jobs that may run at the same time.
+int ThreadResource::JobPool::getNumThreads() const
+{
+    if (pool == nullptr)
+    {
+        return threadPool->getNumThreads();
+    }
+    return juce::jmin(maxThreads, pool->getNumWorkers());
+}
+
+
+// Adds a job to run on another thread.
+void ThreadResource::JobPool::addJob(juce::ThreadPoolJob* job)
+{
+    if (pool == nullptr)
+    {
+        threadPool->addJob(job, false);
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> jobLock(jobMutex);
+        unfinishedJobs.insert(job);
+    }
+    pool->addTask([this, job]() { runPoolJob(job); });
+}
+
+
+// Waits until a job finishes running.
+bool ThreadResource::JobPool::waitForJobToFinish
+(juce::ThreadPoolJob* job, const int timeoutMS)
+{
+    if (pool == nullptr)
+    {
+        return threadPool->waitForJobToFinish(job, timeoutMS);
+    }
+    return waitForPoolJobs([this, job]()
+    {
+        return unfinishedJobs.count(job) == 0;
+    }, timeoutMS);
+}
+
+
+// Tells all jobs to stop, removes all jobs that haven't started, and waits
+// until all running jobs stop.
+void ThreadResource::JobPool::removeAllJobs()
+{
+    if (pool == nullptr)
+    {
+        threadPool->removeAllJobs(true, -1);
+        return;
+    }
+    {
+        // Jobs that haven't started will be skipped when their tasks run:
+        std::unique_lock<std::mutex> jobLock(jobMutex);
+        for (juce::ThreadPoolJob* job : unfinishedJobs)
+        {
+            job->signalJobShouldExit();
+        }
+    }
+    waitForPoolJobs([this]() { return unfinishedJobs.empty(); }, -1);
+}
+
+
+// Runs a job within the shared Thread::Pool until it finishes or is told to
+// stop.
+void ThreadResource::JobPool::runPoolJob(juce::ThreadPoolJob* job)
+{
+    while (!job->shouldExit() && job->runJob()
+            == juce::ThreadPoolJob::jobNeedsRunningAgain) { }
+    // The JobPool may be destroyed as soon as the last job is removed, so
+    // nothing may access it after the jobMutex is released:
+    std::unique_lock<std::mutex> jobLock(jobMutex);
+    unfinishedJobs.erase(job);
+    jobCondition.notify_all();
+}
+
+
+// Waits until all of this JobPool's jobs that match a condition are finished,
+// running other pool tasks while waiting.
+bool ThreadResource::JobPool::waitForPoolJobs
+(const std::function<bool()> isFinished, const int timeoutMS)
+{
+    using std::chrono::steady_clock;
+    const steady_clock::time_point endTime = steady_clock::now()
+            + std::chrono::milliseconds(juce::jmax(0, timeoutMS));
+    std::unique_lock<std::mutex> jobLock(jobMutex);
+    while (!isFinished())
+    {
+        // If the waiting thread is a pool worker, a job that hasn't started
+        // may be queued behind it, so run waiting tasks before sleeping:
+        jobLock.unlock();
+        const bool ranTask = pool->runPendingTask();
+        jobLock.lock();
+        if (isFinished())
+        {
+            return true;
+        }
+        if (timeoutMS >= 0 && steady_clock::now() >= endTime)
+        {
+            return false;
+        }
+        if (ranTask)
+        {
+            continue;
+        }
+        // Unfinished jobs are running or will be run by other pool workers,
+        // which notify the jobCondition whenever a job finishes:
+        if (timeoutMS < 0)
+        {
+            jobCondition.wait(jobLock);
+        }
+        else
+        {
+            jobCondition.wait_until(jobLock, endTime);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,133 @@
+#pragma once
+/**
+ * @file  SharedResource_Thread_JobPool.h
+ *
+ * @brief  Runs a thread resource's background jobs, sharing the resource
+ *         thread pool when pool mode is enabled.
+ */
+
+#include "SharedResource_Thread_Pool.h"
+#include "JuceHeader.h"
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace SharedResource { namespace Thread { class JobPool; } }
+
+/**
+ * @brief  Runs juce::ThreadPoolJob objects for a SharedResource thread, either
+ *         as tasks within the shared Thread::Pool, or on a private
+ *         juce::ThreadPool.
+ *
+ *  Thread resources use JobPool objects to split work between several jobs
+ * that run alongside the resource thread. When the application is built with
+ * SHARED_RESOURCE_THREAD_POOL defined, jobs run within the shared Thread::Pool
+ * and the JobPool creates no threads of its own. Otherwise, the JobPool runs
+ * jobs within its own juce::ThreadPool.
+ *
+ *  In pool mode, a pool worker that waits for a job runs other waiting pool
+ * tasks until the job finishes, so a Thread running within the pool can wait
+ * for its own jobs without leaving them stuck behind it in the pool's queues.
+ *
+ *  JobPool objects never delete their jobs. Jobs must not be deleted until
+ * they have finished running, or until removeAllJobs returns.
+ */
+class SharedResource::Thread::JobPool
+{
+public:
+    /**
+     * @brief  Creates a JobPool that runs up to a specific number of jobs at
+     *         once.
+     *
+     * @param maxThreads  The number of threads to create when not running
+     *                    within the shared Thread::Pool. In pool mode, this
+     *                    limits the value returned by getNumThreads.
+     */
+    JobPool(const int maxThreads);
+
+    /**
+     * @brief  Cancels all jobs, waiting for running jobs to stop before
+     *         destruction.
+     */
+    virtual ~JobPool();
+
+    /**
+     * @brief  Gets the number of jobs that may run at the same time.
+     *
+     * @return  The number of threads that may run this JobPool's jobs.
+     */
+    int getNumThreads() const;
+
+    /**
+     * @brief  Adds a job to run on another thread.
+     *
+     * @param job  A job that will not be deleted until it finishes running.
+     */
+    void addJob(juce::ThreadPoolJob* job);
+
+    /**
+     * @brief  Waits until a job finishes running.
+     *
+     * @param job        A job that was added to this JobPool.
+     *
+     * @param timeoutMS  The maximum number of milliseconds to wait, or -1 to
+     *                   wait indefinitely.
+     *
+     * @return           Whether the job finished before the timeout.
+     */
+    bool waitForJobToFinish(juce::ThreadPoolJob* job, const int timeoutMS);
+
+    /**
+     * @brief  Tells all jobs to stop, removes all jobs that haven't started,
+     *         and waits until all running jobs stop.
+     */
+    void removeAllJobs();
+
+private:
+    /**
+     * @brief  Runs a job within the shared Thread::Pool until it finishes or
+     *         is told to stop.
+     *
+     * @param job  A job added to this JobPool.
+     */
+    void runPoolJob(juce::ThreadPoolJob* job);
+
+    /**
+     * @brief  Waits until all of this JobPool's jobs that match a condition
+     *         are finished, running other pool tasks while waiting.
+     *
+     * @param isFinished  Checks if waiting is done. This is only called while
+     *                    the jobMutex is locked.
+     *
+     * @param timeoutMS   The maximum number of milliseconds to wait, or -1 to
+     *                    wait indefinitely.
+     *
+     * @return            Whether waiting finished before the timeout.
+     */
+    bool waitForPoolJobs(const std::function<bool()> isFinished,
+            const int timeoutMS);
+
+    // The shared pool used to run jobs, or nullptr if jobs run within the
+    // private threadPool:
+    const std::shared_ptr<Pool> pool;
+
+    // The private pool used to run jobs, or nullptr if jobs run within the
+    // shared pool:
+    std::unique_ptr<juce::ThreadPool> threadPool;
+
+    // The maximum number of jobs that may run at once:
+    const int maxThreads;
+
+    // Guards the set of unfinished pool jobs, and notifies threads waiting for
+    // jobs to finish:
+    std::mutex jobMutex;
+    std::condition_variable jobCondition;
+
+    // All jobs added to the shared pool that haven't finished or been
+    // skipped:
+    std::set<juce::ThreadPoolJob*> unfinishedJobs;
+
+    JUCE_DECLARE_NON_COPYABLE(JobPool);
+};
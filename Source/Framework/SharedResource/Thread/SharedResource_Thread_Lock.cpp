@@ -9,14 +9,14 @@ SharedResource::Thread::Lock::Lock(const juce::Identifier& resourceKey) :
 // Blocks the thread until it can be locked for reading.
 void SharedResource::Thread::Lock::enterRead() const
 {
-    getResourceLock().enterRead();
+    enterResourceLock(LockType::read);
 }
 
 
 // Blocks the thread until it can be locked for writing.
 void SharedResource::Thread::Lock::enterWrite() const
 {
-    getResourceLock().enterWrite();
+    enterResourceLock(LockType::write);
 }
 
 
@@ -24,7 +24,7 @@ void SharedResource::Thread::Lock::enterWrite() const
 // call to takeReadLock.
 void SharedResource::Thread::Lock::exitRead() const
 {
-    getResourceLock().exitRead();
+    exitResourceLock(LockType::read);
 }
 
 
@@ -32,7 +32,7 @@ void SharedResource::Thread::Lock::exitRead() const
 // call to takeWriteLock.
 void SharedResource::Thread::Lock::exitWrite() const
 {
-    getResourceLock().exitWrite();
+    exitResourceLock(LockType::write);
 }
 
 
@@ -40,7 +40,7 @@ void SharedResource::Thread::Lock::exitWrite() const
 // if the lock can't be acquired.
 bool SharedResource::Thread::Lock::tryEnterRead() const
 {
-    return getResourceLock().tryEnterRead();
+    return tryEnterResourceLock(LockType::read);
 }
 
 
@@ -48,5 +48,5 @@ bool SharedResource::Thread::Lock::tryEnterRead() const
 // if the lock can't be acquired.
 bool SharedResource::Thread::Lock::tryEnterWrite() const
 {
-    return getResourceLock().tryEnterWrite();
+    return tryEnterResourceLock(LockType::write);
 }
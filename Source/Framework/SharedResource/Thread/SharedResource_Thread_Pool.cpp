@@ -0,0 +1,183 @@
+#include "SharedResource_Thread_Pool.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "SharedResource::Thread::Pool::";
+#endif
+
+// Worker thread name:
+static const constexpr char* workerName = "SharedResource_Thread_Pool";
+
+// Number of milliseconds to wait for each worker to exit before forcibly
+// terminating it:
+static const constexpr int timeoutMilliseconds = 5000;
+
+// Tracks the shared pool without keeping it alive:
+static std::weak_ptr<SharedResource::Thread::Pool> sharedPool;
+
+// Guards access to the shared pool pointer:
+static std::mutex sharedPoolMutex;
+
+// Index of the pool worker running on the current thread, or -1 if the current
+// thread isn't a pool worker:
+static thread_local int currentWorkerIndex = -1;
+
+namespace ThreadResource = SharedResource::Thread;
+
+// Creates a thread pool and starts all of its worker threads.
+ThreadResource::Pool::Pool(const int numWorkers)
+{
+    DBG(dbgPrefix << __func__ << ": Creating pool with " << numWorkers
+            << " worker threads.");
+    for (int i = 0; i < numWorkers; i++)
+    {
+        workers.add(new Worker(*this, i));
+    }
+    for (Worker* worker : workers)
+    {
+        worker->startThread();
+    }
+}
+
+
+// Stops all worker threads, discarding any tasks that haven't started running.
+ThreadResource::Pool::~Pool()
+{
+    DBG(dbgPrefix << __func__ << ": Stopping all worker threads.");
+    // The pool should never be destroyed by one of its own tasks:
+    jassert(currentWorkerIndex < 0);
+    for (Worker* worker : workers)
+    {
+        worker->signalThreadShouldExit();
+    }
+    {
+        std::unique_lock<std::mutex> idleLock(idleMutex);
+        stopping = true;
+        idleCondition.notify_all();
+    }
+    for (Worker* worker : workers)
+    {
+        worker->stopThread(timeoutMilliseconds);
+    }
+    workers.clear();
+}
+
+
+// Gets the shared thread pool, creating it if it doesn't already exist.
+std::shared_ptr<ThreadResource::Pool> ThreadResource::Pool::getSharedPool()
+{
+    std::unique_lock<std::mutex> poolLock(sharedPoolMutex);
+    std::shared_ptr<Pool> pool = sharedPool.lock();
+    if (pool == nullptr)
+    {
+        pool.reset(new Pool(juce::SystemStats::getNumCpus()));
+        sharedPool = pool;
+    }
+    return pool;
+}
+
+
+// Schedules a task to run on one of the pool's worker threads.
+void ThreadResource::Pool::addTask(const std::function<void()> task)
+{
+    const int workerIndex = (currentWorkerIndex >= 0)
+            ? currentWorkerIndex
+            : (int) (nextWorker++ % (unsigned int) workers.size());
+    Worker* worker = workers.getUnchecked(workerIndex);
+    {
+        std::unique_lock<std::mutex> taskLock(worker->taskMutex);
+        worker->tasks.push_back(task);
+    }
+    std::unique_lock<std::mutex> idleLock(idleMutex);
+    pendingTasks++;
+    idleCondition.notify_one();
+}
+
+
+// Runs one task waiting in the pool on the calling thread, if the calling
+// thread is one of the pool's worker threads.
+bool ThreadResource::Pool::runPendingTask()
+{
+    if (currentWorkerIndex < 0)
+    {
+        return false;
+    }
+    std::function<void()> task;
+    if (!takeTask(currentWorkerIndex, task))
+    {
+        return false;
+    }
+    task();
+    return true;
+}
+
+
+// Gets the number of worker threads in the pool.
+int ThreadResource::Pool::getNumWorkers() const
+{
+    return workers.size();
+}
+
+
+// Takes the next task a worker should run, checking the worker's own queue
+// before taking tasks from other workers.
+bool ThreadResource::Pool::takeTask
+(const int workerIndex, std::function<void()>& task)
+{
+    for (int i = 0; i < workers.size(); i++)
+    {
+        const bool ownQueue = (i == 0);
+        Worker* worker = workers.getUnchecked((workerIndex + i)
+                % workers.size());
+        std::unique_lock<std::mutex> taskLock(worker->taskMutex);
+        if (worker->tasks.empty())
+        {
+            continue;
+        }
+        if (ownQueue)
+        {
+            task = std::move(worker->tasks.front());
+            worker->tasks.pop_front();
+        }
+        else
+        {
+            task = std::move(worker->tasks.back());
+            worker->tasks.pop_back();
+        }
+        taskLock.unlock();
+        std::unique_lock<std::mutex> idleLock(idleMutex);
+        pendingTasks--;
+        return true;
+    }
+    return false;
+}
+
+
+// Creates a worker without starting its thread.
+ThreadResource::Pool::Worker::Worker(Pool& pool, const int workerIndex) :
+juce::Thread(workerName + juce::String(workerIndex)),
+pool(pool),
+workerIndex(workerIndex) { }
+
+
+// Runs tasks until the thread is told to exit, sleeping whenever no tasks are
+// available.
+void ThreadResource::Pool::Worker::run()
+{
+    currentWorkerIndex = workerIndex;
+    std::function<void()> task;
+    while (!threadShouldExit())
+    {
+        if (pool.takeTask(workerIndex, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> idleLock(pool.idleMutex);
+        pool.idleCondition.wait(idleLock, [this]()
+        {
+            return pool.pendingTasks > 0 || pool.stopping;
+        });
+    }
+}
@@ -0,0 +1,149 @@
+#pragma once
+/**
+ * @file  SharedResource_Thread_Pool.h
+ *
+ * @brief  A process-wide pool of worker threads shared by thread resources.
+ */
+
+#include "JuceHeader.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace SharedResource { namespace Thread { class Pool; } }
+
+/**
+ * @brief  Runs tasks submitted by SharedResource::Thread objects on a small,
+ *         shared set of worker threads.
+ *
+ *  The pool creates one worker thread for each CPU core. Each worker has its
+ * own task queue. Tasks added from a worker thread are added to that worker's
+ * queue, and tasks added from other threads are distributed between worker
+ * queues in turn. Workers run tasks from their own queue first, then take
+ * tasks from the back of other workers' queues when their own queue is empty.
+ * Workers with no tasks to run or take sleep until a new task is added.
+ *
+ *  Only one Pool exists at a time. Thread objects hold a shared pointer to the
+ * pool while they use it, and the pool is destroyed once no Thread objects
+ * hold a pointer to it.
+ */
+class SharedResource::Thread::Pool
+{
+public:
+    /**
+     * @brief  Stops all worker threads, discarding any tasks that haven't
+     *         started running.
+     */
+    virtual ~Pool();
+
+    /**
+     * @brief  Gets the shared thread pool, creating it if it doesn't already
+     *         exist.
+     *
+     * @return  A pointer that keeps the pool alive for as long as it exists.
+     */
+    static std::shared_ptr<Pool> getSharedPool();
+
+    /**
+     * @brief  Schedules a task to run on one of the pool's worker threads.
+     *
+     * @param task  A function to run once on a worker thread.
+     */
+    void addTask(const std::function<void()> task);
+
+    /**
+     * @brief  Runs one task waiting in the pool on the calling thread, if the
+     *         calling thread is one of the pool's worker threads.
+     *
+     *  Pool tasks that need to wait for other pool tasks should call this
+     * while waiting, so that tasks they depend on still run even if every
+     * other worker thread is busy.
+     *
+     * @return  Whether a task was run. This always returns false when called
+     *          from a thread outside of the pool.
+     */
+    bool runPendingTask();
+
+    /**
+     * @brief  Gets the number of worker threads in the pool.
+     *
+     * @return  The worker thread count.
+     */
+    int getNumWorkers() const;
+
+private:
+    /**
+     * @brief  Creates a thread pool and starts all of its worker threads.
+     *
+     * @param numWorkers  The number of worker threads to create.
+     */
+    Pool(const int numWorkers);
+
+    /**
+     * @brief  A single pool thread, and the queue of tasks it runs.
+     */
+    class Worker : public juce::Thread
+    {
+    public:
+        /**
+         * @brief  Creates a worker without starting its thread.
+         *
+         * @param pool         The pool that owns this worker.
+         *
+         * @param workerIndex  The worker's index in the pool's worker list.
+         */
+        Worker(Pool& pool, const int workerIndex);
+
+        virtual ~Worker() { }
+
+        // Tasks waiting to run on this worker:
+        std::deque<std::function<void()>> tasks;
+
+        // Guards access to the task queue:
+        std::mutex taskMutex;
+
+    private:
+        /**
+         * @brief  Runs tasks until the thread is told to exit, sleeping
+         *         whenever no tasks are available.
+         */
+        virtual void run() override;
+
+        Pool& pool;
+        const int workerIndex;
+    };
+
+    /**
+     * @brief  Takes the next task a worker should run, checking the worker's
+     *         own queue before taking tasks from other workers.
+     *
+     * @param workerIndex  The index of the worker that needs a task.
+     *
+     * @param task         Set to the next task to run, if one is found.
+     *
+     * @return             Whether a task was found.
+     */
+    bool takeTask(const int workerIndex, std::function<void()>& task);
+
+    // All worker threads:
+    juce::OwnedArray<Worker> workers;
+
+    // Guards the pending task count, and is used to wake sleeping workers:
+    std::mutex idleMutex;
+    std::condition_variable idleCondition;
+
+    // Number of tasks added that haven't been taken by a worker:
+    int pendingTasks = 0;
+
+    // Whether the pool is shutting down:
+    bool stopping = false;
+
+    // Index of the next worker queue that will receive tasks added from
+    // outside the pool:
+    std::atomic<unsigned int> nextWorker { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(Pool);
+};
@@ -1,9 +1,19 @@
 #include "SharedResource_Thread_Resource.h"
 
+// Whether thread resources run within the shared Thread::Pool instead of on
+// dedicated threads:
+#ifdef SHARED_RESOURCE_THREAD_POOL
+static const constexpr bool useThreadPool = true;
+#else
+static const constexpr bool useThreadPool = false;
+#endif
+
 // Creates a new Thread::Resource.
 SharedResource::Thread::Resource::Resource
-(const juce::Identifier& resourceKey, const juce::String& threadName) :
-SharedResource::Resource(resourceKey), Thread(threadName) { }
+(const juce::Identifier& resourceKey, const juce::String& threadName,
+        const bool allowPool) :
+SharedResource::Resource(resourceKey),
+Thread(threadName, useThreadPool && allowPool) { }
 
 
 // Gets the Thread::Resource's resource key.
@@ -23,6 +23,10 @@ namespace SharedResource { namespace Thread { class Lock; } }
  * thread still runs. While running within their own thread, ThreadResource
  * objects are able to access their own resource locks to prevent handlers from
  * modifying their data.
+ *
+ *  When built with SHARED_RESOURCE_THREAD_POOL defined, ThreadResource
+ * objects run within the shared Thread::Pool instead of creating their own
+ * threads, unless they are created with pool mode disabled.
  */
 class SharedResource::Thread::Resource : public SharedResource::Resource,
         public Thread
@@ -34,9 +38,14 @@ public:
      * @param resourceKey  The thread's unique SharedResource object key.
      *
      * @param threadName   The name used to identify the thread to the system.
+     *
+     * @param allowPool    Whether the thread may run within the shared
+     *                     Thread::Pool when pool mode is enabled. Resources
+     *                     that block indefinitely within runLoop should pass
+     *                     false to keep a dedicated thread.
      */
     Resource(const juce::Identifier& resourceKey,
-            const juce::String& threadName);
+            const juce::String& threadName, const bool allowPool = true);
 
     virtual ~Resource() { }
 
@@ -3,4 +3,14 @@
 
 // Locks a resource lock for reading for as long as this object exists.
 SharedResource::Thread::ScopedReadLock::ScopedReadLock(Lock& threadLock) :
-        juceLock(threadLock.getResourceLock()) { }
+threadLock(threadLock)
+{
+    threadLock.enterRead();
+}
+
+
+// Unlocks the resource lock.
+SharedResource::Thread::ScopedReadLock::~ScopedReadLock()
+{
+    threadLock.exitRead();
+}
@@ -20,6 +20,9 @@ namespace SharedResource
 /**
  * @brief  A juce::ScopedReadLock created from a Thread::Lock instead of a
  *         juce::ReadWriteLock.
+ *
+ *  ScopedReadLock locks through the Thread::Lock so that lock statistics are
+ * recorded when SHARED_RESOURCE_LOCK_STATS is defined.
  */
 class SharedResource::Thread::ScopedReadLock
 {
@@ -32,9 +35,12 @@ public:
      */
     ScopedReadLock(Lock& threadLock);
 
-    virtual ~ScopedReadLock() { }
+    /**
+     * @brief  Unlocks the resource lock.
+     */
+    virtual ~ScopedReadLock();
 
 private:
-    // Private lock object that provides all lock functionality:
-    juce::ScopedReadLock juceLock;
+    // The resource lock object held locked:
+    const Lock& threadLock;
 };
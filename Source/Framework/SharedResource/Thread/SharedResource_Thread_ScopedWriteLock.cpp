@@ -3,4 +3,14 @@
 
 // Locks a resource lock for writing for as long as this object exists.
 SharedResource::Thread::ScopedWriteLock::ScopedWriteLock(Lock& threadLock) :
-        juceLock(threadLock.getResourceLock()) { }
+threadLock(threadLock)
+{
+    threadLock.enterWrite();
+}
+
+
+// Unlocks the resource lock.
+SharedResource::Thread::ScopedWriteLock::~ScopedWriteLock()
+{
+    threadLock.exitWrite();
+}
@@ -20,6 +20,9 @@ namespace SharedResource
 /**
  * @brief  A juce::ScopedWriteLock created from a Thread::Lock instead of a
  *         juce::ReadWriteLock.
+ *
+ *  ScopedWriteLock locks through the Thread::Lock so that lock statistics are
+ * recorded when SHARED_RESOURCE_LOCK_STATS is defined.
  */
 class SharedResource::Thread::ScopedWriteLock
 {
@@ -32,9 +35,12 @@ public:
      */
     ScopedWriteLock(Lock& threadLock);
 
-    virtual ~ScopedWriteLock() { }
+    /**
+     * @brief  Unlocks the resource lock.
+     */
+    virtual ~ScopedWriteLock();
 
 private:
-    // Private lock object that provides all lock functionality:
-    juce::ScopedWriteLock juceLock;
+    // The resource lock object held locked:
+    const Lock& threadLock;
 };
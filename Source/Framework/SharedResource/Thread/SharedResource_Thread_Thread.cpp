@@ -3,6 +3,10 @@
 // Number of milliseconds to wait before forcibly terminating the thread:
 static const constexpr int timeoutMilliseconds = 5000;
 
+// Maximum number of runLoop calls made each time a pool mode Thread's task
+// runs:
+static const constexpr int poolBatchSize = 8;
+
 #ifdef JUCE_DEBUG
 // Print the full class name before all debug output:
 static const constexpr char* dbgPrefix = "SharedResource::Thread::Thread::";
@@ -11,8 +15,9 @@ static const constexpr char* dbgPrefix = "SharedResource::Thread::Thread::";
 namespace ThreadResource = SharedResource::Thread;
 
 // Creates the Thread object without starting the thread.
-ThreadResource::Thread::Thread(const juce::String name) :
-        juce::Thread(name) { }
+ThreadResource::Thread::Thread(const juce::String name, const bool usePool) :
+        juce::Thread(name),
+        pool(usePool ? Pool::getSharedPool() : nullptr) { }
 
 
 // Checks that the thread has successfully stopped before destruction.
@@ -45,6 +50,15 @@ void ThreadResource::Thread::startResourceThread()
         }
         // Create the thread lock before starting the thread:
         threadLock.reset(new Lock(getThreadResourceKey()));
+        if (pool != nullptr)
+        {
+            std::unique_lock<std::mutex> poolLock(poolMutex);
+            poolShouldExit = false;
+            poolNotified = false;
+            needsInit = true;
+            schedulePoolBatch();
+            return;
+        }
         startThread();
         startCondition.wait(startLock);
     }
@@ -78,6 +92,71 @@ void ThreadResource::Thread::stopThreadAndWait()
 }
 
 
+// Checks if the resource's thread is currently running.
+bool ThreadResource::Thread::isThreadRunning() const
+{
+    if (pool == nullptr)
+    {
+        return juce::Thread::isThreadRunning();
+    }
+    std::unique_lock<std::mutex> poolLock(poolMutex);
+    return poolState != PoolState::stopped;
+}
+
+
+// Wakes the thread if it is waiting for a notification.
+void ThreadResource::Thread::notify()
+{
+    if (pool == nullptr)
+    {
+        juce::Thread::notify();
+        return;
+    }
+    std::unique_lock<std::mutex> poolLock(poolMutex);
+    poolNotified = true;
+    if (poolState == PoolState::waiting)
+    {
+        schedulePoolBatch();
+    }
+}
+
+
+// Tells the thread that it should stop running as soon as possible.
+void ThreadResource::Thread::signalThreadShouldExit()
+{
+    if (pool == nullptr)
+    {
+        juce::Thread::signalThreadShouldExit();
+    }
+    else
+    {
+        poolShouldExit = true;
+    }
+}
+
+
+// Checks if the thread was told to stop running.
+bool ThreadResource::Thread::threadShouldExit() const
+{
+    if (pool == nullptr)
+    {
+        return juce::Thread::threadShouldExit();
+    }
+    return poolShouldExit;
+}
+
+
+// Gets the ID of the system thread running this Thread.
+juce::Thread::ThreadID ThreadResource::Thread::getThreadId() const
+{
+    if (pool == nullptr)
+    {
+        return juce::Thread::getThreadId();
+    }
+    return poolThreadId;
+}
+
+
 // Initializes the thread, runs the action loop, then runs cleanup routines
 // before the thread exits.
 void ThreadResource::Thread::run()
@@ -135,44 +214,138 @@ void ThreadResource::Thread::run()
 
     // Delete the lock outside of the thread, just in case deleting the lock
     // also deletes the thread.
-    std::function<void()> lockDelete = [this]()
+    // In most circumstances, the juce::MessageManager thread is used to handle
+    // asynchronous function calls. In this case, it shouldn't be used, as it
+    // might be stopping or waiting for the lock to be deleted.
+    juce::Thread::launch([this]() { deleteThreadLock(); });
+}
+
+
+// Runs one batch of the init, runLoop, and cleanup cycle within the shared
+// Thread::Pool.
+void ThreadResource::Thread::runPoolBatch()
+{
+    jassert(threadLock != nullptr);
+    bool shouldInit;
+    {
+        std::unique_lock<std::mutex> poolLock(poolMutex);
+        poolState = PoolState::running;
+        shouldInit = needsInit;
+        needsInit = false;
+    }
+    poolThreadId = juce::Thread::getCurrentThreadId();
+    if (shouldInit)
+    {
+        DBG(dbgPrefix << __func__ << ": Initializing pool thread \""
+                << getThreadName() << "\".");
+        init(*threadLock);
+    }
+
+    for (int i = 0; i < poolBatchSize && !threadShouldExit(); i++)
     {
-        // Make sure the thread has finished running before doing anything
-        // else:
-        if (threadShouldExit())
         {
-            DBG(dbgPrefix << __func__ << ": Thread \"" << getThreadName()
-                    << "\" hasn't finished stopping yet, wait for it.");
-            notify();
-            waitForThreadToExit(-1);
+            std::unique_lock<std::mutex> poolLock(poolMutex);
+            poolNotified = false;
         }
+        runLoop(*threadLock);
 
-        // Transfer the threadLock to a local unique_ptr while the stopLock is
-        // held, just in case the another thread is trying to replace it:
-        std::unique_ptr<Lock> tempLockHolder(nullptr);
+        // If the threadLock is the thread's only reference, start shutting it
+        // down:
+        if (getThreadReferenceCount() == 1)
         {
-            std::unique_lock<std::mutex> stopLock(stopMutex);
-            tempLockHolder.swap(threadLock);
-
-            // Before deleting the ThreadLock, threads waiting on the
-            // stopCondition must be notified, and this function must release
-            // its lock on the Thread object's stopMutex. Otherwise, the thread
-            // will freeze if deleting the ThreadLock causes the Thread object
-            // to be deleted.
-            stopCondition.notify_all();
+            signalThreadShouldExit();
         }
 
-        DBG(dbgPrefix << __func__ << ": Asynchronously deleting ThreadLock on"
-                << " stopped thread \"" << getThreadName() << "\"");
+        if (threadShouldWait() && !threadShouldExit())
+        {
+            DBG(dbgPrefix << __func__ << ": Pool thread \"" << getThreadName()
+                    << "\" running cleanup before waiting.");
+            cleanup(*threadLock);
+            poolThreadId = nullptr;
+            // Unlike a dedicated thread, the pool thread can't miss
+            // notifications sent while it was running, so it continues
+            // immediately if it was notified after it last ran the loop:
+            std::unique_lock<std::mutex> poolLock(poolMutex);
+            needsInit = true;
+            if (poolNotified || threadShouldExit())
+            {
+                schedulePoolBatch();
+            }
+            else
+            {
+                poolState = PoolState::waiting;
+            }
+            return;
+        }
+    }
 
-        // The threadLock will now be deleted automatically when tempLockHolder
-        // goes out of scope and is destroyed.
-    };
+    if (!threadShouldExit())
+    {
+        // Let other pool tasks run before continuing:
+        poolThreadId = nullptr;
+        std::unique_lock<std::mutex> poolLock(poolMutex);
+        schedulePoolBatch();
+        return;
+    }
 
-    // In most circumstances, the juce::MessageManager thread is used to handle
-    // asynchronous function calls. In this case, it shouldn't be used, as it
-    // might be stopping or waiting for the lock to be deleted.
-    juce::Thread::launch(lockDelete);
+    DBG(dbgPrefix << __func__ << ": Running cleanup for pool thread \""
+            << getThreadName() << "\".");
+    cleanup(*threadLock);
+    poolThreadId = nullptr;
+    {
+        std::unique_lock<std::mutex> poolLock(poolMutex);
+        poolState = PoolState::stopped;
+    }
+
+    // The Lock can't be deleted within the pool, as the pool may be destroyed
+    // along with the Thread object. Nothing may access the Thread object after
+    // this point.
+    juce::Thread::launch([this]() { deleteThreadLock(); });
+}
+
+
+// Adds a new batch task to the shared Thread::Pool.
+void ThreadResource::Thread::schedulePoolBatch()
+{
+    poolState = PoolState::scheduled;
+    pool->addTask([this]() { runPoolBatch(); });
+}
+
+
+// Releases the thread's Lock after the thread finishes running, notifying any
+// threads waiting for the thread to stop.
+void ThreadResource::Thread::deleteThreadLock()
+{
+    // Make sure a dedicated thread has finished running before doing anything
+    // else:
+    if (pool == nullptr && threadShouldExit())
+    {
+        DBG(dbgPrefix << __func__ << ": Thread \"" << getThreadName()
+                << "\" hasn't finished stopping yet, wait for it.");
+        notify();
+        waitForThreadToExit(-1);
+    }
+
+    // Transfer the threadLock to a local unique_ptr while the stopLock is
+    // held, just in case the another thread is trying to replace it:
+    std::unique_ptr<Lock> tempLockHolder(nullptr);
+    {
+        std::unique_lock<std::mutex> stopLock(stopMutex);
+        tempLockHolder.swap(threadLock);
+
+        // Before deleting the ThreadLock, threads waiting on the
+        // stopCondition must be notified, and this function must release
+        // its lock on the Thread object's stopMutex. Otherwise, the thread
+        // will freeze if deleting the ThreadLock causes the Thread object
+        // to be deleted.
+        stopCondition.notify_all();
+    }
+
+    DBG(dbgPrefix << __func__ << ": Asynchronously deleting ThreadLock on"
+            << " stopped thread \"" << getThreadName() << "\"");
+
+    // The threadLock will now be deleted automatically when tempLockHolder
+    // goes out of scope and is destroyed.
 }
 
 
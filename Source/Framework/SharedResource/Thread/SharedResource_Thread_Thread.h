@@ -7,8 +7,11 @@
  */
 
 #include "SharedResource_Thread_Lock.h"
+#include "SharedResource_Thread_Pool.h"
 #include "Util_ShutdownListener.h"
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 
 namespace SharedResource { namespace Thread { class Thread; } }
@@ -21,6 +24,19 @@ namespace SharedResource { namespace Thread { class Thread; } }
  * Thread::Module objects. Thread objects selectively lock themselves to
  * prevent concurrent data access, and stop themselves when the application
  * starts to shut down.
+ *
+ *  Thread objects may either run on their own dedicated juce::Thread, or run
+ * as tasks within the shared Thread::Pool. Both modes run the same init,
+ * runLoop, and cleanup cycle. In pool mode, the Thread runs a batch of several
+ * runLoop calls each time its task runs, then adds a new task to continue, so
+ * that other Thread objects using the pool may run between batches. While
+ * the Thread waits for a notification, it doesn't hold any pool thread, and
+ * notifying it just adds a new task to the pool.
+ *
+ *  Pool mode should only be used by Thread objects with runLoop functions
+ * that don't block indefinitely. Threads that need to wait for their own
+ * background jobs should run those jobs with a Thread::JobPool, which keeps
+ * waiting pool threads busy with other pool tasks.
  */
 class SharedResource::Thread::Thread : public Util::ShutdownListener,
         private juce::Thread
@@ -29,9 +45,12 @@ public:
     /**
      * @brief  Creates the Thread object without starting the thread.
      *
-     * @param name  The name used to identify the thread.
+     * @param name     The name used to identify the thread.
+     *
+     * @param usePool  Whether the Thread should run within the shared
+     *                 Thread::Pool instead of on its own thread.
      */
-    Thread(const juce::String name);
+    Thread(const juce::String name, const bool usePool = false);
 
     /**
      * @brief  Checks that the thread has successfully stopped before
@@ -55,17 +74,43 @@ public:
      */
     void stopThreadAndWait();
 
-    // Checks if the resource's thread is currently running.
-    using juce::Thread::isThreadRunning;
+    /**
+     * @brief  Checks if the resource's thread is currently running.
+     *
+     * @return  Whether the thread is running or waiting for a notification.
+     *          In pool mode, this is true from the moment the thread is
+     *          started until its final cleanup finishes.
+     */
+    bool isThreadRunning() const;
 
-    // Allow handlers to notify the thread normally to wake it when waiting.
-    using juce::Thread::notify;
+    /**
+     * @brief  Wakes the thread if it is waiting for a notification.
+     *
+     *  Handlers may use this to notify the thread normally.
+     */
+    void notify();
 
 protected:
-    // Allow thread subclasses limited access to the juce::Thread interface:
-    using juce::Thread::signalThreadShouldExit;
-    using juce::Thread::threadShouldExit;
-    using juce::Thread::getThreadId;
+    /**
+     * @brief  Tells the thread that it should stop running as soon as
+     *         possible.
+     */
+    void signalThreadShouldExit();
+
+    /**
+     * @brief  Checks if the thread was told to stop running.
+     *
+     * @return  Whether the thread should exit.
+     */
+    bool threadShouldExit() const;
+
+    /**
+     * @brief  Gets the ID of the system thread running this Thread.
+     *
+     * @return  The thread ID. In pool mode, this is only set while the
+     *          Thread's task is running on a pool thread.
+     */
+    juce::Thread::ThreadID getThreadId() const;
 
     /**
      * @brief  Gets the Thread::Resource's resource key.
@@ -133,6 +178,32 @@ private:
      */
     virtual void onShutdown() override;
 
+    /**
+     * @brief  Runs one batch of the init, runLoop, and cleanup cycle within
+     *         the shared Thread::Pool.
+     *
+     *  The batch stops after a fixed number of runLoop calls, when the thread
+     * should wait, or when the thread should exit. If the thread should keep
+     * running, a new batch task is added to the pool.
+     */
+    void runPoolBatch();
+
+    /**
+     * @brief  Adds a new batch task to the shared Thread::Pool.
+     *
+     *  This should only be called while the poolMutex is held.
+     */
+    void schedulePoolBatch();
+
+    /**
+     * @brief  Releases the thread's Lock after the thread finishes running,
+     *         notifying any threads waiting for the thread to stop.
+     *
+     *  This is launched on a new thread, as deleting the Lock may also delete
+     * the Thread object.
+     */
+    void deleteThreadLock();
+
     // Stores the thread's name:
     const juce::String threadName;
 
@@ -146,4 +217,43 @@ private:
 
     // Preserves the thread object and controls access while the thread runs:
     std::unique_ptr<Lock> threadLock = nullptr;
+
+    // Pool mode data:
+
+    // The shared pool used to run this Thread, or nullptr if the Thread uses
+    // a dedicated thread:
+    const std::shared_ptr<Pool> pool;
+
+    /**
+     * @brief  Describes the state of a Thread running in pool mode.
+     */
+    enum class PoolState
+    {
+        // The thread isn't running:
+        stopped,
+        // A batch task is waiting to run within the pool:
+        scheduled,
+        // A batch task is currently running:
+        running,
+        // The thread is waiting for a notification:
+        waiting
+    };
+
+    // Guards the pool mode state:
+    mutable std::mutex poolMutex;
+
+    // The current pool mode state:
+    PoolState poolState = PoolState::stopped;
+
+    // Whether init needs to run before the next runLoop call:
+    bool needsInit = false;
+
+    // Whether the thread was notified since it last checked if it should wait:
+    bool poolNotified = false;
+
+    // Whether the pool mode thread was told to exit:
+    std::atomic<bool> poolShouldExit { false };
+
+    // The ID of the pool thread currently running a batch task:
+    std::atomic<juce::Thread::ThreadID> poolThreadId { nullptr };
 };
@@ -0,0 +1,175 @@
+#include "Util_FileWatcher.h"
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Util::FileWatcher::";
+#endif
+
+// All events that indicate a file within a watched directory changed:
+static const constexpr juce::uint32 watchedEvents = IN_CREATE | IN_DELETE
+        | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF
+        | IN_MOVE_SELF;
+
+// Size of the buffer used to read inotify events:
+static const constexpr int eventBufferSize = 4096;
+
+// Creates a FileWatcher that isn't watching any directories.
+Util::FileWatcher::FileWatcher()
+{
+    inotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFD < 0)
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to initialize inotify, error "
+                << errno);
+    }
+    wakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFD < 0)
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to create wake event, error "
+                << errno);
+    }
+}
+
+
+// Removes all watched directories and closes the inotify instance.
+Util::FileWatcher::~FileWatcher()
+{
+    if (isValid())
+    {
+        removeAllDirectories();
+        close(inotifyFD);
+        inotifyFD = -1;
+    }
+    if (wakeFD >= 0)
+    {
+        close(wakeFD);
+        wakeFD = -1;
+    }
+}
+
+
+// Checks if the FileWatcher is able to watch files.
+bool Util::FileWatcher::isValid() const
+{
+    return inotifyFD >= 0;
+}
+
+
+// Starts watching a directory for changes.
+bool Util::FileWatcher::addDirectory(const juce::String& dirPath)
+{
+    if (!isValid())
+    {
+        return false;
+    }
+    const int watchDescriptor = inotify_add_watch(inotifyFD,
+            dirPath.toRawUTF8(), watchedEvents | IN_ONLYDIR);
+    if (watchDescriptor < 0)
+    {
+        return false;
+    }
+    watchedDirs[watchDescriptor] = dirPath;
+    return true;
+}
+
+
+// Stops watching all watched directories.
+void Util::FileWatcher::removeAllDirectories()
+{
+    for (const auto& watchedDir : watchedDirs)
+    {
+        inotify_rm_watch(inotifyFD, watchedDir.first);
+    }
+    watchedDirs.clear();
+}
+
+
+// Gets all changes within watched directories since the last time changes were
+// read.
+bool Util::FileWatcher::readChanges(juce::StringArray& changedPaths)
+{
+    if (!isValid())
+    {
+        return true;
+    }
+    bool noEventsLost = true;
+    alignas(struct inotify_event) char eventBuffer[eventBufferSize];
+    ssize_t bytesRead;
+    while ((bytesRead = read(inotifyFD, eventBuffer, eventBufferSize)) > 0)
+    {
+        for (ssize_t offset = 0; offset < bytesRead;)
+        {
+            const struct inotify_event* event
+                    = reinterpret_cast<const struct inotify_event*>
+                    (eventBuffer + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+            if ((event->mask & IN_Q_OVERFLOW) != 0)
+            {
+                DBG(dbgPrefix << __func__
+                        << ": Event queue overflowed, changes were lost.");
+                noEventsLost = false;
+                continue;
+            }
+            auto dirIter = watchedDirs.find(event->wd);
+            if (dirIter == watchedDirs.end())
+            {
+                continue;
+            }
+            if ((event->mask & IN_IGNORED) != 0)
+            {
+                // The directory was removed or is no longer watched:
+                watchedDirs.erase(dirIter);
+                continue;
+            }
+            if (event->len > 0 && event->name[0] != '\0')
+            {
+                changedPaths.addIfNotAlreadyThere(dirIter->second + "/"
+                        + juce::String::fromUTF8(event->name));
+            }
+            else
+            {
+                changedPaths.addIfNotAlreadyThere(dirIter->second);
+            }
+        }
+    }
+    return noEventsLost;
+}
+
+
+// Blocks until files change within a watched directory, or until wake is
+// called.
+void Util::FileWatcher::waitForChanges()
+{
+    struct pollfd pollFDs[2] =
+    {
+        { inotifyFD, POLLIN, 0 },
+        { wakeFD, POLLIN, 0 }
+    };
+    if (!isValid() || wakeFD < 0)
+    {
+        // Without both descriptors, waiting could block forever:
+        jassertfalse;
+        return;
+    }
+    while (poll(pollFDs, 2, -1) < 0 && errno == EINTR) { }
+    if ((pollFDs[1].revents & POLLIN) != 0)
+    {
+        eventfd_t wakeCount;
+        eventfd_read(wakeFD, &wakeCount);
+    }
+}
+
+
+// Makes a thread blocked within waitForChanges return immediately.
+void Util::FileWatcher::wake()
+{
+    if (wakeFD >= 0)
+    {
+        eventfd_write(wakeFD, 1);
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+/**
+ * @file  Util_FileWatcher.h
+ *
+ * @brief  Tracks changes to files within a set of watched directories.
+ */
+
+#include "JuceHeader.h"
+#include <map>
+
+namespace Util { class FileWatcher; }
+
+/**
+ * @brief  Uses inotify to detect when files are created, removed, replaced, or
+ *         modified within watched directories.
+ *
+ *  FileWatcher objects never send notifications. Instead, the owner of a
+ * FileWatcher calls readChanges to get the paths of all files that changed
+ * since the last time changes were read. A thread that has nothing else to do
+ * may call waitForChanges to sleep until files change, instead of polling.
+ * Directories are not watched recursively, so each subdirectory that should be
+ * watched must be added separately.
+ *
+ *  FileWatcher objects are not thread-safe, and should only be accessed from
+ * one thread at a time, except for the waitForChanges and wake functions.
+ * These only use the FileWatcher's file descriptors, so one thread may wait
+ * for changes while other threads use the FileWatcher.
+ */
+class Util::FileWatcher
+{
+public:
+    /**
+     * @brief  Creates a FileWatcher that isn't watching any directories.
+     */
+    FileWatcher();
+
+    /**
+     * @brief  Removes all watched directories and closes the inotify instance.
+     */
+    virtual ~FileWatcher();
+
+    /**
+     * @brief  Checks if the FileWatcher is able to watch files.
+     *
+     * @return  Whether the inotify instance was successfully created.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief  Starts watching a directory for changes.
+     *
+     * @param dirPath  The full path of a directory to watch. Adding a directory
+     *                 that is already watched has no effect.
+     *
+     * @return         Whether the directory is now being watched.
+     */
+    bool addDirectory(const juce::String& dirPath);
+
+    /**
+     * @brief  Stops watching all watched directories.
+     */
+    void removeAllDirectories();
+
+    /**
+     * @brief  Gets all changes within watched directories since the last time
+     *         changes were read.
+     *
+     * @param changedPaths  An array where the full path of each changed file
+     *                      will be added. If a watched directory was removed or
+     *                      moved, its own path will be added.
+     *
+     * @return              False if too many changes occurred and some changes
+     *                      were lost, meaning that any file within a watched
+     *                      directory may have changed, true otherwise.
+     */
+    bool readChanges(juce::StringArray& changedPaths);
+
+    /**
+     * @brief  Blocks until files change within a watched directory, or until
+     *         wake is called.
+     *
+     *  This doesn't read any changes, so readChanges should be called after
+     * this returns. Only one thread should wait for changes at a time.
+     */
+    void waitForChanges();
+
+    /**
+     * @brief  Makes a thread blocked within waitForChanges return immediately.
+     *         If no thread is waiting, the next call to waitForChanges will
+     *         return immediately instead.
+     *
+     *  This may be safely called from any thread.
+     */
+    void wake();
+
+private:
+    // The inotify file descriptor, or -1 if inotify initialization failed:
+    int inotifyFD = -1;
+
+    // The eventfd file descriptor used to wake waiting threads:
+    int wakeFD = -1;
+
+    // Watched directory paths, mapped by inotify watch descriptor:
+    std::map<int, juce::String> watchedDirs;
+
+    JUCE_DECLARE_NON_COPYABLE(FileWatcher);
+};
@@ -1,6 +1,7 @@
 #define APPMENU_IMPLEMENTATION
 #include "AppMenu_FolderComponent.h"
 #include "DesktopEntry_Loader.h"
+#include <limits>
 
 #ifdef JUCE_DEBUG
 // Print full class name before debug output:
@@ -101,6 +102,22 @@ AppMenu::FolderComponent::getButtonComponent(const int index) const
 }
 
 
+// Gets the range of menu indices with menu buttons that are either visible, or
+// likely to become visible after the next navigation action.
+juce::Range<int> AppMenu::FolderComponent::getNearbyIndexRange() const
+{
+    return juce::Range<int>(0, getFolderSize());
+}
+
+
+// Gets the maximum number of menu items initially visible when a folder is
+// opened using this folder's menu format.
+int AppMenu::FolderComponent::getInitialItemCount() const
+{
+    return std::numeric_limits<int>::max();
+}
+
+
 // Creates and inserts a new ItemButton when a new child menu button is created.
 void AppMenu::FolderComponent::childAdded(const int childIndex)
 {
@@ -117,6 +117,29 @@ public:
      */
     MenuButton* getButtonComponent(const int index) const;
 
+    /**
+     * @brief  Gets the range of menu indices with menu buttons that are either
+     *         visible, or likely to become visible after the next navigation
+     *         action.
+     *
+     *  Unless overridden, all menu buttons in the folder are considered to be
+     * visible.
+     *
+     * @return  The range of nearby folder indices.
+     */
+    virtual juce::Range<int> getNearbyIndexRange() const;
+
+    /**
+     * @brief  Gets the maximum number of menu items initially visible when a
+     *         folder is opened using this folder's menu format.
+     *
+     *  Unless overridden, all menu items are assumed to be visible when a
+     * folder is opened.
+     *
+     * @return  The number of menu items visible in a newly opened folder.
+     */
+    virtual int getInitialItemCount() const;
+
 private:
     /**
      * @brief  Creates a button component for one of the folder's child menu
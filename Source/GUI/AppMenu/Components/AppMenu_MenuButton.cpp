@@ -63,6 +63,30 @@ int AppMenu::MenuButton::getTitleWidth() const
 }
 
 
+// Gets the size used when requesting the button's icon.
+int AppMenu::MenuButton::getIconSize() const
+{
+    return std::max(0, iconBounds.toNearestInt().getWidth());
+}
+
+
+// Sets how urgently the button's icon should be loaded, updating the priority of
+// any pending icon request.
+void AppMenu::MenuButton::setIconPriority(const Icon::Priority newPriority)
+{
+    if (newPriority == iconPriority)
+    {
+        return;
+    }
+    iconPriority = newPriority;
+    if (iconCallbackID != 0)
+    {
+        Icon::Loader iconLoader;
+        iconLoader.setRequestPriority(iconCallbackID, iconPriority);
+    }
+}
+
+
 // Updates the component if necessary whenever its menu data changes.
 void AppMenu::MenuButton::dataChanged(MenuItem::DataField changedField)
 {
@@ -131,13 +155,16 @@ void AppMenu::MenuButton::loadIcon()
         Icon::Loader iconLoader;
         iconCallbackID = iconLoader.loadIcon(
                 getMenuItem().getIconName(),
-                iconBounds.toNearestInt().getWidth(),
+                getIconSize(),
                 [this](Image iconImg)
                 {
                     iconCallbackID = 0;
                     icon = iconImg;
                     repaint();
-                });
+                },
+                Icon::Context::unknown,
+                1,
+                iconPriority);
     }
 }
 
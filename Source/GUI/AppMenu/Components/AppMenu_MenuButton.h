@@ -91,6 +91,22 @@ public:
      */
     int getTitleWidth() const;
 
+    /**
+     * @brief  Gets the size used when requesting the button's icon.
+     *
+     * @return  The width of the button's icon bounds in pixels, or zero if the
+     *          button's icon bounds haven't been set.
+     */
+    int getIconSize() const;
+
+    /**
+     * @brief  Sets how urgently the button's icon should be loaded, updating
+     *         the priority of any pending icon request.
+     *
+     * @param newPriority  The priority to use when requesting the icon.
+     */
+    void setIconPriority(const Icon::Priority newPriority);
+
     /**
      * @brief  Updates the component if necessary whenever its menu data
      *         changes.
@@ -252,5 +268,8 @@ private:
     // ID used to cancel pending icon requests if necessary
     Icon::RequestID iconCallbackID = 0;
 
+    // Priority used when requesting the button's icon
+    Icon::Priority iconPriority = Icon::Priority::visible;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MenuButton)
 };
@@ -6,13 +6,18 @@
 #include "AppMenu_MenuFile.h"
 #include "AppMenu_ConfigFile.h"
 #include "Config_MainFile.h"
+#include "Icon_Loader.h"
 #include "Windows_Alert.h"
+#include <algorithm>
 
 #ifdef JUCE_DEBUG
 // Print the full class name before all debug output:
 static const constexpr char* dbgPrefix = "AppMenu::Controller::";
 #endif
 
+// Milliseconds to wait without menu navigation before prefetching icons:
+static const constexpr int prefetchDelayMS = 300;
+
 // Localized object class key:
 static const juce::Identifier localeClassKey = "AppMenu::Controller";
 
@@ -35,11 +40,19 @@ namespace TextKey
 AppMenu::Controller::Controller
 (MenuComponent* menuComponent, Widgets::OverlaySpinner& loadingSpinner) :
 launchTimer(*this),
+prefetchTimer(*this),
 menuComponent(menuComponent),
 loadingSpinner(loadingSpinner),
 Locale::TextUser(localeClassKey) { }
 
 
+// Cancels all pending icon prefetch requests on destruction.
+AppMenu::Controller::~Controller()
+{
+    cancelPrefetchRequests();
+}
+
+
 // Displays a context menu with options for editing an open menu folder.
 void AppMenu::Controller::showContextMenu
 (const MenuItem folderItem, const int insertIndex)
@@ -176,6 +189,16 @@ bool AppMenu::Controller::ignoringInput() const
 }
 
 
+// Schedules icons for the active folder's nearby child folders to be loaded
+// into the icon cache once the menu is idle.
+void AppMenu::Controller::prefetchIcons()
+{
+    // Icons near the previous folder or page are no longer likely to be needed:
+    cancelPrefetchRequests();
+    prefetchTimer.startTimer(prefetchDelayMS);
+}
+
+
 // Performs the appropriate action for a selected context menu option.
 void AppMenu::Controller::handleContextMenuAction(OptionCode selectedOption,
         MenuItem editedItem,
@@ -266,6 +289,70 @@ void AppMenu::Controller::launchOrFocusApplication(MenuItem toLaunch)
 void AppMenu::Controller::openFolder(const MenuItem folderItem)
 {
     menuComponent->openFolder(folderItem);
+    prefetchIcons();
+}
+
+
+// Requests icons for the first items in each child folder within the active
+// folder's nearby menu buttons.
+void AppMenu::Controller::prefetchActiveFolderIcons()
+{
+    const int openFolders = menuComponent->openFolderCount();
+    FolderComponent* activeFolder = menuComponent->getOpenFolder(
+            openFolders - 1);
+    if (activeFolder == nullptr || activeFolder->getFolderSize() == 0)
+    {
+        return;
+    }
+    // Child folders use the same button layout, so their icons will be
+    // requested at the same size as the active folder's icons:
+    const int iconSize = activeFolder->getButtonComponent(0)->getIconSize();
+    if (iconSize <= 0)
+    {
+        return;
+    }
+    // Nearby buttons request their own icons as soon as they are laid out, so
+    // only child folder icons need to be prefetched:
+    const juce::Range<int> nearbyRange = activeFolder->getNearbyIndexRange();
+    const int childLimit = activeFolder->getInitialItemCount();
+    Icon::Loader iconLoader;
+    for (int i = nearbyRange.getStart(); i < nearbyRange.getEnd(); i++)
+    {
+        const MenuButton* button = activeFolder->getButtonComponent(i);
+        if (button == nullptr || !button->getMenuItem().isFolder())
+        {
+            continue;
+        }
+        const MenuItem childFolder = button->getMenuItem();
+        const int childCount = std::min(childLimit,
+                childFolder.getFolderSize());
+        for (int c = 0; c < childCount; c++)
+        {
+            const Icon::RequestID requestID = iconLoader.prefetchIcon(
+                    childFolder.getFolderItem(c).getIconName(), iconSize);
+            if (requestID != 0)
+            {
+                prefetchRequests.add(requestID);
+            }
+        }
+    }
+}
+
+
+// Cancels all icon prefetch requests that are still pending.
+void AppMenu::Controller::cancelPrefetchRequests()
+{
+    if (prefetchRequests.isEmpty())
+    {
+        return;
+    }
+    // Cancelling requests that were already handled has no effect:
+    Icon::Loader iconLoader;
+    for (const Icon::RequestID& requestID : prefetchRequests)
+    {
+        iconLoader.cancelImageRequest(requestID);
+    }
+    prefetchRequests.clear();
 }
 
 
@@ -378,6 +465,19 @@ AppMenu::Controller::LaunchTimer::LaunchTimer(Controller& menuController) :
 menuController(menuController) { }
 
 
+// Connects the timer to its Controller on construction.
+AppMenu::Controller::PrefetchTimer::PrefetchTimer(Controller& menuController) :
+menuController(menuController) { }
+
+
+// Prefetches icons for the active folder.
+void AppMenu::Controller::PrefetchTimer::timerCallback()
+{
+    stopTimer();
+    menuController.prefetchActiveFolderIcons();
+}
+
+
 // Exits the loading state if the timeout period ends before an application
 // launches.
 void AppMenu::Controller::LaunchTimer::timerCallback()
@@ -48,7 +48,10 @@ public:
     Controller(MenuComponent* menuComponent,
             Widgets::OverlaySpinner& loadingSpinner);
 
-    virtual ~Controller() { }
+    /**
+     * @brief  Cancels all pending icon prefetch requests on destruction.
+     */
+    virtual ~Controller();
 
     /**
      * @brief  Displays a context menu with options for editing an open menu
@@ -98,6 +101,19 @@ public:
      */
     bool ignoringInput() const;
 
+    /**
+     * @brief  Schedules icons for the active folder's nearby child folders to
+     *         be loaded into the icon cache once the menu is idle.
+     *
+     *  This should be called whenever the active folder or its visible folder
+     * page changes. Icons for the first items in each child folder are
+     * requested at a low priority, so that opening those folders doesn't
+     * require waiting for their icons to load. Prefetch requests from the
+     * previous folder or page that haven't been handled yet are cancelled
+     * immediately.
+     */
+    void prefetchIcons();
+
 private:
     // Context menu option codes:
     enum class OptionCode
@@ -141,6 +157,17 @@ private:
      */
     void openFolder(const MenuItem folderItem);
 
+    /**
+     * @brief  Requests icons for the first items in each child folder within
+     *         the active folder's nearby menu buttons.
+     */
+    void prefetchActiveFolderIcons();
+
+    /**
+     * @brief  Cancels all icon prefetch requests that are still pending.
+     */
+    void cancelPrefetchRequests();
+
     /**
      * @brief  Creates and shows a new PopupEditor component that can create a
      *         new application shortcut menu item.
@@ -222,6 +249,35 @@ private:
     };
     LaunchTimer launchTimer;
 
+    /**
+     * @brief  Waits for the menu to become idle before prefetching icons.
+     */
+    class PrefetchTimer : public Windows::FocusedTimer
+    {
+    public:
+        /**
+         * @brief  Connects the timer to its Controller on construction.
+         *
+         * @param menuController  The controller object that owns this timer.
+         */
+        PrefetchTimer(Controller& menuController);
+
+        virtual ~PrefetchTimer() { }
+
+    private:
+        /**
+         * @brief  Prefetches icons for the active folder.
+         */
+        void timerCallback() override;
+
+        Controller& menuController;
+    };
+    PrefetchTimer prefetchTimer;
+
+    // IDs of all icon prefetch requests sent since the active folder or page
+    // last changed:
+    juce::Array<Icon::RequestID> prefetchRequests;
+
     // Holds a reference to the loading spinner
     Widgets::OverlaySpinner& loadingSpinner;
 
@@ -22,6 +22,7 @@ AppMenu::InputHandler::InputHandler
     menuComponent->addMouseListener(this, true);
     MenuFile appConfig;
     menuComponent->openFolder(appConfig.getRootFolderItem());
+    controller->prefetchIcons();
 }
 
 
@@ -178,11 +179,10 @@ bool AppMenu::InputHandler::keyPressed(const juce::KeyPress& keyPress,
 }
 
 
-// Scans desktop entries for updates whenever window focus is gained.
+// Schedules a desktop entry scan whenever window focus is gained.
 void AppMenu::InputHandler::windowFocusGained()
 {
-    DesktopEntry::Loader entryLoader;
-    entryLoader.scanForChanges();
+    entryScanNeeded = true;
 }
 
 
@@ -190,5 +190,19 @@ void AppMenu::InputHandler::windowFocusGained()
 // window focus is lost.
 void AppMenu::InputHandler::windowFocusLost()
 {
+    entryScanNeeded = false;
     controller->setLoadingState(false);
 }
+
+
+// Scans desktop entries for updates after a batch of focus updates if window
+// focus was gained.
+void AppMenu::InputHandler::updateBatchFinished()
+{
+    if (entryScanNeeded)
+    {
+        entryScanNeeded = false;
+        DesktopEntry::Loader entryLoader;
+        entryLoader.scanForChanges();
+    }
+}
@@ -164,8 +164,7 @@ private:
             juce::Component* sourceComponent) final override;
 
     /**
-     * @brief  Scans desktop entries for updates whenever window focus is
-     *         gained.
+     * @brief  Schedules a desktop entry scan whenever window focus is gained.
      */
     virtual void windowFocusGained() final override;
 
@@ -175,9 +174,18 @@ private:
      */
     virtual void windowFocusLost() final override;
 
+    /**
+     * @brief  Scans desktop entries for updates after a batch of focus updates
+     *         if window focus was gained.
+     */
+    virtual void updateBatchFinished() final override;
+
     // The menu component that is the source of all key and mouse events.
     MenuComponent* const menuComponent;
 
     // Used by the InputHandler to control the menu's behavior.
     Controller* const controller;
+
+    // Whether desktop entries should be scanned once focus updates finish:
+    bool entryScanNeeded = false;
 };
@@ -1,5 +1,45 @@
 #define APPMENU_IMPLEMENTATION
 #include "AppMenu_ItemData.h"
+#include <locale>
+#include <cwchar>
+
+/**
+ * @brief  Gets the collation rules used to sort menu item titles.
+ *
+ * @return  The system locale's collation rules, or the default C++ locale's
+ *          rules if the system locale isn't supported.
+ */
+static const std::collate<wchar_t>& getTitleCollator()
+{
+    static const std::locale collationLocale = []()->std::locale
+    {
+        try
+        {
+            return std::locale("");
+        }
+        catch(std::runtime_error e)
+        {
+            return std::locale::classic();
+        }
+    }();
+    return std::use_facet<std::collate<wchar_t>>(collationLocale);
+}
+
+
+// Gets a key used to sort menu items by title.
+const std::wstring& AppMenu::ItemData::getSortKey() const
+{
+    if (!sortKeyValid)
+    {
+        const juce::String title = getTitle().toUpperCase();
+        const wchar_t* titleStart = title.toWideCharPointer();
+        const wchar_t* titleEnd = titleStart + wcslen(titleStart);
+        sortKey = getTitleCollator().transform(titleStart, titleEnd);
+        sortKeyValid = true;
+    }
+    return sortKey;
+}
+
 
 // Gets this menu item's parent folder.
 AppMenu::ItemData::Ptr AppMenu::ItemData::getParentFolder() const
@@ -171,6 +211,10 @@ void AppMenu::ItemData::removeListener(Listener* toRemove)
 // Signal to all listeners tracking this ItemData that the item has changed.
 void AppMenu::ItemData::signalDataChanged(const DataField changedField)
 {
+    if (changedField == DataField::title)
+    {
+        sortKeyValid = false;
+    }
     foreachListener([changedField](Listener* listener)
     {
         listener->dataChanged(changedField);
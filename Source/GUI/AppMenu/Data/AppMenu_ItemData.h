@@ -9,6 +9,7 @@
  */
 
 #include "JuceHeader.h"
+#include <string>
 
 namespace AppMenu { class ItemData; }
 
@@ -41,6 +42,18 @@ public:
      */
     virtual juce::String getTitle() const = 0;
 
+    /**
+     * @brief  Gets a key used to sort menu items by title.
+     *
+     *  Sort keys are created from the uppercase title using the system
+     * locale's collation rules, so comparing two keys gives the same result as
+     * a case-insensitive, locale-aware comparison of the titles. Each key is
+     * only created once, and is recreated after the title changes.
+     *
+     * @return  The menu item's sort key.
+     */
+    const std::wstring& getSortKey() const;
+
     /**
      * @brief  Gets the name or path use to load the menu item's icon file.
      *
@@ -400,5 +413,11 @@ private:
     // Objects that should be notified if this menu item changes.
     juce::Array<Listener*> listeners;
 
+    // The cached title sort key, created when first needed:
+    mutable std::wstring sortKey;
+
+    // Whether the sort key was created from the current title:
+    mutable bool sortKeyValid = false;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ItemData)
 };
@@ -22,6 +22,18 @@ juce::String AppMenu::MenuItem::getTitle() const
 }
 
 
+// Gets a key used to sort menu items by title.
+const std::wstring& AppMenu::MenuItem::getSortKey() const
+{
+    if (isNull())
+    {
+        static const std::wstring emptyKey;
+        return emptyKey;
+    }
+    return getData()->getSortKey();
+}
+
+
 // Gets the menu item's icon name.
 juce::String AppMenu::MenuItem::getIconName() const
 {
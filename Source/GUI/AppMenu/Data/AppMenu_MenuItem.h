@@ -61,6 +61,14 @@ public:
      */
     juce::String getTitle() const;
 
+    /**
+     * @brief  Gets a key used to sort menu items by title.
+     *
+     * @return  The menu item's cached, locale-aware title sort key, or an
+     *          empty key if the menu item is null.
+     */
+    const std::wstring& getSortKey() const;
+
     /**
      * @brief  Gets the menu item's icon name.
      *
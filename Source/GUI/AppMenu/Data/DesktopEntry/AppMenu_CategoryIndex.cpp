@@ -0,0 +1,105 @@
+#define APPMENU_IMPLEMENTATION
+#include "AppMenu_CategoryIndex.h"
+
+// Special folder category that matches all desktop entries:
+static const juce::String allCategory = "All";
+
+// Creates a category index for a list of desktop entries.
+AppMenu::CategoryIndex::CategoryIndex
+(const juce::Array<DesktopEntry::EntryFile>& entryList)
+{
+    entries.ensureStorageAllocated(entryList.size());
+    juce::Array<juce::StringArray> entryCategoryLists;
+    entryCategoryLists.ensureStorageAllocated(entryList.size());
+    for (const DesktopEntry::EntryFile& entry : entryList)
+    {
+        if (entry.isMissingData())
+        {
+            continue;
+        }
+        entries.add(entry);
+        entryCategoryLists.add(entry.getCategories());
+        for (const juce::String& category : entryCategoryLists.getReference(
+                    entryCategoryLists.size() - 1))
+        {
+            categoryIDs.emplace(category, (int) categoryIDs.size());
+        }
+    }
+
+    wordsPerEntry = ((int) categoryIDs.size() + bitsPerWord - 1)
+            / bitsPerWord;
+    entryCategories.assign(entries.size() * wordsPerEntry, 0);
+    for (int i = 0; i < entryCategoryLists.size(); i++)
+    {
+        CategoryBits* entryBits = entryCategories.data() + i * wordsPerEntry;
+        for (const juce::String& category : entryCategoryLists.getReference(i))
+        {
+            const int categoryID = categoryIDs.at(category);
+            entryBits[categoryID / bitsPerWord]
+                    |= (CategoryBits) 1 << (categoryID % bitsPerWord);
+        }
+    }
+}
+
+
+// Gets all desktop entries held by the index.
+const juce::Array<DesktopEntry::EntryFile>&
+AppMenu::CategoryIndex::getEntries() const
+{
+    return entries;
+}
+
+
+// Applies a function to each indexed desktop entry that has at least one
+// category in a category list.
+void AppMenu::CategoryIndex::foreachMatchingEntry
+(const juce::StringArray& categories,
+        const std::function<void(const DesktopEntry::EntryFile&)> entryAction)
+const
+{
+    if (categories.isEmpty())
+    {
+        return;
+    }
+    // TODO: hardcoding this in at this level is sloppy, find a better option
+    if (categories.contains(allCategory))
+    {
+        for (const DesktopEntry::EntryFile& entry : entries)
+        {
+            entryAction(entry);
+        }
+        return;
+    }
+
+    // Convert the category list to a mask, ignoring categories that no
+    // indexed entry uses:
+    std::vector<CategoryBits> folderMask(wordsPerEntry, 0);
+    bool maskIsEmpty = true;
+    for (const juce::String& category : categories)
+    {
+        auto idIter = categoryIDs.find(category);
+        if (idIter != categoryIDs.end())
+        {
+            folderMask[idIter->second / bitsPerWord]
+                    |= (CategoryBits) 1 << (idIter->second % bitsPerWord);
+            maskIsEmpty = false;
+        }
+    }
+    if (maskIsEmpty)
+    {
+        return;
+    }
+
+    const CategoryBits* entryBits = entryCategories.data();
+    for (int i = 0; i < entries.size(); i++, entryBits += wordsPerEntry)
+    {
+        for (int word = 0; word < wordsPerEntry; word++)
+        {
+            if ((entryBits[word] & folderMask[word]) != 0)
+            {
+                entryAction(entries.getReference(i));
+                break;
+            }
+        }
+    }
+}
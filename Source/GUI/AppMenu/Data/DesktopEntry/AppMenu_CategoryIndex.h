@@ -0,0 +1,84 @@
+#ifndef APPMENU_IMPLEMENTATION
+    #error File included directly outside of AppMenu implementation.
+#endif
+#pragma once
+/**
+ * @file  AppMenu_CategoryIndex.h
+ *
+ * @brief  Stores a list of desktop entries with their application categories
+ *         converted to bit sets, so that entries can be quickly matched with
+ *         menu folder categories.
+ */
+
+#include "DesktopEntry_EntryFile.h"
+#include "JuceHeader.h"
+#include <map>
+#include <vector>
+
+namespace AppMenu { class CategoryIndex; }
+
+/**
+ * @brief  Holds a table of desktop entries, and the set of application
+ *         categories used by each entry.
+ *
+ *  Every distinct category string found in the entry list is assigned a small
+ * integer ID when the CategoryIndex is created. Each entry's categories are
+ * then stored as a bit set in a single contiguous table, using one bit for
+ * each category ID. Menu folder category lists are converted to a bit mask
+ * using the same IDs, so that all entries in a folder can be found by checking
+ * each entry's category bits against the folder mask, without comparing any
+ * category strings.
+ *
+ *  Entries missing required desktop entry data are never added to the index.
+ */
+class AppMenu::CategoryIndex
+{
+public:
+    /**
+     * @brief  Creates a category index for a list of desktop entries.
+     *
+     * @param entryList  The desktop entries to index.
+     */
+    CategoryIndex(const juce::Array<DesktopEntry::EntryFile>& entryList);
+
+    virtual ~CategoryIndex() { }
+
+    /**
+     * @brief  Gets all desktop entries held by the index.
+     *
+     * @return  All indexed entries, in their original order.
+     */
+    const juce::Array<DesktopEntry::EntryFile>& getEntries() const;
+
+    /**
+     * @brief  Applies a function to each indexed desktop entry that has at
+     *         least one category in a category list.
+     *
+     * @param categories   A menu folder's category list. If this list contains
+     *                     the "All" category, every indexed entry will match.
+     *
+     * @param entryAction  A function to call for each matching entry.
+     */
+    void foreachMatchingEntry(const juce::StringArray& categories,
+            const std::function<void(const DesktopEntry::EntryFile&)>
+                entryAction) const;
+
+private:
+    // Stores one word of each entry's category bit set:
+    typedef juce::uint64 CategoryBits;
+
+    // Number of categories stored in each CategoryBits value:
+    static const constexpr int bitsPerWord = 64;
+
+    // All indexed desktop entries:
+    juce::Array<DesktopEntry::EntryFile> entries;
+
+    // Maps each category string to its category ID:
+    std::map<juce::String, int> categoryIDs;
+
+    // Number of CategoryBits values used to store each entry's category set:
+    int wordsPerEntry = 0;
+
+    // Each entry's category bit set, stored in entry order:
+    std::vector<CategoryBits> entryCategories;
+};
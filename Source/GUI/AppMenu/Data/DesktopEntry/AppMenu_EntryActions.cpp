@@ -1,8 +1,11 @@
 #define APPMENU_IMPLEMENTATION
 #include "AppMenu_EntryActions.h"
+#include "AppMenu_CategoryIndex.h"
 #include "AppMenu_EntryData.h"
 #include "AppMenu_MenuItem.h"
 #include "DesktopEntry_EntryFile.h"
+#include <map>
+#include <set>
 
 // Recursively applies a function to a menu folder and all its subfolders.
 void AppMenu::EntryActions::recursiveFolderAction(
@@ -21,106 +24,134 @@ void AppMenu::EntryActions::recursiveFolderAction(
 }
 
 
-// Applies a function to each desktop entry in a list that shares categories
-// with a folder menu item.
+// Applies a function to each desktop entry in an indexed list that shares
+// categories with a folder menu item.
 void AppMenu::EntryActions::foreachMatchingEntry(
         MenuItem folder,
-        const juce::Array<DesktopEntry::EntryFile>& entries,
+        const CategoryIndex& entries,
         std::function<void(const DesktopEntry::EntryFile&)> entryAction)
 {
-    juce::StringArray folderCategories = folder.getCategories();
-    if (folderCategories.isEmpty())
-    {
-        return;
-    }
+    entries.foreachMatchingEntry(folder.getCategories(), entryAction);
+}
 
-    // TODO: hardcoding this in at this level is sloppy, find a better option
-    if (folderCategories.contains("All"))
+/**
+ * @brief  An anonymous class used to sort desktop entry menu items by title,
+ *         ignoring case.
+ */
+static class
+{
+public:
+    int compareElements(const AppMenu::MenuItem& first,
+            const AppMenu::MenuItem& second)
     {
-        for (const DesktopEntry::EntryFile& entry : entries)
-        {
-            if (!entry.isMissingData())
-            {
-                entryAction(entry);
-            }
-        }
-        return;
+        return first.getSortKey().compare(second.getSortKey());
     }
+} entryItemComparator;
 
-    for (const DesktopEntry::EntryFile& entry : entries)
+
+/**
+ * @brief  Uses a binary search to find where a desktop entry menu item belongs
+ *         within a folder's sorted desktop entry menu items.
+ *
+ * @param folder      A folder menu item.
+ *
+ * @param entryItem   A desktop entry menu item to insert into the folder.
+ *
+ * @param startIndex  The first folder index to search.
+ *
+ * @return            The folder index following all searched items with sort
+ *                    keys that don't come after the entry item's sort key.
+ */
+static int findSortedIndex(const AppMenu::MenuItem& folder,
+        const AppMenu::MenuItem& entryItem, const int startIndex)
+{
+    const std::wstring& sortKey = entryItem.getSortKey();
+    int low = startIndex;
+    int high = folder.getFolderSize();
+    while (low < high)
     {
-        if (entry.isMissingData())
+        const int middle = low + (high - low) / 2;
+        const AppMenu::MenuItem middleItem = folder.getFolderItem(middle);
+        if (sortKey < middleItem.getSortKey())
         {
-            continue;
+            high = middle;
         }
-        juce::StringArray entryCategories = entry.getCategories();
-        for (const juce::String& category : entryCategories)
+        else
         {
-            if (folderCategories.contains(category))
-            {
-                entryAction(entry);
-                break;
-            }
+            low = middle + 1;
         }
     }
+    return low;
 }
 
+
 /**
- * @brief  An anonymous class used to sort desktop entry menu items by title,
- *         ignoring case.
+ * @brief  Checks if a desktop entry menu item is still in sorted order within
+ *         its folder.
+ *
+ * @param folder           The folder menu item containing the entry item.
+ *
+ * @param entryItem        A desktop entry menu item within the folder.
+ *
+ * @param firstEntryIndex  The index of the folder's first desktop entry item.
+ *
+ * @return                 Whether the item's sort key falls between the keys
+ *                         of the desktop entry items next to it.
  */
-static class
+static bool isSortedInFolder(const AppMenu::MenuItem& folder,
+        const AppMenu::MenuItem& entryItem, const int firstEntryIndex)
 {
-public:
-    int compareElements(AppMenu::MenuItem first, AppMenu::MenuItem second)
+    const int index = entryItem.getIndex();
+    const std::wstring& sortKey = entryItem.getSortKey();
+    if (index > firstEntryIndex)
     {
-        juce::String firstTitle = first.getTitle().toUpperCase();
-        juce::String secondTitle = second.getTitle().toUpperCase();
-        if (firstTitle == secondTitle)
+        const AppMenu::MenuItem lastItem = folder.getFolderItem(index - 1);
+        if (sortKey < lastItem.getSortKey())
         {
-            return 0;
+            return false;
         }
-        return (firstTitle < secondTitle) ? -1 : 1;
     }
-} entryItemComparator;
+    if (index + 1 < folder.getFolderSize())
+    {
+        const AppMenu::MenuItem nextItem = folder.getFolderItem(index + 1);
+        if (nextItem.getSortKey() < sortKey)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 
 // Adds folder items created from desktop entry files to a folder if the folder
 // and the entry share application categories.
 void AppMenu::EntryActions::addEntryItems(MenuItem folder,
-        const juce::Array<DesktopEntry::EntryFile>& entries)
+        const CategoryIndex& entries)
 {
-    juce::Array<MenuItem> entryItems = getDesktopEntryItems(folder);
-    foreachMatchingEntry(folder, entries, [&entryItems, &folder]
+    std::set<juce::String> folderEntryIDs;
+    for (const MenuItem& entryItem : getDesktopEntryItems(folder))
+    {
+        folderEntryIDs.insert(entryItem.getID());
+    }
+    juce::Array<MenuItem> newItems;
+    foreachMatchingEntry(folder, entries, [&folderEntryIDs, &newItems]
     (const DesktopEntry::EntryFile& matchingEntry)
     {
-        for (const MenuItem& entryItem : entryItems)
+        // skip duplicate entries
+        if (folderEntryIDs.insert(matchingEntry.getDesktopFileID()).second)
         {
-            if (entryItem.getID() == matchingEntry.getDesktopFileID())
-            {
-                // skip duplicate entries
-                return;
-            }
+            newItems.add(MenuItem(new EntryData(matchingEntry)));
         }
-        entryItems.add(MenuItem(new EntryData(matchingEntry)));
     });
-    entryItems.sort(entryItemComparator, true);
-    const int firstEntryIndex = folder.getMovableChildCount();
-    for (int i = 0; i < entryItems.size(); i++)
+    // Insert new items in sorted order, so each search can start after the
+    // last inserted item:
+    newItems.sort(entryItemComparator, true);
+    int searchStart = folder.getMovableChildCount();
+    for (const MenuItem& newItem : newItems)
     {
-        MenuItem entryItem = entryItems[i];
-        if (entryItem.getIndex() == -1)
-        {
-            const int insertIndex = i + firstEntryIndex;
-            folder.insertChild(entryItem, insertIndex);
-        }
-        if (entryItem.getIndex() != (i + firstEntryIndex))
-        {
-            DBG("AppMenu::EntryActions::" << __func__
-                    << ": Menu item \"" << entryItem.getTitle()
-                    << "\" expected at index " << (i + firstEntryIndex)
-                    << ", found at index " << entryItem.getIndex());
-            jassertfalse;
-        }
+        const int insertIndex = findSortedIndex(folder, newItem, searchStart);
+        folder.insertChild(newItem, insertIndex);
+        searchStart = insertIndex + 1;
     }
 }
 
@@ -129,40 +160,40 @@ void AppMenu::EntryActions::addEntryItems(MenuItem folder,
 void AppMenu::EntryActions::updateEntryItems(MenuItem folder,
         const juce::Array<DesktopEntry::EntryFile>& entries)
 {
-    juce::Array<MenuItem> entryItems = getDesktopEntryItems(folder);
-    for (const DesktopEntry::EntryFile& entry : entries)
+    std::map<juce::String, MenuItem> entryItems;
+    for (const MenuItem& entryItem : getDesktopEntryItems(folder))
     {
-        for (MenuItem& entryItem : entryItems)
-        {
-            if (entryItem.getID() == entry.getDesktopFileID())
-            {
-                // Update existing item:
-                DBG("AppMenu::EntryActions::" << __func__
-                        << ": Updating menu item \"" << entryItem.getTitle()
-                        << "\" with desktop file ID=" << entryItem.getID());
-                DBG("AppMenu::EntryLoader::" << __func__
-                        << ": Updated item is in folder \""
-                        << folder.getTitle() << "\" at index "
-                        << entryItem.getIndex());
-                entryItem.setTitle(entry.getName());
-                entryItem.setIconName(entry.getIcon());
-                entryItem.setCommand(entry.getLaunchCommand());
-                entryItem.setLaunchedInTerm(entry.getLaunchedInTerm());
-                entryItem.setCategories(entry.getCategories());
-            }
-        }
+        entryItems[entryItem.getID()] = entryItem;
     }
-    // Make sure entries are still sorted
-    entryItems.sort(entryItemComparator);
     const int firstEntryIndex = folder.getMovableChildCount();
-    for (int i = 0; i < entryItems.size(); i++)
+    for (const DesktopEntry::EntryFile& entry : entries)
     {
-        MenuItem entryItem = entryItems[i];
-        const int expectedIndex = i + firstEntryIndex;
-        if (entryItem.getIndex() != expectedIndex)
+        auto itemIter = entryItems.find(entry.getDesktopFileID());
+        if (itemIter == entryItems.end())
+        {
+            continue;
+        }
+        MenuItem& entryItem = itemIter->second;
+        // Update existing item:
+        DBG("AppMenu::EntryActions::" << __func__
+                << ": Updating menu item \"" << entryItem.getTitle()
+                << "\" with desktop file ID=" << entryItem.getID());
+        DBG("AppMenu::EntryLoader::" << __func__
+                << ": Updated item is in folder \""
+                << folder.getTitle() << "\" at index "
+                << entryItem.getIndex());
+        entryItem.setTitle(entry.getName());
+        entryItem.setIconName(entry.getIcon());
+        entryItem.setCommand(entry.getLaunchCommand());
+        entryItem.setLaunchedInTerm(entry.getLaunchedInTerm());
+        entryItem.setCategories(entry.getCategories());
+
+        // Move the item if its new title changed its sorted position:
+        if (!isSortedInFolder(folder, entryItem, firstEntryIndex))
         {
-            jassert(expectedIndex > entryItem.getIndex());
-            folder.swapChildren(entryItem.getIndex(), expectedIndex);
+            entryItem.remove(false);
+            folder.insertChild(entryItem,
+                    findSortedIndex(folder, entryItem, firstEntryIndex));
         }
     }
 }
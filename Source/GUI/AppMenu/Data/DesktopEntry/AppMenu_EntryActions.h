@@ -12,6 +12,7 @@
 #include "JuceHeader.h"
 
 namespace AppMenu { class MenuItem; }
+namespace AppMenu { class CategoryIndex; }
 namespace DesktopEntry { class EntryFile; }
 
 namespace AppMenu
@@ -31,18 +32,19 @@ namespace AppMenu
                 const std::function<void(MenuItem)> folderAction);
 
         /**
-         * @brief  Applies a function to each desktop entry in a list that
-         *         shares categories with a folder menu item.
+         * @brief  Applies a function to each desktop entry in an indexed list
+         *         that shares categories with a folder menu item.
          *
          * @param folder        A folder menu item.
          *
-         * @param entries       A list of desktop entries.
+         * @param entries       An index of desktop entries and their
+         *                      categories.
          *
          * @param entryAction   A function to call for each entry that shares a
          *                      category with the folder.
          */
         void foreachMatchingEntry(MenuItem folder,
-                const juce::Array<DesktopEntry::EntryFile>& entries,
+                const CategoryIndex& entries,
                 std::function<void(const DesktopEntry::EntryFile&)>
                     entryAction);
 
@@ -53,11 +55,10 @@ namespace AppMenu
          *
          * @param folder   A folder menu item.
          *
-         * @param entries  A list of entries that may need to be added to the
-         *                 folder as new menu items.
+         * @param entries  An index of entries that may need to be added to
+         *                 the folder as new menu items.
          */
-        void addEntryItems(MenuItem folder,
-                const juce::Array<DesktopEntry::EntryFile>& entries);
+        void addEntryItems(MenuItem folder, const CategoryIndex& entries);
 
         /**
          * @brief  Applies desktop entry updates to all matching menu items in a
@@ -2,7 +2,6 @@
 #include "AppMenu_EntryData.h"
 #include "DesktopEntry_Loader.h"
 #include "DesktopEntry_FormatError.h"
-#include "DesktopEntry_FileError.h"
 
 #ifdef JUCE_DEBUG
 // Print the full class name before all debug output:
@@ -156,20 +155,8 @@ bool AppMenu::EntryData::isMovable() const
 // Writes all changes to this menu item back to its data source.
 void AppMenu::EntryData::saveChanges()
 {
-    try
-    {
-        desktopEntry.writeFile();
-    }
-    catch(DesktopEntry::FileError e)
-    {
-        DBG(dbgPrefix << __func__ << ": Failed to write changes:" << e.what());
-    }
-    catch(DesktopEntry::FormatError e)
-    {
-        DBG(dbgPrefix << __func__ << ": Failed to write changes:" << e.what());
-    }
     DesktopEntry::Loader entryLoader;
-    entryLoader.scanForChanges();
+    entryLoader.saveEntry(desktopEntry);
 }
 
 
@@ -206,18 +193,6 @@ bool AppMenu::EntryData::isEditable(const DataField dataField) const
 void AppMenu::EntryData::deleteFromSource()
 {
     desktopEntry.setIfDisplayed(false);
-    try
-    {
-        desktopEntry.writeFile();
-        DesktopEntry::Loader entryLoader;
-        entryLoader.scanForChanges();
-    }
-    catch(DesktopEntry::FileError e)
-    {
-        DBG(dbgPrefix << __func__ << ": Failed to hide entry:" << e.what());
-    }
-    catch(DesktopEntry::FormatError e)
-    {
-        DBG(dbgPrefix << __func__ << ": Failed to hide entry:" << e.what());
-    }
+    DesktopEntry::Loader entryLoader;
+    entryLoader.saveEntry(desktopEntry);
 }
@@ -2,6 +2,7 @@
 #include "AppMenu_EntryLoader.h"
 #include "AppMenu_EntryData.h"
 #include "AppMenu_EntryActions.h"
+#include "AppMenu_CategoryIndex.h"
 #include "AppMenu_MenuFile.h"
 #include "AppMenu_MenuItem.h"
 #include "DesktopEntry_Loader.h"
@@ -38,8 +39,7 @@ void AppMenu::EntryLoader::loadFolderEntries(MenuItem folderItem)
                 == folderItem.getFolderSize());
 
         DesktopEntry::Loader entryLoader;
-        juce::Array<DesktopEntry::EntryFile> allEntries
-            = entryLoader.getAllEntries();
+        const CategoryIndex allEntries(entryLoader.getAllEntries());
         EntryActions::recursiveFolderAction(folderItem, [this, &allEntries]
             (MenuItem folder)
         {
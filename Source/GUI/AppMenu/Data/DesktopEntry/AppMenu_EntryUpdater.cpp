@@ -2,6 +2,7 @@
 #include "AppMenu_EntryUpdater.h"
 #include "AppMenu_EntryData.h"
 #include "AppMenu_EntryActions.h"
+#include "AppMenu_CategoryIndex.h"
 #include "AppMenu_MenuItem.h"
 #include "AppMenu_MenuFile.h"
 #include "DesktopEntry_Loader.h"
@@ -37,8 +38,7 @@ void AppMenu::EntryUpdater::entriesAdded(const juce::StringArray entryFileIDs)
 {
     DBG("AppMenu::EntryUpdater::" << __func__ << ": Updating menu with "
             << entryFileIDs.size() << " new entry files.");
-    juce::Array<DesktopEntry::EntryFile> newEntries
-        = loadEntryFiles(entryFileIDs);
+    const CategoryIndex newEntries(loadEntryFiles(entryFileIDs));
     MenuFile appConfig;
     EntryActions::recursiveFolderAction(appConfig.getRootFolderItem(),
     [this, &newEntries](MenuItem folder)
@@ -76,14 +76,17 @@ void AppMenu::EntryUpdater::entriesUpdated(const juce::StringArray entryFileIDs)
 {
     DBG("AppMenu::EntryUpdater::" << __func__ << ": Updating menu with "
             << entryFileIDs.size() << " changed entry files.");
-    juce::Array<DesktopEntry::EntryFile> newEntries
-        = loadEntryFiles(entryFileIDs);
+    const juce::Array<DesktopEntry::EntryFile> updatedEntries
+            = loadEntryFiles(entryFileIDs);
+    const CategoryIndex newEntries(updatedEntries);
     MenuFile appConfig;
     EntryActions::recursiveFolderAction(appConfig.getRootFolderItem(),
-    [this, &newEntries](MenuItem folder)
+    [this, &updatedEntries, &newEntries](MenuItem folder)
     {
         // Find and remove any entries that no longer have matching categories.
-        juce::Array<DesktopEntry::EntryFile> toRemove = newEntries;
+        // Entries missing required data are never indexed, so their items are
+        // always removed.
+        juce::Array<DesktopEntry::EntryFile> toRemove = updatedEntries;
         EntryActions::foreachMatchingEntry(folder, newEntries,
         [&toRemove](const DesktopEntry::EntryFile& matchingEntry)
         {
@@ -104,7 +107,7 @@ void AppMenu::EntryUpdater::entriesUpdated(const juce::StringArray entryFileIDs)
         }
 
         // Update existing entries with changed data.
-        EntryActions::updateEntryItems(folder, newEntries);
+        EntryActions::updateEntryItems(folder, newEntries.getEntries());
 
         // Add existing entries that were changed to share a category with the
         // folder.
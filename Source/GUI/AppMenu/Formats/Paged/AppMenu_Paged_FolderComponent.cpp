@@ -77,6 +77,9 @@ void AppMenu::Paged::FolderComponent::updateButtonLayout()
     const int buttonWidth    = buttonXArea - (2 * buttonXPadding);
     const int buttonHeight   = buttonYArea - (2 * buttonYPadding);
 
+    // Set icon priorities before button bounds are set, as buttons request
+    // their icons when they're first given non-empty bounds:
+    updateIconPriorities();
     for (int i = 0; i < getFolderSize(); i++)
     {
         const int pageNum   = i / buttonsPerPage;
@@ -122,6 +125,7 @@ void AppMenu::Paged::FolderComponent::setCurrentFolderPage
 (const int indexToShow)
 {
     activeFolderPage = indexToShow;
+    updateIconPriorities();
 }
 
 
@@ -184,6 +188,26 @@ bool AppMenu::Paged::FolderComponent::setSelectedPosition
 }
 
 
+// Gets the range of menu indices on the visible folder page and the folder
+// pages on either side of it.
+juce::Range<int> AppMenu::Paged::FolderComponent::getNearbyIndexRange() const
+{
+    const int pageSize = maxPageItemCount();
+    const int firstIndex = std::max(0, (activeFolderPage - 1) * pageSize);
+    const int lastIndex = std::min(getFolderSize(),
+            (activeFolderPage + 2) * pageSize);
+    return juce::Range<int>(firstIndex, std::max(firstIndex, lastIndex));
+}
+
+
+// Gets the number of menu items that fit on the first page of a newly opened
+// folder.
+int AppMenu::Paged::FolderComponent::getInitialItemCount() const
+{
+    return maxPageItemCount();
+}
+
+
 // Gets the number of menu items that fit in one folder page.
 int AppMenu::Paged::FolderComponent::maxPageItemCount() const
 {
@@ -203,3 +227,25 @@ int AppMenu::Paged::FolderComponent::selectedIndexInPage() const
     }
     return selectedIndex % maxPageItemCount();
 }
+
+
+// Updates the icon loading priority of each menu button, so that icons on the
+// visible folder page load first, followed by icons on adjacent pages.
+void AppMenu::Paged::FolderComponent::updateIconPriorities()
+{
+    const int pageSize = maxPageItemCount();
+    for (int i = 0; i < getFolderSize(); i++)
+    {
+        const int pageDistance = std::abs(i / pageSize - activeFolderPage);
+        Icon::Priority priority = Icon::Priority::background;
+        if (pageDistance == 0)
+        {
+            priority = Icon::Priority::visible;
+        }
+        else if (pageDistance == 1)
+        {
+            priority = Icon::Priority::adjacent;
+        }
+        getButtonComponent(i)->setIconPriority(priority);
+    }
+}
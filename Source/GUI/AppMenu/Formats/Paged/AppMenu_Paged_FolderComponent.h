@@ -145,6 +145,22 @@ public:
      */
     bool setSelectedPosition(const int page, const int column, const int row);
 
+    /**
+     * @brief  Gets the range of menu indices on the visible folder page and
+     *         the folder pages on either side of it.
+     *
+     * @return  The range of nearby folder indices.
+     */
+    virtual juce::Range<int> getNearbyIndexRange() const final override;
+
+    /**
+     * @brief  Gets the number of menu items that fit on the first page of a
+     *         newly opened folder.
+     *
+     * @return  The maximum number of menu items in one folder page.
+     */
+    virtual int getInitialItemCount() const final override;
+
 private:
     /**
      * @brief  Gets the number of menu items that fit in one folder page.
@@ -161,6 +177,13 @@ private:
      */
     int selectedIndexInPage() const;
 
+    /**
+     * @brief  Updates the icon loading priority of each menu button, so that
+     *         icons on the visible folder page load first, followed by icons
+     *         on adjacent pages.
+     */
+    void updateIconPriorities();
+
     // Tracks which folder page is currently shown.
     int activeFolderPage = 0;
 };
@@ -69,6 +69,7 @@ bool AppMenu::Paged::InputHandler::keyPressed
         {
             activeFolder->setCurrentFolderPage(0);
             getMenuComponent()->updateMenuLayout(true);
+            getController()->prefetchIcons();
         }
         else if (getMenuComponent()->openFolderCount() > 0)
         {
@@ -152,6 +153,7 @@ bool AppMenu::Paged::InputHandler::keyPressed
         {
             activeFolder->setCurrentFolderPage(newPage);
             getMenuComponent()->updateMenuLayout();
+            getController()->prefetchIcons();
         }
     }
     return true;
@@ -191,6 +193,7 @@ void AppMenu::Paged::InputHandler::buttonClicked(juce::Button* button)
                 activeFolder->setSelectedIndex(-1);
                 activeFolder->setCurrentFolderPage(targetFolderPage);
                 getMenuComponent()->updateMenuLayout();
+                getController()->prefetchIcons();
             }
             break;
         }
@@ -244,7 +244,7 @@ void Settings::WifiList::ListComponent::selectionChanged()
 void Settings::WifiList::ListComponent::signalStrengthUpdate
 (const Wifi::AccessPoint updatedAP)
 {
-    scheduleListUpdate();
+    listUpdateQueued = true;
 }
 
 
@@ -264,7 +264,7 @@ void Settings::WifiList::ListComponent::accessPointAdded
             invalidSelectionIndex = -1;
         }
     }
-    scheduleListUpdate();
+    listUpdateQueued = true;
 }
 
 
@@ -290,12 +290,23 @@ void Settings::WifiList::ListComponent::accessPointRemoved
         else
         {
             visibleAPs.set(removedIndex, Wifi::AccessPoint());
-            scheduleListUpdate();
+            listUpdateQueued = true;
         }
     }
 }
 
 
+// Updates the list once after receiving a batch of access point updates.
+void Settings::WifiList::ListComponent::updateBatchFinished()
+{
+    if (listUpdateQueued)
+    {
+        listUpdateQueued = false;
+        scheduleListUpdate();
+    }
+}
+
+
 // Updates access point connection controls when a connection starts to
 // activate.
 void Settings::WifiList::ListComponent::startedConnecting
@@ -130,6 +130,13 @@ private:
     virtual void accessPointRemoved
     (const Wifi::AccessPoint removedAP) override;
 
+    /**
+     * @brief  Updates the list once after receiving a batch of access point
+     *         updates, so that scans changing many access points only sort and
+     *         animate the list once.
+     */
+    virtual void updateBatchFinished() override;
+
     /**
      * @brief  Updates access point connection controls when a connection
      *         starts to activate.
@@ -170,6 +177,9 @@ private:
     // Tracks whether the access point list needs to be sorted:
     bool fullUpdateNeeded = false;
 
+    // Tracks whether queued access point updates changed the list:
+    bool listUpdateQueued = false;
+
     // If the selected AP is lost, save its index so it will be removed once it
     // is deselected.
     int invalidSelectionIndex = -1;
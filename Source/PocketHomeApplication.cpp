@@ -12,6 +12,10 @@
 #include "Debug_ScopeTimerRecords.h"
 #endif
 
+#ifdef SHARED_RESOURCE_LOCK_STATS
+#include "SharedResource_LockStats.h"
+#endif
+
 #ifdef JUCE_DEBUG
 // Print the full class name before all debug output:
 static const constexpr char* dbgPrefix = "PocketHomeApplication::";
@@ -157,6 +161,9 @@ void PocketHomeApplication::shutdown()
     #ifdef INCLUDE_TESTING
     Debug::ScopeTimerRecords::printRecords();
     #endif
+    #ifdef SHARED_RESOURCE_LOCK_STATS
+    SharedResource::LockStats::printStats();
+    #endif
 }
 
 
@@ -19,6 +19,10 @@ static std::map<Wifi::LibNM::APHash, Wifi::AccessPoint> wifiAccessPoints;
 static std::map<Wifi::LibNM::APHash, juce::Array<Wifi::LibNM::AccessPoint>>
         nmAccessPoints;
 
+// Prefix used to build update keys for signal strength updates, so that only
+// the most recent queued strength update for each access point is sent:
+static const constexpr char* strengthUpdatePrefix = "SignalStrength:";
+
 #ifdef JUCE_DEBUG
 // Print the full class name before all debug output:
 static const constexpr char* dbgPrefix = "Wifi::APList::Module::";
@@ -206,7 +210,7 @@ void Wifi::APList::Module::addAccessPoint(const LibNM::AccessPoint addedAP)
     AccessPoint updatedAP = wifiAccessPoints[apHash];
     if (newConnectionVisible)
     {
-        foreachModuleHandler<UpdateInterface>([updatedAP]
+        queueHandlerUpdate<UpdateInterface>(juce::String(), [updatedAP]
                 (UpdateInterface* updateHandler)
         {
             updateHandler->accessPointAdded(updatedAP);
@@ -214,7 +218,8 @@ void Wifi::APList::Module::addAccessPoint(const LibNM::AccessPoint addedAP)
     }
     else if (signalStrengthChanged)
     {
-        foreachModuleHandler<AP::UpdateInterface>([updatedAP]
+        queueHandlerUpdate<AP::UpdateInterface>(strengthUpdatePrefix
+                + apHash.toString(), [updatedAP]
                 (AP::UpdateInterface* updateHandler)
         {
             updateHandler->signalStrengthChanged(updatedAP);
@@ -252,7 +257,8 @@ void Wifi::APList::Module::updateSignalStrength(AccessPoint toUpdate)
     {
         static_cast<APInterface::SignalStrength*>
                 (&toUpdate)->setSignalStrength(bestSignalStrength);
-        foreachModuleHandler<AP::UpdateInterface>([toUpdate]
+        queueHandlerUpdate<AP::UpdateInterface>(strengthUpdatePrefix
+                + apHash.toString(), [toUpdate]
                 (AP::UpdateInterface* updateHandler)
         {
             updateHandler->signalStrengthChanged(toUpdate);
@@ -326,7 +332,7 @@ void Wifi::APList::Module::updateAPIfLost(AccessPoint toCheck)
     {
         static_cast<APInterface::SignalStrength*>(&toCheck)
                 ->setSignalStrength(0);
-        foreachModuleHandler<UpdateInterface>([toCheck]
+        queueHandlerUpdate<UpdateInterface>(juce::String(), [toCheck]
                 (UpdateInterface* updateHandler)
         {
             updateHandler->accessPointRemoved(toCheck);
@@ -7,10 +7,30 @@
 static const constexpr char* dbgPrefix = "Wifi::FocusUpdater::";
 #endif
 
-// Scans for missed Wifi connection events when window focus is regained.
+// Schedules a scan for missed Wifi connection events when window focus is
+// regained.
 void Wifi::FocusUpdater::windowFocusGained()
 {
-    DBG(dbgPrefix << __func__ << ": Updating connection records:");
-    Connection::Record::Handler recordHandler;
-    recordHandler.updateRecords();
+    recordUpdateNeeded = true;
+}
+
+
+// Cancels any scheduled connection scan when window focus is lost.
+void Wifi::FocusUpdater::windowFocusLost()
+{
+    recordUpdateNeeded = false;
+}
+
+
+// Scans for missed Wifi connection events after a batch of focus updates if
+// window focus was regained.
+void Wifi::FocusUpdater::updateBatchFinished()
+{
+    if (recordUpdateNeeded)
+    {
+        recordUpdateNeeded = false;
+        DBG(dbgPrefix << __func__ << ": Updating connection records:");
+        Connection::Record::Handler recordHandler;
+        recordHandler.updateRecords();
+    }
 }
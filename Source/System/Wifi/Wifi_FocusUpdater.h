@@ -29,8 +29,22 @@ public:
 
 private:
     /**
-     * @brief  Scans for missed Wifi connection events when window focus is
-     *         regained.
+     * @brief  Schedules a scan for missed Wifi connection events when window
+     *         focus is regained.
      */
     virtual void windowFocusGained() override;
+
+    /**
+     * @brief  Cancels any scheduled connection scan when window focus is lost.
+     */
+    virtual void windowFocusLost() override;
+
+    /**
+     * @brief  Scans for missed Wifi connection events after a batch of focus
+     *         updates if window focus was regained.
+     */
+    virtual void updateBatchFinished() override;
+
+    // Whether connection records should be updated once focus updates finish:
+    bool recordUpdateNeeded = false;
 };
@@ -5,6 +5,9 @@
 const juce::Identifier Windows::FocusTracker::resourceKey
         = "Windows::FocusTracker";
 
+// Update key used to replace queued focus updates with newer focus updates:
+static const constexpr char* focusUpdateKey = "FocusState";
+
 Windows::FocusTracker::FocusTracker() :
 SharedResource::Resource(resourceKey) { }
 
@@ -25,10 +28,10 @@ void Windows::FocusTracker::setFocusState
         isFocused = windowFocused;
         if (notifyListeners)
         {
-            foreachHandler<FocusInterface>(
-            [this](FocusInterface* focusListener)
+            queueHandlerUpdate<FocusInterface>(focusUpdateKey,
+            [windowFocused](FocusInterface* focusListener)
             {
-                if (isFocused)
+                if (windowFocused)
                 {
                     focusListener->windowFocusGained();
                 }
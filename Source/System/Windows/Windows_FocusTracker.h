@@ -33,6 +33,10 @@ public:
     /**
      * @brief  Updates whether the main application window is currently focused.
      *
+     *  Listeners are notified on the message thread once the current message
+     * loop turn ends. If focus changes several times before then, listeners
+     * only receive the final focus state.
+     *
      * @param windowFocused    Whether the MainWindow object is the focused
      *                         window.
      *
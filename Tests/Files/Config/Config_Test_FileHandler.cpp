@@ -105,3 +105,10 @@ void Config::Test::FileHandler::restoreToDefault()
     resource->setTestArray({1, 2, 3});
     resource->setTestObject(ObjectData(5, false));
 }
+
+
+// Immediately writes all changes to the test file.
+void Config::Test::FileHandler::syncChanges()
+{
+    Config::FileHandler<Resource>::syncChanges();
+}
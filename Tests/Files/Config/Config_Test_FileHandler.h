@@ -116,4 +116,9 @@ public:
      * @brief  Restores all default values.
      */
     void restoreToDefault();
+
+    /**
+     * @brief  Immediately writes all changes to the test file.
+     */
+    void syncChanges();
 };
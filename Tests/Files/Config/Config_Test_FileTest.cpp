@@ -7,6 +7,13 @@
 #include "Config_Test_FileHandler.h"
 #include "Config_Test_Listener.h"
 #include "Config_Test_JSONKeys.h"
+#include "Testing_DelayUtils.h"
+
+// Milliseconds to wait between checks for background file writes:
+static const constexpr int testFrequency = 100;
+
+// Milliseconds to wait before assuming background file writes failed:
+static const constexpr int timeout = 3000;
 
 namespace Config { namespace Test { class FileTest; } }
 
@@ -40,6 +47,7 @@ public:
 
         std::unique_ptr<FileHandler> handler = std::make_unique<FileHandler>();
         Listener testListener;
+        handler->syncChanges();
 
         expectGreaterThan(testFile.getSize(), int64(0),
                 "Failed to restore and save default config values.");
@@ -91,7 +99,10 @@ public:
         handler->setTestArray(newArray);
         handler->setTestObject(newObject);
 
-        expectGreaterThan(testFile.getSize(), defaultSize,
+        expect(Testing::DelayUtils::idleUntil([&testFile, defaultSize]()
+                {
+                    return testFile.getSize() > defaultSize;
+                }, testFrequency, timeout),
                 "Changes were not written to config file.");
         expectEquals(handler->getTestInt(), newInt,
                 "Failed to update test integer value.");
@@ -113,6 +124,7 @@ public:
         testListener.removeTrackedKey(JSONKeys::testBool);
         testListener.addTrackedKey(JSONKeys::testString);
         handler->restoreToDefault();
+        handler->syncChanges();
         expectEquals(testListener.getLastUpdated(),
                 ((juce::Identifier&) JSONKeys::testString).toString(),
                 "TestListener should have only registered the string update.");
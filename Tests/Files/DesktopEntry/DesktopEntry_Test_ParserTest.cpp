@@ -0,0 +1,183 @@
+#define DESKTOP_ENTRY_IMPLEMENTATION
+#include "DesktopEntry_LineParser.h"
+#include "DesktopEntry_FileUtils.h"
+#include "DesktopEntry_EntryFile.h"
+#include "DesktopEntry_FileError.h"
+#include "DesktopEntry_FormatError.h"
+#include "Assets_XDGDirectories.h"
+#include "JuceHeader.h"
+
+namespace DesktopEntry { namespace Test { class ParserTest; } }
+
+// Number of times each benchmark parses the desktop entry file corpus:
+static const constexpr int benchmarkRounds = 20;
+
+// Desktop entry data used to test line parsing:
+static const constexpr char* testFileData =
+        "# Comment line\r\n"
+        "[Desktop Entry]\r\n"
+        "Type=Application\n"
+        "Name = Test Entry\n"
+        "Name[xx_YY]=Localized Name\n"
+        "X-Custom-Key=custom\n"
+        "Exec=test --option=value\n"
+        "\n"
+        "[Desktop Action test]\n"
+        "Name=Action";
+
+/**
+ * @brief  Tests desktop entry line parsing, and measures how quickly all
+ *         installed desktop entry files are parsed.
+ */
+class DesktopEntry::Test::ParserTest : public juce::UnitTest
+{
+public:
+    ParserTest() : juce::UnitTest("DesktopEntry::LineParser Testing",
+            "DesktopEntry") {}
+
+    void runTest() override
+    {
+        using juce::String;
+        beginTest("Data key lookup");
+        for (int i = 0; i < (int) DataKey::unknown; i++)
+        {
+            const DataKey key = (DataKey) i;
+            const String keyName = FileUtils::getKeyName(key);
+            expect(FileUtils::findDataKey(keyName.toRawUTF8(),
+                        keyName.length()) == key,
+                    String("Failed to find key ") + keyName);
+            expect(FileUtils::findDataKey(keyName.toRawUTF8(),
+                        keyName.length() - 1) == DataKey::unknown,
+                    String("Found truncated key ") + keyName);
+        }
+        expect(FileUtils::findDataKey("X-Custom", 8) == DataKey::unknown,
+                "Found nonstandard key.");
+
+        beginTest("Line parsing");
+        LineParser parser(testFileData, strlen(testFileData));
+        LineParser::Line line;
+        const juce::Array<LineParser::LineType> expectedTypes =
+        {
+            LineParser::LineType::empty,
+            LineParser::LineType::header,
+            LineParser::LineType::keyValue,
+            LineParser::LineType::keyValue,
+            LineParser::LineType::keyValue,
+            LineParser::LineType::unknownKey,
+            LineParser::LineType::keyValue,
+            LineParser::LineType::empty,
+            LineParser::LineType::header,
+            LineParser::LineType::keyValue
+        };
+        juce::Array<LineParser::Line> lines;
+        while (parser.nextLine(line))
+        {
+            lines.add(line);
+        }
+        expectEquals(lines.size(), expectedTypes.size(),
+                "Unexpected line count.");
+        for (int i = 0; i < lines.size() && i < expectedTypes.size(); i++)
+        {
+            expect(lines[i].type == expectedTypes[i],
+                    String("Unexpected type for line ") + String(i));
+        }
+        if (lines.size() == expectedTypes.size())
+        {
+            expectEquals(lines[1].header.toString(), String("Desktop Entry"));
+            expectEquals(lines[3].keyText.toString(), String("Name"));
+            expectEquals(lines[3].value.toString(), String("Test Entry"));
+            expectEquals(lines[4].locale.toString(), String("xx_YY"));
+            expect(lines[6].key == DataKey::exec, "Exec key not found.");
+            expectEquals(lines[6].value.toString(),
+                    String("test --option=value"));
+            expectEquals(lines[9].value.toString(), String("Action"));
+        }
+
+        beginTest("Desktop entry parsing benchmark");
+        juce::Array<juce::File> corpus = findEntryFiles();
+        if (corpus.isEmpty())
+        {
+            logMessage("No desktop entry files found, skipping benchmark.");
+            return;
+        }
+        juce::OwnedArray<juce::MemoryBlock> fileData;
+        for (const juce::File& entryFile : corpus)
+        {
+            juce::MemoryBlock* data = fileData.add(new juce::MemoryBlock);
+            entryFile.loadFileAsData(*data);
+        }
+
+        // Measure line parsing alone:
+        int lineCount = 0;
+        double startTime = juce::Time::getMillisecondCounterHiRes();
+        for (int round = 0; round < benchmarkRounds; round++)
+        {
+            for (const juce::MemoryBlock* data : fileData)
+            {
+                LineParser fileParser(data->getData(), data->getSize());
+                while (fileParser.nextLine(line))
+                {
+                    lineCount++;
+                }
+            }
+        }
+        const double lineParseTime = juce::Time::getMillisecondCounterHiRes()
+                - startTime;
+        expect(lineCount > 0, "No lines parsed.");
+
+        // Measure complete EntryFile loading:
+        int parsedCount = 0;
+        startTime = juce::Time::getMillisecondCounterHiRes();
+        for (int round = 0; round < benchmarkRounds; round++)
+        {
+            for (const juce::File& entryFile : corpus)
+            {
+                try
+                {
+                    EntryFile entry(entryFile, entryFile.getFileName());
+                    parsedCount++;
+                }
+                catch(FileError e) { }
+                catch(FormatError e) { }
+            }
+        }
+        const double entryParseTime = juce::Time::getMillisecondCounterHiRes()
+                - startTime;
+        expect(parsedCount > 0, "No desktop entry files parsed.");
+
+        const int fileCount = corpus.size() * benchmarkRounds;
+        logMessage(String("Parsed ") + String(corpus.size())
+                + " files " + String(benchmarkRounds) + " times.");
+        logMessage(String("Line parsing: ")
+                + String(lineParseTime * 1000.0 / fileCount, 2)
+                + " microseconds per file.");
+        logMessage(String("EntryFile loading: ")
+                + String(entryParseTime * 1000.0 / fileCount, 2)
+                + " microseconds per file.");
+    }
+
+private:
+    /**
+     * @brief  Finds all desktop entry files installed in the system's data
+     *         directories.
+     *
+     * @return  All .desktop files found.
+     */
+    juce::Array<juce::File> findEntryFiles()
+    {
+        juce::Array<juce::File> entryFiles;
+        for (const juce::String& dataDir :
+                Assets::XDGDirectories::getDataSearchPaths())
+        {
+            const juce::File entryDir(dataDir + "/applications");
+            if (entryDir.isDirectory())
+            {
+                entryFiles.addArray(entryDir.findChildFiles(
+                            juce::File::findFiles, true, "*.desktop"));
+            }
+        }
+        return entryFiles;
+    }
+};
+
+static DesktopEntry::Test::ParserTest test;
@@ -0,0 +1,160 @@
+#define DESKTOP_ENTRY_IMPLEMENTATION
+#include "DesktopEntry_SearchIndex.h"
+#include "JuceHeader.h"
+
+namespace DesktopEntry { namespace Test { class SearchIndexTest; } }
+
+// Number of generated entries added to the index when measuring search time:
+static const constexpr int generatedEntryCount = 400;
+
+// Number of search queries used when measuring search time:
+static const constexpr int timedQueryCount = 200;
+
+// Maximum average search time allowed, in milliseconds. This is far above the
+// expected search time, so that only real slowdowns fail on loaded machines:
+static const constexpr double maxSearchTime = 10.0;
+
+// Maximum number of search results requested:
+static const constexpr int maxResults = 20;
+
+/**
+ * @brief  Tests desktop entry search results, and measures search speed.
+ */
+class DesktopEntry::Test::SearchIndexTest : public juce::UnitTest
+{
+public:
+    SearchIndexTest() : juce::UnitTest("DesktopEntry::SearchIndex Testing",
+            "DesktopEntry") {}
+
+    void runTest() override
+    {
+        using juce::String;
+        using juce::StringArray;
+        SearchIndex searchIndex;
+        searchIndex.addEntry("firefox.desktop", createEntry("firefoxTest",
+                    "Firefox", "Web Browser", "Network;WebBrowser;",
+                    "Internet;WWW;", "/usr/lib/firefox/firefox %u"));
+        searchIndex.addEntry("terminal.desktop", createEntry("terminalTest",
+                    "Terminal", "Terminal Emulator", "System;TerminalEmulator;",
+                    "shell;prompt;command;", "xterm"));
+        searchIndex.addEntry("files.desktop", createEntry("filesTest",
+                    "Files", "File Manager", "System;FileManager;",
+                    "folder;browser;", "pcmanfm"));
+
+        beginTest("Search matching");
+        expectEquals(searchIndex.findEntries("firefox", maxResults),
+                StringArray("firefox.desktop"), "Exact match failed.");
+        expectEquals(searchIndex.findEntries("firef", maxResults),
+                StringArray("firefox.desktop"), "Prefix match failed.");
+        expectEquals(searchIndex.findEntries("frefox", maxResults),
+                StringArray("firefox.desktop"), "Typo match failed.");
+        expectEquals(searchIndex.findEntries("xterm", maxResults),
+                StringArray("terminal.desktop"), "Exec match failed.");
+        expectEquals(searchIndex.findEntries("web browser", maxResults),
+                StringArray("firefox.desktop"), "Multi-word match failed.");
+        expect(searchIndex.findEntries("spreadsheet", maxResults).isEmpty(),
+                "Found entries for unmatched query.");
+
+        beginTest("Search ranking");
+        const StringArray browserResults = searchIndex.findEntries("browser",
+                maxResults);
+        expectEquals(browserResults.size(), 2, "Expected two results.");
+        expectEquals(browserResults[0], String("firefox.desktop"),
+                "Generic name match should rank above keyword match.");
+
+        beginTest("Entry removal");
+        searchIndex.removeEntry("firefox.desktop");
+        expect(searchIndex.findEntries("firefox", maxResults).isEmpty(),
+                "Removed entry was found.");
+        expectEquals(searchIndex.findEntries("browser", maxResults),
+                StringArray("files.desktop"), "Remaining entry not found.");
+
+        beginTest("Search speed");
+        juce::Random random(generatedEntryCount);
+        StringArray queries;
+        for (int i = 0; i < generatedEntryCount; i++)
+        {
+            const String name = generateWord(random) + " "
+                    + generateWord(random);
+            searchIndex.addEntry(String("generated") + String(i),
+                    createEntry(String("generatedTest") + String(i), name,
+                        generateWord(random), generateWord(random),
+                        generateWord(random) + ";" + generateWord(random),
+                        generateWord(random)));
+            queries.add(name.substring(0, random.nextInt({2, 6})));
+        }
+        int unmatchedQueries = 0;
+        int oversizedResults = 0;
+        const double startTime = juce::Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < timedQueryCount; i++)
+        {
+            const int resultCount = searchIndex.findEntries(
+                    queries[i % queries.size()], maxResults).size();
+            unmatchedQueries += (resultCount == 0) ? 1 : 0;
+            oversizedResults += (resultCount > maxResults) ? 1 : 0;
+        }
+        const double averageTime = (juce::Time::getMillisecondCounterHiRes()
+                - startTime) / timedQueryCount;
+        logMessage(String("Average search time: ") + String(averageTime, 4)
+                + "ms");
+        expect(averageTime < maxSearchTime, String("Average search time ")
+                + String(averageTime, 4) + "ms exceeded the "
+                + String(maxSearchTime) + "ms limit.");
+        expectEquals(unmatchedQueries, 0,
+                "Name prefix queries should always find entries.");
+        expectEquals(oversizedResults, 0,
+                "Search results exceeded the requested maximum.");
+    }
+
+private:
+    /**
+     * @brief  Creates a desktop entry for testing.
+     *
+     * @param entryID      The entry's desktop file ID.
+     *
+     * @param name         The entry's name.
+     *
+     * @param genericName  The entry's generic name.
+     *
+     * @param categories   The entry's categories, separated by semicolons.
+     *
+     * @param keywords     The entry's keywords, separated by semicolons.
+     *
+     * @param exec         The entry's launch command.
+     *
+     * @return             The new desktop entry.
+     */
+    EntryFile createEntry(const juce::String& entryID,
+            const juce::String& name, const juce::String& genericName,
+            const juce::String& categories, const juce::String& keywords,
+            const juce::String& exec)
+    {
+        EntryFile entry(name, entryID, EntryFile::Type::application);
+        entry.setGenericName(genericName);
+        entry.setCategories(juce::StringArray::fromTokens(categories, ";",
+                    ""));
+        entry.setKeywords(juce::StringArray::fromTokens(keywords, ";", ""));
+        entry.setExec(exec);
+        return entry;
+    }
+
+    /**
+     * @brief  Generates a random lowercase word.
+     *
+     * @param random  The random number generator to use.
+     *
+     * @return        A word between four and ten characters long.
+     */
+    juce::String generateWord(juce::Random& random)
+    {
+        juce::String word;
+        const int length = random.nextInt({4, 11});
+        for (int i = 0; i < length; i++)
+        {
+            word += (char) ('a' + random.nextInt(26));
+        }
+        return word;
+    }
+};
+
+static DesktopEntry::Test::SearchIndexTest test;
@@ -0,0 +1,278 @@
+#include "Icon_Cache.h"
+#include "JuceHeader.h"
+#include <vector>
+
+namespace Icon { namespace Test { class CacheTest; } }
+
+// Temporary icon theme directory where the test cache file is written:
+static const constexpr char* testThemeName = "pocket-home-icon-cache-test";
+
+// Number of hash buckets in the test cache file. This is kept small so that
+// most buckets hold chains of several icons:
+static const constexpr juce::uint32 testBucketCount = 3;
+
+// Icon theme subdirectories listed in the test cache file:
+static const juce::StringArray testDirectories =
+{
+    "16x16/apps",
+    "32x32/apps",
+    "scalable/apps"
+};
+
+// Extension flags used in the test cache file:
+static const constexpr juce::uint16 xpmFlag = 1;
+static const constexpr juce::uint16 svgFlag = 2;
+static const constexpr juce::uint16 pngFlag = 4;
+
+/**
+ * @brief  An icon listed in the test cache file, along with the
+ *         subdirectories that hold it and their extension flags.
+ */
+struct TestIcon
+{
+    const char* name;
+    std::vector<std::pair<juce::uint16, juce::uint16>> images;
+};
+
+// Icons listed in the test cache file:
+static const std::vector<TestIcon> testIcons =
+{
+    { "firefox", { { 0, pngFlag }, { 1, pngFlag }, { 2, svgFlag } } },
+    { "terminal", { { 1, xpmFlag } } },
+    { "editor", { { 0, pngFlag | svgFlag } } },
+    { "calculator", { { 2, svgFlag } } },
+    { "files", { { 0, pngFlag }, { 1, xpmFlag } } },
+    { "no-image", { { 1, 0 } } }
+};
+
+/**
+ * @brief  Tests single and batched icon lookups using a generated GTK icon
+ *         cache file.
+ */
+class Icon::Test::CacheTest : public juce::UnitTest
+{
+public:
+    CacheTest() : juce::UnitTest("Icon::Cache Testing", "Icon") {}
+
+    void runTest() override
+    {
+        using juce::String;
+        using juce::File;
+        const File themeDir = File::getSpecialLocation(File::tempDirectory)
+                .getChildFile(testThemeName);
+        themeDir.deleteRecursively();
+        expect(themeDir.createDirectory().wasOk(),
+                "Failed to create test theme directory.");
+        writeCacheFile(themeDir);
+
+        beginTest("Cache file loading");
+        const Cache iconCache(themeDir.getFullPathName());
+        expect(iconCache.isValidCache(), "Test cache file was not valid.");
+        expect(iconCache.getDirectories() == testDirectories,
+                "Cache directories did not match test directories.");
+
+        beginTest("Single icon lookup");
+        for (const TestIcon& icon : testIcons)
+        {
+            const Cache::Matches matches = iconCache.lookupIcon(icon.name);
+            expectMatches(matches, icon, String("lookupIcon(") + icon.name
+                    + ")");
+        }
+        expectEquals(iconCache.lookupIcon("missing").count, 0,
+                "Found missing icon.");
+        expectEquals(iconCache.lookupIcon("fire").count, 0,
+                "Found icon using a partial name.");
+        expectEquals(iconCache.lookupIcon("firefox-esr").count, 0,
+                "Found icon using an extended name.");
+
+        beginTest("Batched icon lookup");
+        juce::StringArray iconNames;
+        for (auto iter = testIcons.rbegin(); iter != testIcons.rend(); iter++)
+        {
+            iconNames.add(iter->name);
+        }
+        iconNames.add("missing");
+        iconNames.add("");
+        iconNames.add("firefox");
+        juce::Array<Cache::Matches> results;
+        iconCache.lookupIcons(iconNames, results);
+        expectEquals(results.size(), iconNames.size(),
+                "Batched lookup returned the wrong number of results.");
+        for (int i = 0; i < iconNames.size() && i < results.size(); i++)
+        {
+            const Cache::Matches expected
+                    = iconCache.lookupIcon(iconNames[i].toRawUTF8());
+            const Cache::Matches& result = results.getReference(i);
+            expectEquals(result.count, expected.count,
+                    String("Wrong match count for ") + iconNames[i]);
+            for (int m = 0; m < result.count && m < expected.count; m++)
+            {
+                expect(result.directories[m] == expected.directories[m]
+                        && result.flags[m] == expected.flags[m],
+                        String("Batched lookup mismatch for ")
+                        + iconNames[i]);
+            }
+        }
+
+        beginTest("Extension selection");
+        expect(String(Cache::getExtension(pngFlag | svgFlag)) == ".png",
+                "PNG icons should be preferred.");
+        expect(String(Cache::getExtension(svgFlag)) == ".svg",
+                "SVG extension not found.");
+        expect(Cache::getExtension(0) == nullptr,
+                "Found an extension without extension flags.");
+
+        themeDir.deleteRecursively();
+    }
+
+private:
+    /**
+     * @brief  Checks that a lookup result holds all valid images listed for a
+     *         test icon.
+     *
+     * @param matches  The lookup result to check.
+     *
+     * @param icon     The icon that was looked up.
+     *
+     * @param lookup   A description of the lookup, used in failure messages.
+     */
+    void expectMatches(const Cache::Matches& matches, const TestIcon& icon,
+            const juce::String& lookup)
+    {
+        int expectedIndex = 0;
+        for (const auto& image : icon.images)
+        {
+            if (Cache::getExtension(image.second) == nullptr)
+            {
+                continue;
+            }
+            expect(expectedIndex < matches.count
+                    && matches.directories[expectedIndex] == image.first
+                    && matches.flags[expectedIndex] == image.second,
+                    lookup + " returned incorrect matches.");
+            expectedIndex++;
+        }
+        expectEquals(matches.count, expectedIndex,
+                lookup + " returned the wrong number of matches.");
+    }
+
+    /**
+     * @brief  Calculates an icon name's hash bucket, using the same hash
+     *         function as GTK icon cache files.
+     *
+     * @param iconName  The icon name to hash.
+     *
+     * @return          The index of the icon name's hash bucket.
+     */
+    static juce::uint32 getBucket(const char* iconName)
+    {
+        juce::uint32 val = (int) * iconName;
+        for (const char* ch = iconName + 1; *ch != '\0'; ch++)
+        {
+            val = (val << 5) - val + *ch;
+        }
+        return val % testBucketCount;
+    }
+
+    /**
+     * @brief  Writes a GTK icon cache file listing all test icons.
+     *
+     * @param themeDir  The test icon theme directory.
+     */
+    void writeCacheFile(const juce::File& themeDir)
+    {
+        using juce::uint32;
+        std::vector<juce::uint8> data;
+        const auto add16 = [&data](const juce::uint16 value)
+        {
+            data.push_back((juce::uint8) (value >> 8));
+            data.push_back((juce::uint8) value);
+        };
+        const auto add32 = [&data](const uint32 value)
+        {
+            for (int shift = 24; shift >= 0; shift -= 8)
+            {
+                data.push_back((juce::uint8) (value >> shift));
+            }
+        };
+        const auto set32 = [&data](const uint32 offset, const uint32 value)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                data[offset + i] = (juce::uint8) (value >> (24 - i * 8));
+            }
+        };
+        const auto addString = [&data](const char* text)
+        {
+            const uint32 offset = (uint32) data.size();
+            do
+            {
+                data.push_back((juce::uint8) *text);
+            }
+            while (*text++ != '\0');
+            return offset;
+        };
+
+        // Header: version numbers, hash offset, and directory list offset.
+        add16(1);
+        add16(0);
+        add32(12);
+        add32(0);
+
+        // Hash bucket offsets, filled in as icon entries are added:
+        add32(testBucketCount);
+        const uint32 bucketListOffset = (uint32) data.size();
+        for (uint32 i = 0; i < testBucketCount; i++)
+        {
+            add32(0);
+        }
+
+        // Icon entries, each added to the start of its bucket's chain:
+        for (const TestIcon& icon : testIcons)
+        {
+            const uint32 bucketOffset = bucketListOffset
+                    + getBucket(icon.name) * 4;
+            const uint32 entryOffset = (uint32) data.size();
+            add32((uint32) data[bucketOffset] << 24
+                    | (uint32) data[bucketOffset + 1] << 16
+                    | (uint32) data[bucketOffset + 2] << 8
+                    | (uint32) data[bucketOffset + 3]);
+            add32(0);
+            add32(0);
+            set32(bucketOffset, entryOffset);
+            set32(entryOffset + 4, addString(icon.name));
+            set32(entryOffset + 8, (uint32) data.size());
+            add32((uint32) icon.images.size());
+            for (const auto& image : icon.images)
+            {
+                add16(image.first);
+                add16(image.second);
+                add32(0);
+            }
+        }
+
+        // Directory list:
+        set32(8, (uint32) data.size());
+        add32((uint32) testDirectories.size());
+        const uint32 dirOffsetList = (uint32) data.size();
+        for (int i = 0; i < testDirectories.size(); i++)
+        {
+            add32(0);
+        }
+        for (int i = 0; i < testDirectories.size(); i++)
+        {
+            set32(dirOffsetList + i * 4,
+                    addString(testDirectories[i].toRawUTF8()));
+        }
+
+        const juce::File cacheFile = themeDir.getChildFile("icon-theme.cache");
+        expect(cacheFile.replaceWithData(data.data(), data.size()),
+                "Failed to write test cache file.");
+        // Cache files older than their directory are ignored:
+        cacheFile.setLastModificationTime(
+                themeDir.getLastModificationTime()
+                + juce::RelativeTime::seconds(1));
+    }
+};
+
+static Icon::Test::CacheTest test;
@@ -0,0 +1,194 @@
+#include "SharedResource_Thread_Pool.h"
+#include "SharedResource_Thread_JobPool.h"
+#include "JuceHeader.h"
+#include <atomic>
+#include <memory>
+
+// Number of tasks added when testing task execution:
+static const constexpr int taskCount = 500;
+
+// Number of jobs added when testing JobPool objects:
+static const constexpr int jobCount = 32;
+
+// Maximum number of threads used by the test JobPool:
+static const constexpr int maxJobThreads = 4;
+
+// Milliseconds to wait for tasks or jobs before failing a test:
+static const constexpr int testTimeoutMilliseconds = 5000;
+
+/**
+ * @brief  A job that either finishes immediately, or keeps running until it
+ *         is told to exit.
+ */
+class PoolTestJob : public juce::ThreadPoolJob
+{
+public:
+    PoolTestJob(const bool runUntilCancelled) :
+    juce::ThreadPoolJob("PoolTestJob"),
+    runUntilCancelled(runUntilCancelled) { }
+
+    virtual ~PoolTestJob() { }
+
+    virtual JobStatus runJob() override
+    {
+        runCount++;
+        if (runUntilCancelled && !shouldExit())
+        {
+            juce::Thread::sleep(1);
+            return jobNeedsRunningAgain;
+        }
+        return jobHasFinished;
+    }
+
+    // Number of times the job has run:
+    std::atomic<int> runCount { 0 };
+
+private:
+    const bool runUntilCancelled;
+};
+
+/**
+ * @brief  Tests that the shared SharedResource::Thread::Pool runs all tasks,
+ *         including tasks that wait for other tasks, and that JobPool objects
+ *         run, wait for, and cancel jobs.
+ */
+class PoolTest : public juce::UnitTest
+{
+public:
+    PoolTest() : juce::UnitTest("SharedResource::Thread::Pool Testing",
+            "SharedResource") {}
+
+    void runTest() override
+    {
+        using SharedResource::Thread::Pool;
+        beginTest("Shared pool access");
+        std::shared_ptr<Pool> pool = Pool::getSharedPool();
+        expect(pool != nullptr, "Failed to create the shared pool.");
+        expect(Pool::getSharedPool() == pool,
+                "Shared pool was replaced while still in use.");
+        expect(pool->getNumWorkers() > 0, "Shared pool has no workers.");
+        expect(!pool->runPendingTask(),
+                "Ran a pool task outside of the pool.");
+        // Tasks use a plain pointer to the pool, as the pool must never be
+        // destroyed by one of its own workers:
+        Pool* const poolPtr = pool.get();
+
+        beginTest("Running tasks");
+        std::atomic<int> finishedTasks(0);
+        for (int i = 0; i < taskCount; i++)
+        {
+            pool->addTask([&finishedTasks]() { finishedTasks++; });
+        }
+        expect(waitUntil([&finishedTasks]()
+                {
+                    return finishedTasks == taskCount;
+                }), "Not all tasks ran.");
+
+        beginTest("Adding tasks from pool tasks");
+        finishedTasks = 0;
+        for (int i = 0; i < taskCount / 2; i++)
+        {
+            pool->addTask([poolPtr, &finishedTasks]()
+            {
+                poolPtr->addTask([&finishedTasks]() { finishedTasks++; });
+                finishedTasks++;
+            });
+        }
+        expect(waitUntil([&finishedTasks]()
+                {
+                    return finishedTasks == taskCount;
+                }), "Not all tasks added within the pool ran.");
+
+        beginTest("Waiting for tasks within the pool");
+        // Occupy every worker with a task that waits for its own subtask, so
+        // subtasks only run if waiting tasks run them:
+        std::atomic<int> finishedWaits(0);
+        std::atomic<bool> stopWaiting(false);
+        const int waitingTaskCount = pool->getNumWorkers();
+        for (int i = 0; i < waitingTaskCount; i++)
+        {
+            pool->addTask([poolPtr, &finishedWaits, &stopWaiting]()
+            {
+                std::shared_ptr<std::atomic<bool>> subtaskDone
+                        = std::make_shared<std::atomic<bool>>(false);
+                poolPtr->addTask([subtaskDone]() { *subtaskDone = true; });
+                while (!*subtaskDone && !stopWaiting)
+                {
+                    if (!poolPtr->runPendingTask())
+                    {
+                        juce::Thread::yield();
+                    }
+                }
+                finishedWaits++;
+            });
+        }
+        expect(waitUntil([&finishedWaits, waitingTaskCount]()
+                {
+                    return finishedWaits == waitingTaskCount;
+                }), "Waiting pool tasks blocked their own subtasks.");
+        stopWaiting = true;
+        waitUntil([&finishedWaits, waitingTaskCount]()
+                {
+                    return finishedWaits == waitingTaskCount;
+                });
+
+        beginTest("Running JobPool jobs");
+        SharedResource::Thread::JobPool jobPool(maxJobThreads);
+        expect(jobPool.getNumThreads() > 0
+                && jobPool.getNumThreads() <= maxJobThreads,
+                "JobPool has an invalid thread count.");
+        juce::OwnedArray<PoolTestJob> jobs;
+        for (int i = 0; i < jobCount; i++)
+        {
+            jobPool.addJob(jobs.add(new PoolTestJob(false)));
+        }
+        for (PoolTestJob* job : jobs)
+        {
+            expect(jobPool.waitForJobToFinish(job, testTimeoutMilliseconds),
+                    "Timed out waiting for a job.");
+            expectEquals(job->runCount.load(), 1,
+                    "Job did not run exactly once.");
+        }
+
+        beginTest("Cancelling JobPool jobs");
+        jobs.clear();
+        for (int i = 0; i < jobCount; i++)
+        {
+            jobPool.addJob(jobs.add(new PoolTestJob(true)));
+        }
+        expect(!jobPool.waitForJobToFinish(jobs.getFirst(), 10),
+                "Unfinished job was reported as finished.");
+        jobPool.removeAllJobs();
+        for (PoolTestJob* job : jobs)
+        {
+            expect(jobPool.waitForJobToFinish(job, 0),
+                    "Job still running after all jobs were removed.");
+        }
+    }
+
+private:
+    /**
+     * @brief  Waits until a condition is met, or until the test timeout
+     *         passes.
+     *
+     * @param condition  Checks whether waiting should stop.
+     *
+     * @return           Whether the condition was met before the timeout.
+     */
+    bool waitUntil(const std::function<bool()> condition)
+    {
+        const juce::uint32 endTime = juce::Time::getMillisecondCounter()
+                + testTimeoutMilliseconds;
+        while (!condition())
+        {
+            if (juce::Time::getMillisecondCounter() > endTime)
+            {
+                return false;
+            }
+            juce::Thread::sleep(1);
+        }
+        return true;
+    }
+};
+
+static PoolTest test;
@@ -0,0 +1,155 @@
+#include "SharedResource_Snapshot.h"
+#include "JuceHeader.h"
+#include <atomic>
+
+// Number of threads reading data at the same time:
+static const constexpr int readerCount = 4;
+
+// Number of times each reader thread reads data:
+static const constexpr int readsPerThread = 200000;
+
+// Number of times data is changed while reader threads are running:
+static const constexpr int writeCount = 200;
+
+/**
+ * @brief  Test data holding two values that writers always keep equal, so
+ *         that readers can detect partially changed data.
+ */
+struct SnapshotTestData
+{
+    int first = 0;
+    int second = 0;
+};
+
+/**
+ * @brief  Repeatedly reads test data, using either a Snapshot or a
+ *         ReadWriteLock to access the data.
+ */
+class SnapshotTestReader : public juce::Thread
+{
+public:
+    SnapshotTestReader(const std::function<SnapshotTestData()> readData) :
+    juce::Thread("SnapshotTestReader"), readData(readData) { }
+
+    virtual ~SnapshotTestReader()
+    {
+        stopThread(-1);
+    }
+
+    // Whether all data read by the thread was valid:
+    std::atomic<bool> allReadsValid { true };
+
+private:
+    virtual void run() override
+    {
+        int lastValue = 0;
+        for (int i = 0; i < readsPerThread; i++)
+        {
+            const SnapshotTestData data = readData();
+            if (data.first != data.second || data.first < lastValue)
+            {
+                allReadsValid = false;
+            }
+            lastValue = data.first;
+        }
+    }
+
+    const std::function<SnapshotTestData()> readData;
+};
+
+/**
+ * @brief  Tests that SharedResource::Snapshot data can be safely read while it
+ *         is changed, and compares Snapshot reads to ReadWriteLock reads.
+ */
+class SnapshotTest : public juce::UnitTest
+{
+public:
+    SnapshotTest() : juce::UnitTest("SharedResource::Snapshot Testing",
+            "SharedResource") {}
+
+    void runTest() override
+    {
+        beginTest("Publishing data");
+        SharedResource::Snapshot<SnapshotTestData> snapshot;
+        SharedResource::Snapshot<SnapshotTestData>::Ptr initialData
+                = snapshot.read();
+        expectEquals(initialData->first, 0,
+                "Snapshot did not start with default data.");
+        snapshot.edit([](SnapshotTestData& data)
+        {
+            data.first = 1;
+            data.second = 1;
+        });
+        expectEquals(snapshot.read()->first, 1,
+                "Snapshot did not publish edited data.");
+        expectEquals(initialData->first, 0,
+                "Snapshot changed previously published data.");
+
+        beginTest("Concurrent snapshot reads");
+        const double snapshotTime = timeReads(
+                [&snapshot]() { return *snapshot.read(); },
+                [&snapshot](const int value)
+                {
+                    snapshot.edit([value](SnapshotTestData& data)
+                    {
+                        data.first = value;
+                        data.second = value;
+                    });
+                });
+
+        beginTest("Concurrent locked reads");
+        juce::ReadWriteLock dataLock;
+        SnapshotTestData lockedData;
+        const double lockTime = timeReads(
+                [&dataLock, &lockedData]()
+                {
+                    const juce::ScopedReadLock readLock(dataLock);
+                    return lockedData;
+                },
+                [&dataLock, &lockedData](const int value)
+                {
+                    const juce::ScopedWriteLock writeLock(dataLock);
+                    lockedData.first = value;
+                    lockedData.second = value;
+                });
+        logMessage(juce::String("Snapshot reads: ") + juce::String(snapshotTime)
+                + "ms, ReadWriteLock reads: " + juce::String(lockTime) + "ms");
+    }
+
+private:
+    /**
+     * @brief  Runs several reader threads while changing test data, checking
+     *         that all reads are valid.
+     *
+     * @param readData   Reads a copy of the test data.
+     *
+     * @param writeData  Sets both test data values.
+     *
+     * @return           The number of milliseconds needed for all reader
+     *                   threads to finish.
+     */
+    double timeReads(const std::function<SnapshotTestData()> readData,
+            const std::function<void(const int)> writeData)
+    {
+        writeData(0);
+        juce::OwnedArray<SnapshotTestReader> readers;
+        const double startTime = juce::Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < readerCount; i++)
+        {
+            readers.add(new SnapshotTestReader(readData))->startThread();
+        }
+        for (int i = 1; i <= writeCount; i++)
+        {
+            writeData(i);
+        }
+        for (SnapshotTestReader* reader : readers)
+        {
+            reader->waitForThreadToExit(-1);
+            expect(reader->allReadsValid.load(),
+                    "Reader thread read invalid or outdated data.");
+        }
+        return juce::Time::getMillisecondCounterHiRes() - startTime;
+    }
+};
+
+static SnapshotTest test;
@@ -0,0 +1,142 @@
+#include "SharedResource_Resource.h"
+#include "SharedResource_Handler.h"
+#include "Testing_DelayUtils.h"
+#include "JuceHeader.h"
+
+// Milliseconds to wait between checks for sent updates:
+static const constexpr int testFrequency = 50;
+
+// Milliseconds to wait before assuming updates will never be sent:
+static const constexpr int timeout = 2000;
+
+class UpdateBatchHandler;
+
+/**
+ * @brief  A resource that queues test value updates for its handlers.
+ */
+class UpdateBatchResource : public SharedResource::Resource
+{
+public:
+    static const juce::Identifier resourceKey;
+
+    UpdateBatchResource() : SharedResource::Resource(resourceKey) { }
+
+    virtual ~UpdateBatchResource() { }
+
+    /**
+     * @brief  Queues a value update for all handlers.
+     *
+     * @param updateKey  The update key used to replace older updates.
+     *
+     * @param value      The value to send to all handlers.
+     */
+    void queueValue(const juce::String updateKey, const int value);
+};
+
+const juce::Identifier UpdateBatchResource::resourceKey
+        = "SharedResource::Test::UpdateBatchResource";
+
+/**
+ * @brief  A handler that records all updates and update batches it receives.
+ */
+class UpdateBatchHandler :
+    public SharedResource::Handler<UpdateBatchResource>
+{
+public:
+    /**
+     * @brief  Creates a handler, optionally receiving all replaced updates.
+     *
+     * @param receiveAll  Whether the handler needs every update.
+     */
+    UpdateBatchHandler(const bool receiveAll = false) :
+        receiveAll(receiveAll) { }
+
+    virtual ~UpdateBatchHandler() { }
+
+    /**
+     * @brief  Queues a value update through the handler's resource.
+     *
+     * @param updateKey  The update key used to replace older updates.
+     *
+     * @param value      The value to send to all handlers.
+     */
+    void queueValue(const juce::String updateKey, const int value)
+    {
+        getWriteLockedResource()->queueValue(updateKey, value);
+    }
+
+    // All values received, in order:
+    juce::Array<int> values;
+
+    // Number of update batches received:
+    int batchCount = 0;
+
+private:
+    virtual bool needsEveryUpdate() const override
+    {
+        return receiveAll;
+    }
+
+    virtual void updateBatchFinished() override
+    {
+        batchCount++;
+    }
+
+    const bool receiveAll;
+};
+
+
+// Queues a value update for all handlers.
+void UpdateBatchResource::queueValue
+(const juce::String updateKey, const int value)
+{
+    queueHandlerUpdate<UpdateBatchHandler>(updateKey, [value]
+            (UpdateBatchHandler* handler)
+    {
+        handler->values.add(value);
+    });
+}
+
+/**
+ * @brief  Tests that queued SharedResource handler updates are combined and
+ *         sent together.
+ */
+class UpdateBatchTest : public juce::UnitTest
+{
+public:
+    UpdateBatchTest() : juce::UnitTest("SharedResource::Resource Update Batch"
+            " Testing", "SharedResource") {}
+
+    void runTest() override
+    {
+        beginTest("Batched update delivery");
+        UpdateBatchHandler batchedHandler;
+        UpdateBatchHandler everyUpdateHandler(true);
+        batchedHandler.queueValue("a", 1);
+        batchedHandler.queueValue("b", 2);
+        batchedHandler.queueValue("a", 3);
+        batchedHandler.queueValue(juce::String(), 4);
+        batchedHandler.queueValue(juce::String(), 5);
+        expect(batchedHandler.values.isEmpty(),
+                "Updates were sent before the message loop ran.");
+        expect(Testing::DelayUtils::idleUntil([&batchedHandler]()
+                {
+                    return batchedHandler.batchCount > 0;
+                }, testFrequency, timeout), "Queued updates were never sent.");
+
+        const juce::Array<int> expectedBatched = { 2, 3, 4, 5 };
+        expect(batchedHandler.values == expectedBatched,
+                "Replaced update was sent, or updates were out of order.");
+        expectEquals(batchedHandler.batchCount, 1,
+                "Updates were not sent in a single batch.");
+
+        beginTest("Handlers needing every update");
+        const juce::Array<int> expectedAll = { 1, 2, 3, 4, 5 };
+        expect(everyUpdateHandler.values == expectedAll,
+                "Handler needing every update missed replaced updates.");
+        expectEquals(everyUpdateHandler.batchCount, 1,
+                "Updates were not sent in a single batch.");
+    }
+};
+
+static UpdateBatchTest test;
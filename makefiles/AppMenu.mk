@@ -15,6 +15,7 @@ OBJECTS_APPMENU_DATA := \
   $(APPMENU_OBJ)MenuFile.o \
   $(APPMENU_OBJ)MenuItem.o \
   $(APPMENU_OBJ)EntryData.o \
+  $(APPMENU_OBJ)CategoryIndex.o \
   $(APPMENU_OBJ)EntryActions.o \
   $(APPMENU_OBJ)EntryLoader.o \
   $(APPMENU_OBJ)EntryUpdater.o \
@@ -144,6 +145,8 @@ $(APPMENU_OBJ)ConfigData.o: \
 
 $(APPMENU_OBJ)EntryData.o: \
     $(APPMENU_DATA_DIR)/DesktopEntry/$(APPMENU_PREFIX)EntryData.cpp
+$(APPMENU_OBJ)CategoryIndex.o: \
+    $(APPMENU_DATA_DIR)/DesktopEntry/$(APPMENU_PREFIX)CategoryIndex.cpp
 $(APPMENU_OBJ)EntryActions.o: \
     $(APPMENU_DATA_DIR)/DesktopEntry/$(APPMENU_PREFIX)EntryActions.cpp
 $(APPMENU_OBJ)EntryLoader.o: \
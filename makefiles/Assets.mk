@@ -8,6 +8,8 @@ ASSETS_OBJ := $(JUCE_OBJDIR)/$(ASSETS_PREFIX)
 OBJECTS_ASSETS := \
   $(ASSETS_OBJ)Assets.o \
   $(ASSETS_OBJ)JSONFile.o \
+  $(ASSETS_OBJ)JSONWriter.o \
+  $(ASSETS_OBJ)JSONWriteThread.o \
   $(ASSETS_OBJ)XDGDirectories.o \
   $(ASSETS_OBJ)XPMLoader.o
 
@@ -30,6 +32,10 @@ $(ASSETS_OBJ)Assets.o : \
     $(ASSETS_DIR)/Assets.cpp
 $(ASSETS_OBJ)JSONFile.o : \
     $(ASSETS_DIR)/$(ASSETS_PREFIX)JSONFile.cpp
+$(ASSETS_OBJ)JSONWriter.o : \
+    $(ASSETS_DIR)/$(ASSETS_PREFIX)JSONWriter.cpp
+$(ASSETS_OBJ)JSONWriteThread.o : \
+    $(ASSETS_DIR)/$(ASSETS_PREFIX)JSONWriteThread.cpp
 $(ASSETS_OBJ)XDGDirectories.o : \
     $(ASSETS_DIR)/$(ASSETS_PREFIX)XDGDirectories.cpp
 $(ASSETS_OBJ)XPMLoader.o : \
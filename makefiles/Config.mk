@@ -8,7 +8,9 @@ CONFIG_OBJ := $(JUCE_OBJDIR)/$(CONFIG_PREFIX)
 
 OBJECTS_CONFIG_IMPL := \
   $(CONFIG_OBJ)AlertWindow.o \
-  $(CONFIG_OBJ)MainResource.o
+  $(CONFIG_OBJ)MainResource.o \
+  $(CONFIG_OBJ)KeyTable.o \
+  $(CONFIG_OBJ)ValueTable.o
 
 OBJECTS_CONFIG := \
   $(OBJECTS_CONFIG_IMPL) \
@@ -42,6 +44,10 @@ $(CONFIG_OBJ)AlertWindow.o: \
     $(CONFIG_IMPL_DIR)/$(CONFIG_PREFIX)AlertWindow.cpp
 $(CONFIG_OBJ)MainResource.o: \
     $(CONFIG_IMPL_DIR)/$(CONFIG_PREFIX)MainResource.cpp
+$(CONFIG_OBJ)KeyTable.o: \
+    $(CONFIG_IMPL_DIR)/$(CONFIG_PREFIX)KeyTable.cpp
+$(CONFIG_OBJ)ValueTable.o: \
+    $(CONFIG_IMPL_DIR)/$(CONFIG_PREFIX)ValueTable.cpp
 $(CONFIG_OBJ)FileResource.o: \
     $(CONFIG_DIR)/$(CONFIG_PREFIX)FileResource.cpp
 $(CONFIG_OBJ)DataKey.o: \
@@ -7,12 +7,21 @@ DESKTOP_ENTRY_OBJ := $(JUCE_OBJDIR)/$(DESKTOP_ENTRY_PREFIX)
 
 OBJECTS_DESKTOP_ENTRY := \
   $(DESKTOP_ENTRY_OBJ)FileUtils.o \
+  $(DESKTOP_ENTRY_OBJ)LineParser.o \
   $(DESKTOP_ENTRY_OBJ)EntryFile.o \
+  $(DESKTOP_ENTRY_OBJ)EntryCache.o \
+  $(DESKTOP_ENTRY_OBJ)EntryWatcher.o \
+  $(DESKTOP_ENTRY_OBJ)EntryWriter.o \
+  $(DESKTOP_ENTRY_OBJ)SearchIndex.o \
   $(DESKTOP_ENTRY_OBJ)LoadingThread.o \
   $(DESKTOP_ENTRY_OBJ)UpdateListener.o \
   $(DESKTOP_ENTRY_OBJ)Loader.o
 
-OBJECTS_DESKTOP_ENTRY_TEST :=
+DESKTOP_ENTRY_TEST_PREFIX := $(DESKTOP_ENTRY_PREFIX)Test_
+DESKTOP_ENTRY_TEST_OBJ := $(DESKTOP_ENTRY_OBJ)Test_
+OBJECTS_DESKTOP_ENTRY_TEST := \
+  $(DESKTOP_ENTRY_TEST_OBJ)ParserTest.o \
+  $(DESKTOP_ENTRY_TEST_OBJ)SearchIndexTest.o
 
 ifeq ($(BUILD_TESTS), 1)
     OBJECTS_DESKTOP_ENTRY := $(OBJECTS_DESKTOP_ENTRY) \
@@ -28,11 +37,27 @@ desktopEntry : $(OBJECTS_DESKTOP_ENTRY)
 
 $(DESKTOP_ENTRY_OBJ)FileUtils.o: \
     $(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)FileUtils.cpp
+$(DESKTOP_ENTRY_OBJ)LineParser.o: \
+	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)LineParser.cpp
 $(DESKTOP_ENTRY_OBJ)EntryFile.o: \
 	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)EntryFile.cpp
+$(DESKTOP_ENTRY_OBJ)EntryCache.o: \
+	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)EntryCache.cpp
+$(DESKTOP_ENTRY_OBJ)EntryWatcher.o: \
+	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)EntryWatcher.cpp
+$(DESKTOP_ENTRY_OBJ)EntryWriter.o: \
+	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)EntryWriter.cpp
+$(DESKTOP_ENTRY_OBJ)SearchIndex.o: \
+	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)SearchIndex.cpp
 $(DESKTOP_ENTRY_OBJ)LoadingThread.o: \
 	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)LoadingThread.cpp
 $(DESKTOP_ENTRY_OBJ)UpdateListener.o : \
 	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)UpdateListener.cpp
 $(DESKTOP_ENTRY_OBJ)Loader.o: \
 	$(DESKTOP_ENTRY_DIR)/$(DESKTOP_ENTRY_PREFIX)Loader.cpp
+
+# Tests:
+$(DESKTOP_ENTRY_TEST_OBJ)ParserTest.o: \
+	$(DESKTOP_ENTRY_TEST_DIR)/$(DESKTOP_ENTRY_TEST_PREFIX)ParserTest.cpp
+$(DESKTOP_ENTRY_TEST_OBJ)SearchIndexTest.o: \
+	$(DESKTOP_ENTRY_TEST_DIR)/$(DESKTOP_ENTRY_TEST_PREFIX)SearchIndexTest.cpp
@@ -12,12 +12,15 @@ OBJECTS_SHARED_IMPL := \
   $(SHARED_OBJ)ReferenceInterface.o \
   $(SHARED_OBJ)Instance.o \
   $(SHARED_OBJ)Reference.o \
-  $(SHARED_OBJ)LockedInstancePtr.o
+  $(SHARED_OBJ)LockedInstancePtr.o \
+  $(SHARED_OBJ)LockRecord.o
 
 SHARED_THREAD_PREFIX := $(SHARED_PREFIX)Thread_
 SHARED_THREAD_OBJ := $(SHARED_OBJ)Thread_
 OBJECTS_SHARED_THREAD := \
+  $(SHARED_THREAD_OBJ)JobPool.o \
   $(SHARED_THREAD_OBJ)Lock.o \
+  $(SHARED_THREAD_OBJ)Pool.o \
   $(SHARED_THREAD_OBJ)ScopedReadLock.o \
   $(SHARED_THREAD_OBJ)ScopedWriteLock.o \
   $(SHARED_THREAD_OBJ)Thread.o \
@@ -26,13 +29,17 @@ OBJECTS_SHARED_THREAD := \
 OBJECTS_SHARED_RESOURCE := \
   $(OBJECTS_SHARED_IMPL) \
   $(OBJECTS_SHARED_THREAD) \
+  $(SHARED_OBJ)LockStats.o \
   $(SHARED_OBJ)Resource.o
 
 SHARED_TEST_PREFIX := $(SHARED_PREFIX)Test_
 SHARED_TEST_OBJ := $(SHARED_OBJ)Test_
 OBJECTS_SHARED_TEST := \
   $(SHARED_TEST_OBJ)ModuleTest.o \
-  $(SHARED_TEST_OBJ)ModuleTestClasses.o
+  $(SHARED_TEST_OBJ)ModuleTestClasses.o \
+  $(SHARED_TEST_OBJ)PoolTest.o \
+  $(SHARED_TEST_OBJ)SnapshotTest.o \
+  $(SHARED_TEST_OBJ)UpdateBatchTest.o
 
 ifeq ($(BUILD_TESTS), 1)
     OBJECTS_SHARED_RESOURCE := $(OBJECTS_SHARED_RESOURCE) \
@@ -56,11 +63,19 @@ $(SHARED_OBJ)Reference.o : \
     $(SHARED_IMPL_DIR)/$(SHARED_PREFIX)Reference.cpp
 $(SHARED_OBJ)LockedInstancePtr.o : \
     $(SHARED_IMPL_DIR)/$(SHARED_PREFIX)LockedInstancePtr.cpp
+$(SHARED_OBJ)LockRecord.o : \
+    $(SHARED_IMPL_DIR)/$(SHARED_PREFIX)LockRecord.cpp
+$(SHARED_OBJ)LockStats.o : \
+    $(SHARED_DIR)/$(SHARED_PREFIX)LockStats.cpp
 $(SHARED_OBJ)Resource.o : \
     $(SHARED_DIR)/$(SHARED_PREFIX)Resource.cpp
 
+$(SHARED_THREAD_OBJ)JobPool.o : \
+    $(SHARED_THREAD_DIR)/$(SHARED_THREAD_PREFIX)JobPool.cpp
 $(SHARED_THREAD_OBJ)Lock.o : \
     $(SHARED_THREAD_DIR)/$(SHARED_THREAD_PREFIX)Lock.cpp
+$(SHARED_THREAD_OBJ)Pool.o : \
+    $(SHARED_THREAD_DIR)/$(SHARED_THREAD_PREFIX)Pool.cpp
 $(SHARED_THREAD_OBJ)ScopedReadLock.o : \
     $(SHARED_THREAD_DIR)/$(SHARED_THREAD_PREFIX)ScopedReadLock.cpp
 $(SHARED_THREAD_OBJ)ScopedWriteLock.o : \
@@ -74,3 +89,9 @@ $(SHARED_TEST_OBJ)ModuleTest.o : \
     $(SHARED_TEST_DIR)/$(SHARED_TEST_PREFIX)ModuleTest.cpp
 $(SHARED_TEST_OBJ)ModuleTestClasses.o : \
     $(SHARED_TEST_DIR)/$(SHARED_TEST_PREFIX)ModuleTestClasses.cpp
+$(SHARED_TEST_OBJ)PoolTest.o : \
+    $(SHARED_TEST_DIR)/$(SHARED_TEST_PREFIX)PoolTest.cpp
+$(SHARED_TEST_OBJ)SnapshotTest.o : \
+    $(SHARED_TEST_DIR)/$(SHARED_TEST_PREFIX)SnapshotTest.cpp
+$(SHARED_TEST_OBJ)UpdateBatchTest.o : \
+    $(SHARED_TEST_DIR)/$(SHARED_TEST_PREFIX)UpdateBatchTest.cpp
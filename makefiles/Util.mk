@@ -7,6 +7,7 @@ UTIL_OBJ := $(JUCE_OBJDIR)/$(UTIL_PREFIX)
 
 OBJECTS_UTIL := \
   $(UTIL_OBJ)Commands.o \
+  $(UTIL_OBJ)FileWatcher.o \
   $(UTIL_OBJ)TempTimer.o \
   $(UTIL_OBJ)ShutdownListener.o \
   $(UTIL_OBJ)ConditionChecker.o
@@ -30,6 +31,8 @@ util : $(OBJECTS_UTIL)
 
 $(UTIL_OBJ)Commands.o : \
     $(UTIL_DIR)/$(UTIL_PREFIX)Commands.cpp
+$(UTIL_OBJ)FileWatcher.o : \
+    $(UTIL_DIR)/$(UTIL_PREFIX)FileWatcher.cpp
 $(UTIL_OBJ)TempTimer.o : \
     $(UTIL_DIR)/$(UTIL_PREFIX)TempTimer.cpp
 $(UTIL_OBJ)ShutdownListener.o : \